@@ -0,0 +1,42 @@
+/*
+ * Example governor plugin in the spirit of Linux "ondemand": the frequency
+ * follows the queue length, jumps to the top level under load and backs off
+ * when the thermal headroom shrinks. The wrapped scheduler's request is a
+ * floor except under thermal pressure.
+ */
+#include "PluginABI.h"
+#include <stddef.h>
+
+static const double kLevels[] = {0.5, 0.8, 1.0, 1.2, 1.5, 2.0};
+static const int kLevelCount = sizeof(kLevels) / sizeof(kLevels[0]);
+
+static double ondemand_select_frequency(void* state, const pp_context* ctx, const pp_task* task, int32_t queued,
+                                        double requested) {
+    int level;
+    double frequency;
+    (void)state;
+    if (task == NULL) {
+        return kLevels[0];
+    }
+    level = queued >= kLevelCount - 1 ? kLevelCount - 1 : queued;
+    if (ctx->power_policy == PP_POLICY_RACE_TO_IDLE) {
+        level = kLevelCount - 1;
+    }
+    frequency = kLevels[level] > requested ? kLevels[level] : requested;
+    if (ctx->thermal_headroom < 5.0 && frequency > kLevels[2]) {
+        frequency = kLevels[2];
+    }
+    return frequency;
+}
+
+static const pp_governor_plugin kPlugin = {
+    PP_PLUGIN_ABI_VERSION,
+    "ondemand",
+    NULL,
+    NULL,
+    ondemand_select_frequency
+};
+
+const pp_governor_plugin* pp_governor_plugin_v1(void) {
+    return &kPlugin;
+}
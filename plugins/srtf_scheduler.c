@@ -0,0 +1,60 @@
+/*
+ * Example scheduler plugin: preemptive shortest-remaining-time-first.
+ *
+ * The shortest task keeps the CPU until it finishes, so the decision is held
+ * for its remaining work; arrivals and wake-ups re-open the decision anyway.
+ * Options: "race" runs every task at 2 GHz instead of 1 GHz.
+ */
+#include "PluginABI.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct srtf_state {
+    double frequency;
+} srtf_state;
+
+static void* srtf_create(const char* options) {
+    srtf_state* state = (srtf_state*)malloc(sizeof(srtf_state));
+    if (state != NULL) {
+        state->frequency = strcmp(options, "race") == 0 ? 2.0 : 1.0;
+    }
+    return state;
+}
+
+static void srtf_destroy(void* state) {
+    free(state);
+}
+
+static int32_t srtf_pick_next(void* state, const pp_context* ctx, const pp_task* tasks, int32_t count,
+                              int32_t* hold) {
+    int32_t best = 0;
+    int32_t i;
+    (void)state;
+    (void)ctx;
+    for (i = 1; i < count; ++i) {
+        if (tasks[i].remaining < tasks[best].remaining) {
+            best = i;
+        }
+    }
+    *hold = tasks[best].remaining > 0 ? tasks[best].remaining : 1;
+    return best;
+}
+
+static double srtf_select_frequency(void* state, const pp_context* ctx, const pp_task* task, int32_t queued) {
+    (void)ctx;
+    (void)queued;
+    return task != NULL ? ((const srtf_state*)state)->frequency : 0.5;
+}
+
+static const pp_scheduler_plugin kPlugin = {
+    PP_PLUGIN_ABI_VERSION,
+    "SRTF (plugin)",
+    srtf_create,
+    srtf_destroy,
+    srtf_pick_next,
+    srtf_select_frequency
+};
+
+const pp_scheduler_plugin* pp_scheduler_plugin_v1(void) {
+    return &kPlugin;
+}
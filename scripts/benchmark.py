@@ -13,10 +13,11 @@ import time
 from pathlib import Path
 
 class BenchmarkRunner:
-    def __init__(self, powerprofile_binary="./powerprofile", results_dir="results"):
+    def __init__(self, powerprofile_binary="./powerprofile", results_dir="results", cache_dir=None):
         self.binary = powerprofile_binary
         self.results = []
         self.results_dir = results_dir
+        self.cache_dir = cache_dir
         os.makedirs(self.results_dir, exist_ok=True)
         
     def run_single_benchmark(self, scheduler, tasks, duration, seed=42):
@@ -29,6 +30,8 @@ class BenchmarkRunner:
             "--seed", str(seed),
             "--output", output_file
         ]
+        if self.cache_dir:
+            cmd += ["--cache", self.cache_dir]
         print(f"Running: {' '.join(cmd)}")
         try:
             start_time = time.time()
@@ -42,8 +45,10 @@ class BenchmarkRunner:
                     row['tasks_param'] = tasks
                     row['duration_param'] = duration
                     row['seed_param'] = seed
+                    row['cached'] = "Result cache: 1 hits" in result.stdout
                     self.results.append(row)
-                    print(f"✓ Completed in {end_time - start_time:.2f}s")
+                    status = "cached" if row['cached'] else "simulated"
+                    print(f"✓ Completed in {end_time - start_time:.2f}s ({status})")
                     # Move task details file if exists
                     task_file = output_file.replace('.csv', '_tasks.csv')
                     if os.path.exists(task_file):
@@ -163,12 +168,15 @@ def main():
     parser.add_argument('--tasks', type=int, default=50, help='Number of tasks')
     parser.add_argument('--duration', type=int, default=10000, help='Simulation duration')
     parser.add_argument('--results-dir', default='results', help='Directory to save results and plots')
+    parser.add_argument('--cache-dir', help='Result cache directory (default: <results-dir>/.cache)')
+    parser.add_argument('--no-cache', action='store_true', help='Simulate every point even if cached')
     args = parser.parse_args()
     if not os.path.exists(args.binary):
         print(f"Error: PowerProfile binary '{args.binary}' not found")
         print("Please build the project first: cmake --build build")
         return 1
-    runner = BenchmarkRunner(args.binary, results_dir=args.results_dir)
+    cache_dir = None if args.no_cache else (args.cache_dir or os.path.join(args.results_dir, ".cache"))
+    runner = BenchmarkRunner(args.binary, results_dir=args.results_dir, cache_dir=cache_dir)
     if args.sweep:
         runner.run_parameter_sweep()
     elif args.scalability:
@@ -0,0 +1,132 @@
+#include "ClusterSimulator.h"
+#include <algorithm>
+#include <future>
+
+ClusterSimulator::ClusterSimulator(int machines, const EngineFactory& factory, const LoadBalancer& balancer,
+                                   int epoch_ticks, size_t threads)
+    : balancer_(balancer), epoch_ticks_(std::max(1, epoch_ticks)), pool_(threads), epochs_(0) {
+    for (int i = 0; i < machines; ++i) {
+        machines_.push_back(factory(i));
+        // Machines idle until the horizon unless the cluster ends the run
+        machines_.back()->setEndCondition(EndCondition::HORIZON);
+    }
+    reports_.resize(machines_.size());
+}
+
+SimulationStats ClusterSimulator::run(const std::vector<Task>& tasks, int max_time) {
+    std::vector<Task> arrivals = tasks;
+    std::stable_sort(arrivals.begin(), arrivals.end(),
+                     [](const Task& a, const Task& b) { return a.getArrivalTime() < b.getArrivalTime(); });
+    for (auto& machine : machines_) {
+        machine->start({}, max_time);
+    }
+    epochs_ = 0;
+    
+    int time = 0;
+    size_t next = 0;
+    while (time < max_time) {
+        bool busy = false;
+        for (size_t i = 0; i < machines_.size(); ++i) {
+            const SimulationEngine& machine = *machines_[i];
+            reports_[i].outstanding_tasks = machine.getOutstandingTasks();
+            reports_[i].thermal_headroom = machines_[i]->getThermalGovernor().getHeadroom(machine.getCurrentTemperature());
+            busy = busy || reports_[i].outstanding_tasks > 0;
+        }
+        if (!busy && next == arrivals.size()) {
+            break;
+        }
+        
+        int epoch_end = std::min(max_time, time + epoch_ticks_);
+        if (!busy) {
+            // The whole cluster is idle: skip ahead to the epoch of the next arrival
+            int arrival = arrivals[next].getArrivalTime();
+            epoch_end = std::min(max_time, std::max(epoch_end, arrival - arrival % epoch_ticks_ + epoch_ticks_));
+        }
+        
+        balancer_.refresh(reports_);
+        while (next < arrivals.size() && arrivals[next].getArrivalTime() < epoch_end) {
+            machines_[balancer_.choose()]->submit(arrivals[next]);
+            next++;
+        }
+        advanceMachines(epoch_end);
+        time = epoch_end;
+        epochs_++;
+    }
+    
+    machine_stats_.clear();
+    for (const auto& machine : machines_) {
+        machine_stats_.push_back(machine->collectStats());
+    }
+    return aggregate(time);
+}
+
+void ClusterSimulator::advanceMachines(int time) {
+    // A few contiguous chunks per worker balance uneven machine loads
+    size_t chunks = std::min(machines_.size(), pool_.size() * 4);
+    size_t chunk_size = (machines_.size() + chunks - 1) / chunks;
+    std::vector<std::future<void>> done;
+    for (size_t begin = 0; begin < machines_.size(); begin += chunk_size) {
+        size_t end = std::min(machines_.size(), begin + chunk_size);
+        done.push_back(pool_.submit([this, begin, end, time] {
+            for (size_t i = begin; i < end; ++i) {
+                machines_[i]->advanceTo(time);
+            }
+        }));
+    }
+    for (auto& chunk : done) {
+        chunk.get();
+    }
+}
+
+SimulationStats ClusterSimulator::aggregate(int end_time) const {
+    SimulationStats stats = {};
+    stats.total_execution_time = end_time;
+    stats.scheduler_name = LoadBalancer::getPolicyName(balancer_.getPolicy());
+    double throttle_loss = 0.0;
+    double cap_share = 0.0;
+    for (const SimulationStats& machine : machine_stats_) {
+        stats.total_tasks += machine.total_tasks;
+        stats.total_energy_joules += machine.total_energy_joules;
+        stats.peak_temperature_celsius = std::max(stats.peak_temperature_celsius, machine.peak_temperature_celsius);
+        stats.throttled_time_ticks += machine.throttled_time_ticks;
+        stats.throttle_events += machine.throttle_events;
+        throttle_loss += machine.throughput_loss_percent;
+        stats.power_capped_ticks += machine.power_capped_ticks;
+        cap_share += machine.power_cap_loss_percent;
+        stats.leakage_energy_joules += machine.leakage_energy_joules;
+        stats.idle_energy_joules += machine.idle_energy_joules;
+        stats.wakeups += machine.wakeups;
+        stats.context_switches += machine.context_switches;
+        stats.preemptions += machine.preemptions;
+        stats.switch_overhead_ticks += machine.switch_overhead_ticks;
+        stats.switch_energy_joules += machine.switch_energy_joules;
+        for (size_t i = 0; i < machine.cstate_residency.size(); ++i) {
+            if (stats.cstate_residency.size() <= i) {
+                stats.cstate_residency.emplace_back(machine.cstate_residency[i].first, 0);
+            }
+            stats.cstate_residency[i].second += machine.cstate_residency[i].second;
+        }
+        stats.energy_by_type.resize(std::max(stats.energy_by_type.size(), machine.energy_by_type.size()),
+                                    TypeEnergy{0, 0, 0.0, 0.0, 0.0});
+        for (size_t i = 0; i < machine.energy_by_type.size(); ++i) {
+            TypeEnergy& type = stats.energy_by_type[i];
+            type.tasks_run += machine.energy_by_type[i].tasks_run;
+            type.tasks_completed += machine.energy_by_type[i].tasks_completed;
+            type.active_energy_joules += machine.energy_by_type[i].active_energy_joules;
+            type.idle_energy_joules += machine.energy_by_type[i].idle_energy_joules;
+            type.peak_temperature_celsius = std::max(type.peak_temperature_celsius,
+                                                     machine.energy_by_type[i].peak_temperature_celsius);
+        }
+        stats.latency.merge(machine.latency);
+        stats.completed_tasks.insert(stats.completed_tasks.end(), machine.completed_tasks.begin(),
+                                     machine.completed_tasks.end());
+        stats.task_energy.insert(stats.task_energy.end(), machine.task_energy.begin(), machine.task_energy.end());
+    }
+    // Loss percentages are averaged over machines
+    if (!machine_stats_.empty()) {
+        stats.throughput_loss_percent = throttle_loss / machine_stats_.size();
+        stats.power_cap_loss_percent = cap_share / machine_stats_.size();
+    }
+    stats.average_power_watts = (end_time > 0) ? stats.total_energy_joules / (end_time / 1000.0) : 0.0;
+    return stats;
+}
@@ -0,0 +1,49 @@
+#ifndef CLUSTER_SIMULATOR_H
+#define CLUSTER_SIMULATOR_H
+
+#include "cluster/LoadBalancer.h"
+#include "core/SimulationEngine.h"
+#include "core/ThreadPool.h"
+#include "tasks/Task.h"
+#include <functional>
+#include <memory>
+#include <vector>
+
+// Many machines behind one dispatcher, simulated as parallel logical processes
+// with conservative synchronization. Time advances in epochs whose length is
+// the lookahead: at each boundary every machine reports its load, the
+// dispatcher routes all tasks arriving within the epoch from those reports,
+// and the machines then advance to the next boundary independently on the
+// thread pool. No machine can receive work for a time it has already passed,
+// and the results do not depend on the number of threads.
+class ClusterSimulator {
+public:
+    typedef std::function<std::unique_ptr<SimulationEngine>(int machine)> EngineFactory;
+    
+    // threads = 0 uses one per hardware thread
+    ClusterSimulator(int machines, const EngineFactory& factory, const LoadBalancer& balancer,
+                     int epoch_ticks = 10, size_t threads = 0);
+    
+    // Run until all tasks are done (at an epoch boundary) or max_time; returns
+    // the cluster totals with per-task latencies merged across machines
+    SimulationStats run(const std::vector<Task>& tasks, int max_time = 50000);
+    
+    int getMachineCount() const { return static_cast<int>(machines_.size()); }
+    int getEpochs() const { return epochs_; }
+    size_t getThreadCount() const { return pool_.size(); }
+    const std::vector<SimulationStats>& getMachineStats() const { return machine_stats_; }
+    
+private:
+    std::vector<std::unique_ptr<SimulationEngine>> machines_;
+    LoadBalancer balancer_;
+    int epoch_ticks_;
+    ThreadPool pool_;
+    std::vector<MachineReport> reports_;
+    std::vector<SimulationStats> machine_stats_;
+    int epochs_;
+    
+    void advanceMachines(int time);
+    SimulationStats aggregate(int end_time) const;
+};
+
+#endif // CLUSTER_SIMULATOR_H
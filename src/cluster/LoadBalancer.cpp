@@ -0,0 +1,107 @@
+#include "LoadBalancer.h"
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+LoadBalancer::LoadBalancer(BalancePolicy policy, uint64_t seed, int pack_limit, double thermal_margin)
+    : policy_(policy), rng_(seed), pack_limit_(std::max(1, pack_limit)), thermal_margin_(thermal_margin) {
+}
+
+void LoadBalancer::refresh(const std::vector<MachineReport>& reports) {
+    loads_.resize(reports.size());
+    for (size_t i = 0; i < reports.size(); ++i) {
+        loads_[i] = reports[i].outstanding_tasks;
+    }
+    
+    if (policy_ == BalancePolicy::LEAST_LOADED) {
+        heap_.clear();
+        for (size_t i = 0; i < loads_.size(); ++i) {
+            heap_.emplace_back(loads_[i], static_cast<int>(i));
+        }
+        std::make_heap(heap_.begin(), heap_.end(), std::greater<std::pair<int, int>>());
+    } else if (policy_ == BalancePolicy::ENERGY_AWARE) {
+        buckets_.resize(pack_limit_);
+        for (auto& bucket : buckets_) {
+            bucket.clear();
+        }
+        // Reverse order so that, within a bucket, lower-numbered machines fill first
+        for (size_t i = loads_.size(); i-- > 0; ) {
+            if (loads_[i] < pack_limit_ && reports[i].thermal_headroom > thermal_margin_) {
+                buckets_[loads_[i]].push_back(static_cast<int>(i));
+            }
+        }
+    }
+}
+
+int LoadBalancer::choose() {
+    if (loads_.empty()) {
+        throw std::runtime_error("load balancer has no machines");
+    }
+    int machine = 0;
+    switch (policy_) {
+        case BalancePolicy::RANDOM:
+            machine = static_cast<int>(rng_() % loads_.size());
+            break;
+        case BalancePolicy::LEAST_LOADED: {
+            std::pop_heap(heap_.begin(), heap_.end(), std::greater<std::pair<int, int>>());
+            machine = heap_.back().second;
+            heap_.back().first++;
+            std::push_heap(heap_.begin(), heap_.end(), std::greater<std::pair<int, int>>());
+            break;
+        }
+        case BalancePolicy::POWER_OF_TWO:
+            return chooseTwo();
+        case BalancePolicy::ENERGY_AWARE: {
+            int load = pack_limit_ - 1;
+            while (load >= 0 && buckets_[load].empty()) {
+                load--;
+            }
+            if (load < 0) {
+                return chooseTwo();
+            }
+            machine = buckets_[load].back();
+            buckets_[load].pop_back();
+            if (load + 1 < pack_limit_) {
+                buckets_[load + 1].push_back(machine);
+            }
+            break;
+        }
+    }
+    loads_[machine]++;
+    return machine;
+}
+
+int LoadBalancer::chooseTwo() {
+    int first = static_cast<int>(rng_() % loads_.size());
+    int second = static_cast<int>(rng_() % loads_.size());
+    int machine = (loads_[second] < loads_[first]) ? second : first;
+    loads_[machine]++;
+    return machine;
+}
+
+BalancePolicy LoadBalancer::parsePolicy(const std::string& name) {
+    if (name == "random") {
+        return BalancePolicy::RANDOM;
+    } else if (name == "least") {
+        return BalancePolicy::LEAST_LOADED;
+    } else if (name == "p2c") {
+        return BalancePolicy::POWER_OF_TWO;
+    } else if (name == "energy") {
+        return BalancePolicy::ENERGY_AWARE;
+    }
+    throw std::invalid_argument("unknown cluster policy: " + name);
+}
+
+const char* LoadBalancer::getPolicyName(BalancePolicy policy) {
+    switch (policy) {
+        case BalancePolicy::RANDOM:
+            return "Random";
+        case BalancePolicy::LEAST_LOADED:
+            return "Least-Loaded";
+        case BalancePolicy::POWER_OF_TWO:
+            return "Power-of-Two";
+        case BalancePolicy::ENERGY_AWARE:
+        default:
+            return "Energy-Aware";
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef LOAD_BALANCER_H
+#define LOAD_BALANCER_H
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+enum class BalancePolicy {
+    RANDOM,
+    LEAST_LOADED,
+    POWER_OF_TWO,
+    ENERGY_AWARE
+};
+
+// What a machine reports to the dispatcher at an epoch boundary
+struct MachineReport {
+    int outstanding_tasks;
+    double thermal_headroom;   // Degrees below the machine's throttle trip point
+};
+
+// Front-end dispatcher of a cluster. Reports are refreshed once per epoch, and
+// every task routed since counts towards its machine's load, so decisions see
+// the loads they created themselves plus progress up to the last refresh.
+//   RANDOM        uniform choice
+//   LEAST_LOADED  global minimum load (heap, O(log N) per task)
+//   POWER_OF_TWO  the less loaded of two random machines
+//   ENERGY_AWARE  packs tasks onto the most loaded machine still below the
+//                 pack limit and outside the thermal margin, so unused machines
+//                 stay in deep idle; falls back to two choices when all are full
+class LoadBalancer {
+public:
+    LoadBalancer(BalancePolicy policy, uint64_t seed, int pack_limit = 4, double thermal_margin = 5.0);
+    
+    void refresh(const std::vector<MachineReport>& reports);
+    
+    // Machine for the next task; counts the task into that machine's load
+    int choose();
+    
+    BalancePolicy getPolicy() const { return policy_; }
+    static BalancePolicy parsePolicy(const std::string& name);
+    static const char* getPolicyName(BalancePolicy policy);
+    
+private:
+    BalancePolicy policy_;
+    std::mt19937_64 rng_;
+    int pack_limit_;
+    double thermal_margin_;
+    
+    std::vector<int> loads_;
+    std::vector<std::pair<int, int>> heap_;        // (load, machine), min-heap for LEAST_LOADED
+    std::vector<std::vector<int>> buckets_;        // Eligible machines by load, for ENERGY_AWARE
+    
+    int chooseTwo();
+};
+
+#endif // LOAD_BALANCER_H
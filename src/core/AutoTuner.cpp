@@ -0,0 +1,352 @@
+#include "AutoTuner.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <iomanip>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <sstream>
+
+namespace {
+const double kInfinity = std::numeric_limits<double>::infinity();
+
+// Covariance matrix adaptation evolution strategy over the unit cube, with the
+// default parameter settings; samples outside the cube are clipped back in
+class CmaEs {
+public:
+    CmaEs(int dimensions, int population, double sigma, std::mt19937_64& rng)
+        : n_(dimensions), lambda_(std::max(2, population)), mu_(lambda_ / 2), sigma_(sigma), generation_(0),
+          rng_(rng) {
+        for (int i = 0; i < mu_; ++i) {
+            weights_.push_back(std::log(mu_ + 0.5) - std::log(i + 1.0));
+        }
+        double sum = std::accumulate(weights_.begin(), weights_.end(), 0.0);
+        double sum_squares = 0.0;
+        for (double& w : weights_) {
+            w /= sum;
+            sum_squares += w * w;
+        }
+        mu_eff_ = 1.0 / sum_squares;
+        
+        cc_ = (4.0 + mu_eff_ / n_) / (n_ + 4.0 + 2.0 * mu_eff_ / n_);
+        cs_ = (mu_eff_ + 2.0) / (n_ + mu_eff_ + 5.0);
+        c1_ = 2.0 / ((n_ + 1.3) * (n_ + 1.3) + mu_eff_);
+        cmu_ = std::min(1.0 - c1_, 2.0 * (mu_eff_ - 2.0 + 1.0 / mu_eff_) / ((n_ + 2.0) * (n_ + 2.0) + mu_eff_));
+        damps_ = 1.0 + 2.0 * std::max(0.0, std::sqrt((mu_eff_ - 1.0) / (n_ + 1.0)) - 1.0) + cs_;
+        chi_n_ = std::sqrt(static_cast<double>(n_)) * (1.0 - 1.0 / (4.0 * n_) + 1.0 / (21.0 * n_ * n_));
+        
+        mean_.assign(n_, 0.5);
+        pc_.assign(n_, 0.0);
+        ps_.assign(n_, 0.0);
+        C_.assign(n_, std::vector<double>(n_, 0.0));
+        B_.assign(n_, std::vector<double>(n_, 0.0));
+        D_.assign(n_, 1.0);
+        for (int i = 0; i < n_; ++i) {
+            C_[i][i] = 1.0;
+            B_[i][i] = 1.0;
+        }
+    }
+    
+    std::vector<std::vector<double>> ask() {
+        std::normal_distribution<double> normal(0.0, 1.0);
+        std::vector<std::vector<double>> samples(lambda_, std::vector<double>(n_));
+        std::vector<double> z(n_);
+        for (auto& x : samples) {
+            for (double& value : z) {
+                value = normal(rng_);
+            }
+            for (int i = 0; i < n_; ++i) {
+                double y = 0.0;
+                for (int j = 0; j < n_; ++j) {
+                    y += B_[i][j] * D_[j] * z[j];
+                }
+                x[i] = std::min(1.0, std::max(0.0, mean_[i] + sigma_ * y));
+            }
+        }
+        return samples;
+    }
+    
+    // ranked holds this generation's samples, best first
+    void tell(const std::vector<std::vector<double>>& ranked) {
+        std::vector<double> old_mean = mean_;
+        std::fill(mean_.begin(), mean_.end(), 0.0);
+        for (int k = 0; k < mu_; ++k) {
+            for (int i = 0; i < n_; ++i) {
+                mean_[i] += weights_[k] * ranked[k][i];
+            }
+        }
+        std::vector<double> step(n_);
+        for (int i = 0; i < n_; ++i) {
+            step[i] = (mean_[i] - old_mean[i]) / sigma_;
+        }
+        
+        // Evolution paths; the conjugate path uses C^-1/2 = B D^-1 B^T
+        std::vector<double> rotated(n_, 0.0);
+        for (int j = 0; j < n_; ++j) {
+            double projection = 0.0;
+            for (int i = 0; i < n_; ++i) {
+                projection += B_[i][j] * step[i];
+            }
+            projection /= D_[j];
+            for (int i = 0; i < n_; ++i) {
+                rotated[i] += B_[i][j] * projection;
+            }
+        }
+        double ps_norm = 0.0;
+        for (int i = 0; i < n_; ++i) {
+            ps_[i] = (1.0 - cs_) * ps_[i] + std::sqrt(cs_ * (2.0 - cs_) * mu_eff_) * rotated[i];
+            ps_norm += ps_[i] * ps_[i];
+        }
+        ps_norm = std::sqrt(ps_norm);
+        generation_++;
+        bool hsig = ps_norm / std::sqrt(1.0 - std::pow(1.0 - cs_, 2.0 * generation_)) / chi_n_ <
+                    1.4 + 2.0 / (n_ + 1.0);
+        for (int i = 0; i < n_; ++i) {
+            pc_[i] = (1.0 - cc_) * pc_[i] + (hsig ? std::sqrt(cc_ * (2.0 - cc_) * mu_eff_) * step[i] : 0.0);
+        }
+        
+        // Rank-one and rank-mu covariance updates
+        double keep = 1.0 - c1_ - cmu_ + (hsig ? 0.0 : c1_ * cc_ * (2.0 - cc_));
+        for (int i = 0; i < n_; ++i) {
+            for (int j = 0; j <= i; ++j) {
+                double rank_mu = 0.0;
+                for (int k = 0; k < mu_; ++k) {
+                    rank_mu += weights_[k] * (ranked[k][i] - old_mean[i]) * (ranked[k][j] - old_mean[j]);
+                }
+                C_[i][j] = keep * C_[i][j] + c1_ * pc_[i] * pc_[j] + cmu_ * rank_mu / (sigma_ * sigma_);
+                C_[j][i] = C_[i][j];
+            }
+        }
+        sigma_ *= std::exp((cs_ / damps_) * (ps_norm / chi_n_ - 1.0));
+        sigma_ = std::min(0.5, std::max(1e-3, sigma_));
+        decompose();
+    }
+
+private:
+    int n_;
+    int lambda_;
+    int mu_;
+    std::vector<double> weights_;
+    double mu_eff_, cc_, cs_, c1_, cmu_, damps_, chi_n_;
+    std::vector<double> mean_;
+    std::vector<double> pc_;
+    std::vector<double> ps_;
+    double sigma_;
+    std::vector<std::vector<double>> C_;
+    std::vector<std::vector<double>> B_;   // Eigenvectors of C in columns
+    std::vector<double> D_;                // Square roots of the eigenvalues
+    int generation_;
+    std::mt19937_64& rng_;
+    
+    // Cyclic Jacobi rotations; the matrices are tiny, so this converges in a few sweeps
+    void decompose() {
+        std::vector<std::vector<double>> a = C_;
+        for (int i = 0; i < n_; ++i) {
+            std::fill(B_[i].begin(), B_[i].end(), 0.0);
+            B_[i][i] = 1.0;
+        }
+        for (int sweep = 0; sweep < 50; ++sweep) {
+            double off = 0.0;
+            for (int p = 0; p < n_; ++p) {
+                for (int q = p + 1; q < n_; ++q) {
+                    off += a[p][q] * a[p][q];
+                }
+            }
+            if (off < 1e-24) {
+                break;
+            }
+            for (int p = 0; p < n_; ++p) {
+                for (int q = p + 1; q < n_; ++q) {
+                    if (std::fabs(a[p][q]) < 1e-300) {
+                        continue;
+                    }
+                    double theta = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+                    double t = (theta >= 0.0 ? 1.0 : -1.0) / (std::fabs(theta) + std::sqrt(theta * theta + 1.0));
+                    double c = 1.0 / std::sqrt(t * t + 1.0);
+                    double s = t * c;
+                    for (int k = 0; k < n_; ++k) {
+                        double akp = a[k][p];
+                        double akq = a[k][q];
+                        a[k][p] = c * akp - s * akq;
+                        a[k][q] = s * akp + c * akq;
+                    }
+                    for (int k = 0; k < n_; ++k) {
+                        double apk = a[p][k];
+                        double aqk = a[q][k];
+                        a[p][k] = c * apk - s * aqk;
+                        a[q][k] = s * apk + c * aqk;
+                    }
+                    for (int k = 0; k < n_; ++k) {
+                        double bkp = B_[k][p];
+                        double bkq = B_[k][q];
+                        B_[k][p] = c * bkp - s * bkq;
+                        B_[k][q] = s * bkp + c * bkq;
+                    }
+                }
+            }
+        }
+        for (int i = 0; i < n_; ++i) {
+            D_[i] = std::sqrt(std::max(1e-20, a[i][i]));
+        }
+    }
+};
+}
+
+std::string TunerDimension::format(double value) const {
+    if (!labels.empty()) {
+        size_t index = static_cast<size_t>(std::max(0.0, value));
+        return index < labels.size() ? labels[index] : std::to_string(index);
+    }
+    if (integer) {
+        return std::to_string(static_cast<long long>(value));
+    }
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2) << value;
+    return oss.str();
+}
+
+AutoTuner::AutoTuner(std::vector<TunerDimension> space, Evaluator evaluator, Options options)
+    : space_(std::move(space)), evaluator_(std::move(evaluator)), options_(options) {
+}
+
+AutoTuner::Point AutoTuner::decode(const std::vector<double>& unit) const {
+    Point params(space_.size());
+    for (size_t i = 0; i < space_.size(); ++i) {
+        const TunerDimension& dim = space_[i];
+        double value = dim.log_scale ? dim.min * std::pow(dim.max / dim.min, unit[i])
+                                     : dim.min + (dim.max - dim.min) * unit[i];
+        params[i] = dim.integer ? std::round(value) : value;
+    }
+    return params;
+}
+
+std::vector<AutoTuner::Candidate> AutoTuner::evaluateAll(ThreadPool& pool, const std::vector<Point>& points,
+                                                         double fidelity) {
+    // Configurations already simulated at this fidelity (or repeated within the
+    // batch after rounding) are not simulated again
+    std::map<Point, std::future<SimulationStats>> pending;
+    for (const Point& params : points) {
+        if (results_.count({params, fidelity}) == 0 && pending.count(params) == 0) {
+            pending.emplace(params, pool.submit([this, params, fidelity] { return evaluator_(params, fidelity); }));
+        }
+    }
+    for (auto& entry : pending) {
+        SimulationStats stats = entry.second.get();
+        Candidate candidate;
+        candidate.params = entry.first;
+        candidate.fidelity = fidelity;
+        candidate.completed = stats.total_tasks;
+        candidate.energy_per_task = stats.total_tasks > 0 ? stats.total_energy_joules / stats.total_tasks : kInfinity;
+        candidate.latency = stats.latency.turnaround.getCount() > 0 ? stats.latency.turnaround.percentile(0.99)
+                                                                    : kInfinity;
+        results_.emplace(std::make_pair(entry.first, fidelity), candidate);
+    }
+    
+    std::vector<Candidate> candidates;
+    candidates.reserve(points.size());
+    for (const Point& params : points) {
+        candidates.push_back(results_.at({params, fidelity}));
+    }
+    return candidates;
+}
+
+double AutoTuner::scalarize(const Candidate& candidate, double weight) {
+    if (std::isinf(candidate.energy_per_task) || std::isinf(candidate.latency)) {
+        return kInfinity;
+    }
+    return weight * std::log(candidate.energy_per_task) + (1.0 - weight) * std::log(std::max(1.0, candidate.latency));
+}
+
+bool AutoTuner::dominates(const Candidate& a, const Candidate& b) {
+    return a.energy_per_task <= b.energy_per_task && a.latency <= b.latency &&
+           (a.energy_per_task < b.energy_per_task || a.latency < b.latency);
+}
+
+void AutoTuner::run() {
+    ThreadPool pool(options_.threads);
+    std::mt19937_64 rng(options_.seed);
+    int rungs = std::max(1, options_.rungs);
+    
+    for (int k = 0; k < options_.weightings; ++k) {
+        double weight = (k + 0.5) / options_.weightings;
+        CmaEs strategy(static_cast<int>(space_.size()), options_.population, 0.3, rng);
+        
+        for (int generation = 0; generation < options_.generations; ++generation) {
+            std::vector<std::vector<double>> samples = strategy.ask();
+            std::vector<Point> points;
+            for (const auto& sample : samples) {
+                points.push_back(decode(sample));
+            }
+            
+            // Successive halving: each rung runs the survivors longer and keeps the
+            // best 1/eta. The final ranking puts later-rung survivors first.
+            std::vector<size_t> survivors(points.size());
+            std::iota(survivors.begin(), survivors.end(), 0);
+            std::vector<size_t> ranking;
+            for (int rung = 0; rung < rungs; ++rung) {
+                double fidelity = std::pow(static_cast<double>(options_.eta), rung - (rungs - 1));
+                std::vector<Point> batch;
+                for (size_t index : survivors) {
+                    batch.push_back(points[index]);
+                }
+                std::vector<Candidate> results = evaluateAll(pool, batch, fidelity);
+                std::vector<double> scores(points.size(), kInfinity);
+                for (size_t i = 0; i < survivors.size(); ++i) {
+                    scores[survivors[i]] = scalarize(results[i], weight);
+                }
+                std::stable_sort(survivors.begin(), survivors.end(),
+                                 [&scores](size_t a, size_t b) { return scores[a] < scores[b]; });
+                
+                size_t keep = survivors.size();
+                if (rung + 1 < rungs) {
+                    keep = std::max<size_t>(1, (survivors.size() + options_.eta - 1) / options_.eta);
+                }
+                ranking.insert(ranking.begin(), survivors.begin() + keep, survivors.end());
+                survivors.resize(keep);
+            }
+            ranking.insert(ranking.begin(), survivors.begin(), survivors.end());
+            
+            std::vector<std::vector<double>> ranked;
+            for (size_t index : ranking) {
+                ranked.push_back(samples[index]);
+            }
+            strategy.tell(ranked);
+        }
+    }
+}
+
+std::vector<AutoTuner::Candidate> AutoTuner::getParetoFront() const {
+    std::vector<Candidate> full;
+    for (const auto& entry : results_) {
+        const Candidate& candidate = entry.second;
+        if (candidate.fidelity >= 1.0 && !std::isinf(candidate.energy_per_task) && !std::isinf(candidate.latency)) {
+            full.push_back(candidate);
+        }
+    }
+    std::vector<Candidate> front;
+    for (const Candidate& candidate : full) {
+        bool dominated = std::any_of(full.begin(), full.end(),
+                                     [&candidate](const Candidate& other) { return dominates(other, candidate); });
+        if (!dominated) {
+            front.push_back(candidate);
+        }
+    }
+    std::sort(front.begin(), front.end(), [](const Candidate& a, const Candidate& b) {
+        return a.energy_per_task != b.energy_per_task ? a.energy_per_task < b.energy_per_task : a.latency < b.latency;
+    });
+    // Parameters the objectives are insensitive to yield ties; keep one of each
+    front.erase(std::unique(front.begin(), front.end(), [](const Candidate& a, const Candidate& b) {
+        return a.energy_per_task == b.energy_per_task && a.latency == b.latency;
+    }), front.end());
+    return front;
+}
+
+double AutoTuner::getFullRunEquivalents() const {
+    double total = 0.0;
+    for (const auto& entry : results_) {
+        total += entry.second.fidelity;
+    }
+    return total;
+}
@@ -0,0 +1,81 @@
+#ifndef AUTO_TUNER_H
+#define AUTO_TUNER_H
+
+#include "core/SimulationEngine.h"
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+class ThreadPool;
+
+// One searchable parameter; integer dimensions are rounded after decoding and
+// log-scaled ones are searched uniformly in log space. Categorical parameters
+// are integer dimensions over [0, labels - 1] with a label per value.
+struct TunerDimension {
+    std::string name;
+    double min;
+    double max;
+    bool integer;
+    bool log_scale;
+    std::vector<std::string> labels;
+    
+    std::string format(double value) const;
+};
+
+// Multi-objective parameter search trading energy per completed task against
+// p99 turnaround. Several CMA-ES searches each minimise a different weighting of
+// the two (log-scaled) objectives; within every generation the population is
+// screened by successive halving on shortened runs, so only the best candidates
+// are simulated at full length. Every full-length result feeds a Pareto archive.
+class AutoTuner {
+public:
+    typedef std::vector<double> Point;   // Decoded values, one per dimension
+    
+    // Simulate a configuration; fidelity in (0, 1] is the fraction of the full run
+    typedef std::function<SimulationStats(const Point& params, double fidelity)> Evaluator;
+    
+    struct Options {
+        int weightings = 4;      // Independent CMA-ES searches along the trade-off
+        int generations = 6;
+        int population = 12;
+        int rungs = 3;           // Successive-halving fidelities: eta^-(rungs-1) ... 1
+        int eta = 3;
+        unsigned int seed = 1;
+        size_t threads = 0;      // 0 = one per hardware thread
+    };
+    
+    struct Candidate {
+        Point params;
+        double fidelity;
+        double energy_per_task;  // Joules; infinite when nothing completed
+        double latency;          // p99 turnaround in ticks
+        int completed;
+    };
+    
+    AutoTuner(std::vector<TunerDimension> space, Evaluator evaluator, Options options);
+    
+    void run();
+    
+    // Non-dominated full-length results, by increasing energy per task
+    std::vector<Candidate> getParetoFront() const;
+    const std::vector<TunerDimension>& getSpace() const { return space_; }
+    
+    // Distinct simulations, and their total length in full-run equivalents
+    int getSimulationCount() const { return static_cast<int>(results_.size()); }
+    double getFullRunEquivalents() const;
+
+private:
+    std::vector<TunerDimension> space_;
+    Evaluator evaluator_;
+    Options options_;
+    std::map<std::pair<Point, double>, Candidate> results_;   // Memoised by (params, fidelity)
+    
+    Point decode(const std::vector<double>& unit) const;
+    std::vector<Candidate> evaluateAll(ThreadPool& pool, const std::vector<Point>& points, double fidelity);
+    static double scalarize(const Candidate& candidate, double weight);
+    static bool dominates(const Candidate& a, const Candidate& b);
+};
+
+#endif // AUTO_TUNER_H
@@ -0,0 +1,359 @@
+#include "BatchSimulationEngine.h"
+#include "models/SimdKernels.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+// Task durations are expressed in ticks at this frequency
+const double kReferenceFrequencyGHz = 1.0;
+
+const double kTickSeconds = 0.001;
+}
+
+BatchSimulationEngine::BatchSimulationEngine()
+    : end_condition_(EndCondition::DRAIN), cooldown_ticks_(1000), io_channels_(0), io_latency_ticks_(0) {
+    energy_model_ = std::make_unique<EnergyModel>();
+    thermal_model_ = std::make_unique<ThermalModel>();
+}
+
+int BatchSimulationEngine::addLane(std::unique_ptr<Scheduler> scheduler, const std::vector<Task>& tasks,
+                                   int max_time) {
+    Lane lane;
+    lane.scheduler = std::move(scheduler);
+    lane.pending_arrivals = tasks;
+    std::stable_sort(lane.pending_arrivals.begin(), lane.pending_arrivals.end(),
+                     [](const Task& a, const Task& b) { return a.getArrivalTime() < b.getArrivalTime(); });
+    lane.max_time = max_time;
+    lanes_.push_back(std::move(lane));
+    return static_cast<int>(lanes_.size()) - 1;
+}
+
+void BatchSimulationEngine::setEnergyModel(std::unique_ptr<EnergyModel> energy_model) {
+    energy_model_ = std::move(energy_model);
+}
+
+void BatchSimulationEngine::setThermalModel(std::unique_ptr<ThermalModel> thermal_model) {
+    if (thermal_model->getName() != "lumped") {
+        throw std::invalid_argument("batched simulation supports only the lumped thermal model");
+    }
+    thermal_model_ = std::move(thermal_model);
+}
+
+void BatchSimulationEngine::setThermalGovernor(const ThermalGovernor& governor) {
+    governor_template_ = governor;
+}
+
+void BatchSimulationEngine::setEndCondition(EndCondition condition, int cooldown_ticks) {
+    end_condition_ = condition;
+    cooldown_ticks_ = cooldown_ticks;
+}
+
+void BatchSimulationEngine::setIODevice(int channels, int latency_ticks) {
+    io_channels_ = channels;
+    io_latency_ticks_ = latency_ticks;
+}
+
+const char* BatchSimulationEngine::getInstructionSet() {
+    return SimdKernels::getInstructionSet();
+}
+
+std::vector<SimulationStats> BatchSimulationEngine::run() {
+    initializeArrays();
+    
+    const std::vector<double>& table = energy_model_->getLeakageTable();
+    SimdKernels::LeakageTable leakage = {table.data(), static_cast<int>(table.size()),
+                                         EnergyModel::getLeakageTableMin(), EnergyModel::getLeakageTableStep()};
+    SimdKernels::LaneArrays arrays = {dynamic_power_.data(), leakage_scale_.data(), ambient_.data(),
+                                      heating_.data(), cooling_.data(), temperature_.data(),
+                                      peak_temperature_.data(), energy_.data(), power_.data(),
+                                      leakage_power_.data()};
+    int padded = SimdKernels::paddedSize(static_cast<int>(lanes_.size()));
+    
+    size_t active = lanes_.size();
+    for (int time = 0; active > 0; ++time) {
+        // Scalar phase: scheduling decisions and this tick's power terms per lane
+        for (size_t k = 0; k < lanes_.size(); ++k) {
+            if (lanes_[k].mode != LaneMode::FINISHED) {
+                scheduleLane(lanes_[k], k, time);
+                if (lanes_[k].mode == LaneMode::FINISHED) {
+                    active--;
+                }
+            }
+        }
+        
+        // Vector phase: leakage, energy and temperature for all lanes at once
+        SimdKernels::stepLanes(arrays, padded, leakage, kTickSeconds);
+        
+        // Scalar phase: account the tick and let the schedulers advance
+        for (size_t k = 0; k < lanes_.size(); ++k) {
+            Lane& lane = lanes_[k];
+            if (lane.mode == LaneMode::FINISHED) {
+                continue;
+            }
+            double temperature = temperature_[k];
+            if (lane.mode == LaneMode::BUSY || lane.mode == LaneMode::SWITCHING) {
+                lane.leakage_energy += leakage_power_[k] * kTickSeconds;
+                lane.attribution.charge(*lane.current_task, power_[k] * kTickSeconds);
+                lane.attribution.heat(*lane.current_task, temperature);
+                if (lane.mode == LaneMode::SWITCHING) {
+                    lane.switch_energy += power_[k] * kTickSeconds;
+                    lane.switch_overhead_ticks++;
+                }
+                lane.thermal_governor.update(temperature, lane.requested_frequency, lane.frequency, 1, true);
+                if (lane.current_task->isCompleted()) {
+                    completeTask(lane, *lane.current_task, time + 1);
+                }
+                if (lane.mode == LaneMode::SWITCHING) {
+                    lane.scheduler->stallTick();
+                } else {
+                    lane.scheduler->tick();
+                }
+            } else {
+                lane.idle_energy += power_[k] * kTickSeconds;
+                lane.thermal_governor.update(temperature, lane.requested_frequency, lane.frequency, 1, false);
+                if (lane.mode == LaneMode::WAKING) {
+                    lane.idle_governor.finishWakeupTick();
+                    lane.scheduler->tick();
+                } else {
+                    lane.scheduler->advanceTicks(1);
+                }
+            }
+            lane.scheduler->setThermalHeadroom(lane.thermal_governor.getHeadroom(temperature));
+        }
+    }
+    
+    std::vector<SimulationStats> results;
+    results.reserve(lanes_.size());
+    for (size_t k = 0; k < lanes_.size(); ++k) {
+        results.push_back(collectStats(lanes_[k], k));
+    }
+    return results;
+}
+
+void BatchSimulationEngine::initializeArrays() {
+    thermal_model_->reset();
+    size_t padded = SimdKernels::paddedSize(static_cast<int>(lanes_.size()));
+    dynamic_power_.assign(padded, 0.0);
+    leakage_scale_.assign(padded, 0.0);
+    ambient_.assign(padded, 0.0);
+    heating_.assign(padded, 0.0);
+    cooling_.assign(padded, 0.0);
+    temperature_.assign(padded, 0.0);
+    peak_temperature_.assign(padded, 0.0);
+    energy_.assign(padded, 0.0);
+    power_.assign(padded, 0.0);
+    leakage_power_.assign(padded, 0.0);
+    
+    for (size_t k = 0; k < lanes_.size(); ++k) {
+        Lane& lane = lanes_[k];
+        lane.scheduler->reset();
+        lane.next_arrival = 0;
+        lane.wait_queue.configure(io_channels_, io_latency_ticks_);
+        lane.end_time = 0;
+        lane.last_completion_time = 0;
+        lane.thermal_governor = governor_template_;
+        lane.thermal_governor.reset();
+        lane.idle_governor.reset();
+        lane.completed_tasks.clear();
+        lane.latency.reset();
+        lane.attribution.reset();
+        lane.leakage_energy = 0.0;
+        lane.idle_energy = 0.0;
+        lane.observed_switches = 0;
+        lane.switch_stall = 0;
+        lane.switch_overhead_ticks = 0;
+        lane.switch_energy = 0.0;
+        lane.mode = LaneMode::IDLE;
+        lane.current_task = nullptr;
+        lane.requested_frequency = 0.0;
+        lane.frequency = 0.0;
+        lane.cached_frequency = -1.0;
+        lane.cached_leakage_scale = 0.0;
+        lane.cached_type = TaskType::CPU_BOUND;
+        lane.cached_dynamic_power = -1.0;
+        
+        ambient_[k] = thermal_model_->getAmbientTemperature();
+        heating_[k] = thermal_model_->getHeatingCoefficient();
+        cooling_[k] = thermal_model_->getCoolingCoefficient();
+        temperature_[k] = thermal_model_->getCurrentTemperature();
+        peak_temperature_[k] = thermal_model_->getPeakTemperature();
+        lane.scheduler->setThermalHeadroom(lane.thermal_governor.getHeadroom(temperature_[k]));
+    }
+}
+
+void BatchSimulationEngine::scheduleLane(Lane& lane, size_t index, int time) {
+    if (time >= lane.max_time) {
+        finishLane(lane, index, time);
+        return;
+    }
+    releaseTasks(lane, time);
+    
+    Task* task = dispatchTask(lane, time);
+    if (lane.scheduler->getContextSwitches() != lane.observed_switches) {
+        lane.observed_switches = lane.scheduler->getContextSwitches();
+        if (task != nullptr) {
+            lane.switch_stall = switch_cost_.stallTicks(task->getExecutionType());
+            energy_[index] += switch_cost_.energy_joules;
+            lane.switch_energy += switch_cost_.energy_joules;
+            lane.attribution.charge(*task, switch_cost_.energy_joules);
+        }
+    }
+    lane.requested_frequency = lane.scheduler->getCurrentFrequency();
+    lane.frequency = lane.thermal_governor.limitFrequency(lane.requested_frequency);
+    lane.current_task = task;
+    
+    if (task == nullptr) {
+        int next_event = nextEventTime(lane, time);
+        if (next_event <= time) {
+            finishLane(lane, index, time);
+            return;
+        }
+        const CState& state = lane.idle_governor.idleTick(*energy_model_, lane.scheduler->getPowerPolicy(),
+                                                          next_event - time);
+        dynamic_power_[index] = state.power_watts;
+        leakage_scale_[index] = leakageScale(lane, lane.frequency) * state.leakage_fraction;
+        lane.mode = LaneMode::IDLE;
+        return;
+    }
+    
+    if (lane.idle_governor.isIdle()) {
+        double transition_energy = lane.idle_governor.wake(*energy_model_);
+        energy_[index] += transition_energy;
+        lane.idle_energy += transition_energy;
+    }
+    leakage_scale_[index] = leakageScale(lane, lane.frequency);
+    if (lane.idle_governor.isWaking()) {
+        // Exit latency: the task is dispatched but cannot run yet
+        dynamic_power_[index] = energy_model_->getCStates()[0].power_watts;
+        lane.mode = LaneMode::WAKING;
+    } else if (lane.switch_stall > 0) {
+        dynamic_power_[index] = dynamicPower(lane, task->getExecutionType(), lane.frequency);
+        lane.switch_stall--;
+        lane.mode = LaneMode::SWITCHING;
+    } else {
+        task->execute(1, lane.frequency / kReferenceFrequencyGHz);
+        dynamic_power_[index] = dynamicPower(lane, task->getExecutionType(), lane.frequency);
+        lane.mode = LaneMode::BUSY;
+    }
+}
+
+void BatchSimulationEngine::finishLane(Lane& lane, size_t index, int time) {
+    lane.mode = LaneMode::FINISHED;
+    lane.end_time = time;
+    dynamic_power_[index] = 0.0;
+    leakage_scale_[index] = 0.0;
+}
+
+void BatchSimulationEngine::releaseTasks(Lane& lane, int time) {
+    while (lane.next_arrival < lane.pending_arrivals.size() &&
+           lane.pending_arrivals[lane.next_arrival].getArrivalTime() <= time) {
+        lane.attribution.admit(lane.pending_arrivals[lane.next_arrival]);
+        lane.scheduler->addTask(lane.pending_arrivals[lane.next_arrival]);
+        lane.next_arrival++;
+    }
+    woken_tasks_.clear();
+    lane.wait_queue.release(time, woken_tasks_);
+    for (Task& task : woken_tasks_) {
+        task.completeBlockingPhase();
+        if (task.isCompleted()) {
+            completeTask(lane, task, time);
+        } else {
+            lane.scheduler->addTask(task);
+        }
+    }
+}
+
+Task* BatchSimulationEngine::dispatchTask(Lane& lane, int time) {
+    Task* task = lane.scheduler->getNextTask();
+    while (task != nullptr && task->isBlocked()) {
+        lane.wait_queue.block(*task, time, task->getBlockingTicks());
+        lane.scheduler->taskBlocked(task->getId());
+        task = lane.scheduler->getNextTask();
+    }
+    return task;
+}
+
+void BatchSimulationEngine::completeTask(Lane& lane, const Task& task, int end_time) {
+    Task completed = task;
+    completed.setEndTime(end_time);
+    lane.scheduler->taskCompleted(completed.getId());
+    lane.completed_tasks.push_back(completed);
+    lane.latency.record(completed);
+    lane.last_completion_time = end_time;
+}
+
+int BatchSimulationEngine::nextEventTime(const Lane& lane, int time) const {
+    if (!lane.wait_queue.empty()) {
+        int wake_time = lane.wait_queue.nextWakeTime();
+        if (lane.next_arrival < lane.pending_arrivals.size()) {
+            wake_time = std::min(wake_time, lane.pending_arrivals[lane.next_arrival].getArrivalTime());
+        }
+        return std::min(lane.max_time, wake_time);
+    }
+    if (lane.next_arrival < lane.pending_arrivals.size()) {
+        return std::min(lane.max_time, lane.pending_arrivals[lane.next_arrival].getArrivalTime());
+    }
+    if (lane.scheduler->hasTasks()) {
+        return time + 1;
+    }
+    switch (end_condition_) {
+        case EndCondition::LAST_COMPLETION:
+            return time;
+        case EndCondition::HORIZON:
+            return lane.max_time;
+        case EndCondition::DRAIN:
+        default:
+            return std::min(lane.max_time, lane.last_completion_time + cooldown_ticks_);
+    }
+}
+
+double BatchSimulationEngine::leakageScale(Lane& lane, double frequency) {
+    if (frequency != lane.cached_frequency) {
+        lane.cached_frequency = frequency;
+        lane.cached_leakage_scale = energy_model_->getLeakageScale(energy_model_->getVoltageForFrequency(frequency));
+        lane.cached_dynamic_power = -1.0;
+    }
+    return lane.cached_leakage_scale;
+}
+
+double BatchSimulationEngine::dynamicPower(Lane& lane, TaskType type, double frequency) {
+    // leakageScale() has already refreshed the cache for this frequency
+    if (lane.cached_dynamic_power < 0.0 || type != lane.cached_type) {
+        lane.cached_type = type;
+        lane.cached_dynamic_power = energy_model_->calculatePower(type, frequency);
+    }
+    return lane.cached_dynamic_power;
+}
+
+SimulationStats BatchSimulationEngine::collectStats(const Lane& lane, size_t index) const {
+    SimulationStats stats;
+    stats.total_tasks = lane.completed_tasks.size();
+    stats.total_execution_time = lane.end_time;
+    stats.total_energy_joules = energy_[index];
+    stats.average_power_watts = (lane.end_time > 0) ? energy_[index] / (lane.end_time / 1000.0) : 0.0;
+    stats.peak_temperature_celsius = peak_temperature_[index];
+    stats.throttled_time_ticks = lane.thermal_governor.getThrottledTime();
+    stats.throttle_events = lane.thermal_governor.getThrottleEvents();
+    stats.throughput_loss_percent = lane.thermal_governor.getThroughputLossPercent();
+    stats.power_capped_ticks = 0;
+    stats.power_cap_loss_percent = 0.0;
+    stats.contended_ticks = 0;
+    stats.contention_loss_percent = 0.0;
+    stats.leakage_energy_joules = lane.leakage_energy;
+    stats.idle_energy_joules = lane.idle_energy;
+    stats.wakeups = lane.idle_governor.getWakeups();
+    stats.context_switches = lane.scheduler->getContextSwitches();
+    stats.preemptions = lane.scheduler->getPreemptions();
+    stats.switch_overhead_ticks = lane.switch_overhead_ticks;
+    stats.switch_energy_joules = lane.switch_energy;
+    stats.cancelled = false;
+    const std::vector<int>& residency = lane.idle_governor.getResidency();
+    for (size_t i = 0; i < residency.size(); ++i) {
+        stats.cstate_residency.emplace_back(energy_model_->getCStates()[i].name, residency[i]);
+    }
+    stats.latency = lane.latency;
+    stats.scheduler_name = lane.scheduler->getName();
+    stats.completed_tasks = lane.completed_tasks;
+    lane.attribution.attribute(lane.idle_energy, stats.completed_tasks, stats.task_energy, stats.energy_by_type);
+    return stats;
+}
@@ -0,0 +1,115 @@
+#ifndef BATCH_SIMULATION_ENGINE_H
+#define BATCH_SIMULATION_ENGINE_H
+
+#include "core/SimulationEngine.h"
+#include "models/EnergyModel.h"
+#include "models/ThermalModel.h"
+#include "core/ThermalGovernor.h"
+#include "core/IdleGovernor.h"
+#include "core/WaitQueue.h"
+#include "scheduler/Scheduler.h"
+#include "tasks/Task.h"
+#include <vector>
+#include <memory>
+
+// Advances many independent single-core simulations in lockstep, one lane per
+// simulation. Scheduling stays scalar per lane; power, energy and the lumped
+// thermal model are kept in lane-wise arrays and updated by SIMD kernels.
+// Idle gaps are stepped tick by tick rather than fast-forwarded, so results
+// agree with SimulationEngine up to the leakage evaluated within those gaps.
+class BatchSimulationEngine {
+public:
+    BatchSimulationEngine();
+    
+    // Add a simulation; returns its lane index
+    int addLane(std::unique_ptr<Scheduler> scheduler, const std::vector<Task>& tasks, int max_time = 50000);
+    int getLaneCount() const { return static_cast<int>(lanes_.size()); }
+    
+    // Shared model parameters, applied to every lane (only the lumped thermal
+    // model can be batched)
+    void setEnergyModel(std::unique_ptr<EnergyModel> energy_model);
+    void setThermalModel(std::unique_ptr<ThermalModel> thermal_model);
+    void setThermalGovernor(const ThermalGovernor& governor);
+    void setEndCondition(EndCondition condition, int cooldown_ticks = 1000);
+    void setIODevice(int channels, int latency_ticks);
+    void setContextSwitchCost(const ContextSwitchCost& cost) { switch_cost_ = cost; }
+    
+    // Run every lane to completion; results are in lane order
+    std::vector<SimulationStats> run();
+    
+    // Instruction set used by the lane kernels
+    static const char* getInstructionSet();
+
+private:
+    enum class LaneMode { IDLE, WAKING, SWITCHING, BUSY, FINISHED };
+    
+    struct Lane {
+        std::unique_ptr<Scheduler> scheduler;
+        std::vector<Task> pending_arrivals;  // Sorted by arrival time
+        size_t next_arrival;
+        WaitQueue wait_queue;
+        int max_time;
+        int end_time;
+        int last_completion_time;
+        ThermalGovernor thermal_governor;
+        IdleGovernor idle_governor;
+        std::vector<Task> completed_tasks;
+        LatencyStats latency;
+        EnergyAttribution attribution;
+        double leakage_energy;
+        double idle_energy;
+        int observed_switches;
+        int switch_stall;
+        int switch_overhead_ticks;
+        double switch_energy;
+        
+        // Per-tick decisions
+        LaneMode mode;
+        Task* current_task;
+        double requested_frequency;
+        double frequency;
+        
+        // Power terms cached for the last frequency / task type
+        double cached_frequency;
+        double cached_leakage_scale;
+        TaskType cached_type;
+        double cached_dynamic_power;
+    };
+    
+    std::unique_ptr<EnergyModel> energy_model_;
+    std::unique_ptr<ThermalModel> thermal_model_;
+    ThermalGovernor governor_template_;
+    EndCondition end_condition_;
+    int cooldown_ticks_;
+    int io_channels_;
+    int io_latency_ticks_;
+    ContextSwitchCost switch_cost_;
+    
+    std::vector<Lane> lanes_;
+    std::vector<Task> woken_tasks_;
+    
+    // Lane-wise arrays, padded to SimdKernels::paddedSize(lanes)
+    std::vector<double> dynamic_power_;
+    std::vector<double> leakage_scale_;
+    std::vector<double> ambient_;
+    std::vector<double> heating_;
+    std::vector<double> cooling_;
+    std::vector<double> temperature_;
+    std::vector<double> peak_temperature_;
+    std::vector<double> energy_;
+    std::vector<double> power_;
+    std::vector<double> leakage_power_;
+    
+    void initializeArrays();
+    void scheduleLane(Lane& lane, size_t index, int time);
+    void finishLane(Lane& lane, size_t index, int time);
+    void releaseTasks(Lane& lane, int time);
+    Task* dispatchTask(Lane& lane, int time);
+    void completeTask(Lane& lane, const Task& task, int end_time);
+    int nextEventTime(const Lane& lane, int time) const;
+    double leakageScale(Lane& lane, double frequency);
+    double dynamicPower(Lane& lane, TaskType type, double frequency);
+    SimulationStats collectStats(const Lane& lane, size_t index) const;
+};
+
+#endif // BATCH_SIMULATION_ENGINE_H
@@ -0,0 +1,73 @@
+#include "EnergyAttribution.h"
+#include "Serialization.h"
+
+namespace {
+
+const int kTaskTypes = 3;
+
+} // namespace
+
+void EnergyAttribution::reset() {
+    active_.clear();
+    peak_.clear();
+    types_.clear();
+}
+
+void EnergyAttribution::admit(Task& task) {
+    task.setSlot(static_cast<int>(active_.size()));
+    active_.push_back(0.0);
+    peak_.push_back(0.0);
+    types_.push_back(task.getType());
+}
+
+void EnergyAttribution::attribute(double idle_energy, const std::vector<Task>& completed,
+                                  std::vector<TaskEnergy>& per_task, std::vector<TypeEnergy>& by_type) const {
+    double active_total = 0.0;
+    for (double joules : active_) {
+        active_total += joules;
+    }
+    double idle_per_joule = (active_total > 0.0) ? idle_energy / active_total : 0.0;
+    
+    by_type.assign(kTaskTypes, TypeEnergy{0, 0, 0.0, 0.0, 0.0});
+    per_task.clear();
+    per_task.reserve(completed.size());
+    for (const Task& task : completed) {
+        by_type[static_cast<int>(task.getType())].tasks_completed++;
+        int slot = task.getSlot();
+        if (slot >= 0 && slot < static_cast<int>(active_.size())) {
+            per_task.push_back({active_[slot], active_[slot] * idle_per_joule, peak_[slot]});
+        } else {
+            per_task.push_back({0.0, 0.0, 0.0});
+        }
+    }
+    
+    for (size_t slot = 0; slot < active_.size(); ++slot) {
+        if (active_[slot] <= 0.0) {
+            continue;  // Arrived but never ran
+        }
+        TypeEnergy& type = by_type[static_cast<int>(types_[slot])];
+        type.tasks_run++;
+        type.active_energy_joules += active_[slot];
+        type.idle_energy_joules += active_[slot] * idle_per_joule;
+        type.peak_temperature_celsius = std::max(type.peak_temperature_celsius, peak_[slot]);
+    }
+}
+
+void EnergyAttribution::saveState(BinaryWriter& writer) const {
+    writer.writeUInt(active_.size());
+    for (size_t slot = 0; slot < active_.size(); ++slot) {
+        writer.writeDouble(active_[slot]);
+        writer.writeDouble(peak_[slot]);
+        writer.writeUInt(static_cast<uint64_t>(types_[slot]));
+    }
+}
+
+void EnergyAttribution::loadState(BinaryReader& reader) {
+    size_t count = reader.readUInt();
+    reset();
+    for (size_t slot = 0; slot < count; ++slot) {
+        active_.push_back(reader.readDouble());
+        peak_.push_back(reader.readDouble());
+        types_.push_back(static_cast<TaskType>(reader.readUInt()));
+    }
+}
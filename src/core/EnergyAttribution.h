@@ -0,0 +1,64 @@
+#ifndef ENERGY_ATTRIBUTION_H
+#define ENERGY_ATTRIBUTION_H
+
+#include "tasks/Task.h"
+#include <algorithm>
+#include <vector>
+
+class BinaryWriter;
+class BinaryReader;
+
+// Energy attributed to one completed task
+struct TaskEnergy {
+    double active_energy_joules;      // Drawn while it held the CPU
+    double idle_energy_joules;        // Share of idle energy
+    double peak_temperature_celsius;  // Hottest while it ran
+    
+    double getEnergy() const { return active_energy_joules + idle_energy_joules; }
+};
+
+// Energy of one task type, over every task of the type that ran
+struct TypeEnergy {
+    int tasks_run;                    // Including tasks that had not finished
+    int tasks_completed;
+    double active_energy_joules;
+    double idle_energy_joules;        // Share of idle energy
+    double peak_temperature_celsius;
+    
+    double getEnergy() const { return active_energy_joules + idle_energy_joules; }
+};
+
+// Splits a run's energy among its tasks. Each task gets a dense slot when it
+// arrives, so charging a tick is an array update rather than a lookup by id.
+// Energy drawn while a task holds the CPU (dynamic power, leakage and its
+// context-switch overhead) is charged to it; idle energy is shared out at the
+// end in proportion to the active energy, so the attributions add up to the
+// run's total.
+class EnergyAttribution {
+public:
+    void reset();
+    
+    // Called once per task, when it arrives
+    void admit(Task& task);
+    
+    void charge(const Task& task, double joules) { active_[task.getSlot()] += joules; }
+    void heat(const Task& task, double temperature) {
+        peak_[task.getSlot()] = std::max(peak_[task.getSlot()], temperature);
+    }
+    
+    // Energy of each completed task, in the same order, and of every task
+    // that ran by type (indexed by TaskType)
+    void attribute(double idle_energy, const std::vector<Task>& completed, std::vector<TaskEnergy>& per_task,
+                   std::vector<TypeEnergy>& by_type) const;
+    
+    // Snapshot support
+    void saveState(BinaryWriter& writer) const;
+    void loadState(BinaryReader& reader);
+    
+private:
+    std::vector<double> active_;      // By slot
+    std::vector<double> peak_;
+    std::vector<TaskType> types_;
+};
+
+#endif // ENERGY_ATTRIBUTION_H
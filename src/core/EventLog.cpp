@@ -0,0 +1,206 @@
+#include "EventLog.h"
+#include "Serialization.h"
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+const char kMagic[4] = {'P', 'P', 'E', 'V'};
+const uint64_t kFormatVersion = 1;
+const int kEventTypes = 6;
+// Longest an encoded event can be: five varints of at most 10 bytes each
+const uint64_t kMaxEventBytes = 50;
+
+uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+uint8_t* putVarint(uint8_t* out, uint64_t value) {
+    while (value >= 0x80) {
+        *out++ = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = static_cast<uint8_t>(value);
+    return out;
+}
+
+// Varint straight from the stream; false on a clean end of file
+bool readVarint(std::istream& in, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int byte = in.get();
+        if (byte == EOF) {
+            if (shift == 0) {
+                return false;
+            }
+            throw std::runtime_error("truncated event log");
+        }
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    throw std::runtime_error("corrupt event log");
+}
+
+} // namespace
+
+const char* getEventTypeName(EventType type) {
+    switch (type) {
+        case EventType::DISPATCH: return "dispatch";
+        case EventType::PREEMPT: return "preempt";
+        case EventType::COMPLETE: return "complete";
+        case EventType::BLOCK: return "block";
+        case EventType::FREQUENCY: return "frequency";
+        case EventType::THROTTLE: return "throttle";
+    }
+    return "unknown";
+}
+
+EventLogWriter::EventLogWriter(const std::string& filename, size_t ring_capacity)
+    : filename_(filename), file_(filename, std::ios::binary | std::ios::trunc), ring_(ring_capacity),
+      payload_(kBlockEvents * kMaxEventBytes), closing_(false), recorded_(0), stalls_(0), closed_(false) {
+    if (!file_.is_open()) {
+        throw std::runtime_error("cannot write event log to " + filename);
+    }
+    BinaryWriter header;
+    header.writeUInt(kFormatVersion);
+    file_.write(kMagic, sizeof(kMagic));
+    file_.write(reinterpret_cast<const char*>(header.getBuffer().data()), header.getBuffer().size());
+    thread_ = std::thread([this] { run(); });
+}
+
+EventLogWriter::~EventLogWriter() {
+    close();
+}
+
+void EventLogWriter::close() {
+    if (closed_) {
+        return;
+    }
+    closed_ = true;
+    closing_.store(true, std::memory_order_release);
+    thread_.join();
+    file_.close();
+}
+
+void EventLogWriter::run() {
+    std::vector<SchedulingEvent> block(kBlockEvents);
+    size_t filled = 0;
+    while (true) {
+        // Read the flag first: whatever was pushed before it was set is
+        // visible to the pop that follows
+        bool closing = closing_.load(std::memory_order_acquire);
+        size_t popped = ring_.popBatch(block.data() + filled, kBlockEvents - filled);
+        filled += popped;
+        if (filled == kBlockEvents) {
+            writeBlock(block);
+            filled = 0;
+            continue;
+        }
+        if (popped == 0) {
+            if (closing) {
+                break;
+            }
+            // Polling more often costs the simulation more in wake-ups than
+            // the ring saves; it holds well over a millisecond of events
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    if (filled > 0) {
+        block.resize(filled);
+        writeBlock(block);
+    }
+    file_.flush();
+}
+
+void EventLogWriter::writeBlock(const std::vector<SchedulingEvent>& events) {
+    // Same varints as BinaryWriter, encoded in place: this loop bounds how
+    // fast the writer keeps up with the simulation
+    uint8_t* out = payload_.data();
+    int64_t last_time = 0;
+    int64_t last_task = 0;
+    int64_t last_value[kEventTypes] = {};
+    for (const SchedulingEvent& event : events) {
+        int type = static_cast<int>(event.type);
+        *out++ = static_cast<uint8_t>(type);
+        out = putVarint(out, zigzag(event.time - last_time));
+        out = putVarint(out, zigzag(event.core));
+        out = putVarint(out, zigzag(event.task - last_task));
+        out = putVarint(out, zigzag(event.value - last_value[type]));
+        last_time = event.time;
+        last_task = event.task;
+        last_value[type] = event.value;
+    }
+    size_t size = out - payload_.data();
+    
+    uint8_t header[20];
+    uint8_t* header_end = putVarint(putVarint(header, events.size()), size);
+    file_.write(reinterpret_cast<const char*>(header), header_end - header);
+    file_.write(reinterpret_cast<const char*>(payload_.data()), size);
+}
+
+EventLogReader::EventLogReader(const std::string& filename)
+    : file_(filename, std::ios::binary), position_(0) {
+    if (!file_.is_open()) {
+        throw std::runtime_error("cannot open event log " + filename);
+    }
+    char magic[sizeof(kMagic)];
+    uint64_t version = 0;
+    if (!file_.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error(filename + " is not an event log");
+    }
+    if (!readVarint(file_, version) || version != kFormatVersion) {
+        throw std::runtime_error(filename + ": unsupported event log version");
+    }
+}
+
+bool EventLogReader::next(SchedulingEvent& event) {
+    while (position_ == block_.size()) {
+        if (!readBlock()) {
+            return false;
+        }
+    }
+    event = block_[position_++];
+    return true;
+}
+
+bool EventLogReader::readBlock() {
+    uint64_t count = 0;
+    uint64_t size = 0;
+    if (!readVarint(file_, count)) {
+        return false;
+    }
+    if (count > EventLogWriter::kBlockEvents || !readVarint(file_, size) || size > count * kMaxEventBytes) {
+        throw std::runtime_error("corrupt event log");
+    }
+    std::vector<uint8_t> payload(size);
+    if (!file_.read(reinterpret_cast<char*>(payload.data()), size)) {
+        throw std::runtime_error("truncated event log");
+    }
+    
+    BinaryReader reader(payload);
+    int64_t last_time = 0;
+    int64_t last_task = 0;
+    int64_t last_value[kEventTypes] = {};
+    block_.clear();
+    position_ = 0;
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t type = reader.readUInt();
+        if (type >= static_cast<uint64_t>(kEventTypes)) {
+            throw std::runtime_error("corrupt event log");
+        }
+        SchedulingEvent event;
+        event.type = static_cast<EventType>(type);
+        event.time = static_cast<int32_t>(last_time += reader.readInt());
+        event.core = static_cast<int16_t>(reader.readInt());
+        event.task = static_cast<int32_t>(last_task += reader.readInt());
+        event.value = static_cast<int32_t>(last_value[type] += reader.readInt());
+        block_.push_back(event);
+    }
+    if (!reader.atEnd()) {
+        throw std::runtime_error("corrupt event log");
+    }
+    return true;
+}
@@ -0,0 +1,101 @@
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include "core/SpscRing.h"
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Scheduling decisions and their consequences, as recorded by the engines
+enum class EventType : uint8_t {
+    DISPATCH = 0,    // value: frequency the task starts at (MHz)
+    PREEMPT = 1,     // The task left the CPU while still runnable
+    COMPLETE = 2,
+    BLOCK = 3,       // value: ticks of the I/O phase it waits for
+    FREQUENCY = 4,   // value: frequency applied from now on (MHz)
+    THROTTLE = 5     // value: 1 when throttling starts, 0 when it ends; core -1
+};
+
+struct SchedulingEvent {
+    int32_t time;
+    int32_t task;    // -1 when the event concerns no task
+    int32_t value;
+    int16_t core;    // 0 on a single-core run; -1 for the package or off-CPU
+    EventType type;
+};
+
+// Writes events to a binary log on a background thread. The simulation thread
+// only copies each event into a lock-free single-producer ring; the writer
+// drains it into blocks of up to kBlockEvents events, each encoded with
+// zigzag varints as deltas from the previous event of the block (time, task)
+// or of the same type (value), so that a block decodes on its own. A full
+// ring makes the producer wait rather than drop events.
+//
+// File layout: "PPEV", format version, then blocks of (event count, payload
+// size, payload), all varints.
+class EventLogWriter {
+public:
+    static const size_t kBlockEvents = 4096;
+    
+    // Throws std::runtime_error when the file cannot be created
+    explicit EventLogWriter(const std::string& filename, size_t ring_capacity = 1 << 14);
+    ~EventLogWriter();
+    
+    EventLogWriter(const EventLogWriter&) = delete;
+    EventLogWriter& operator=(const EventLogWriter&) = delete;
+    
+    void record(EventType type, int time, int core, int task, int value) {
+        SchedulingEvent event = {time, task, value, static_cast<int16_t>(core), type};
+        while (!ring_.tryPush(event)) {
+            stalls_++;
+            std::this_thread::yield();
+        }
+        recorded_++;
+    }
+    
+    // Write out everything recorded and stop the writer; idempotent
+    void close();
+    
+    uint64_t getEventCount() const { return recorded_; }
+    // Times the producer found the ring full
+    uint64_t getStalls() const { return stalls_; }
+    const std::string& getFilename() const { return filename_; }
+    
+private:
+    std::string filename_;
+    std::ofstream file_;
+    SpscRing<SchedulingEvent> ring_;
+    std::vector<uint8_t> payload_;  // Writer thread
+    std::atomic<bool> closing_;
+    uint64_t recorded_;   // Producer side
+    uint64_t stalls_;
+    bool closed_;
+    std::thread thread_;  // Started once the rest is initialized
+    
+    void run();
+    void writeBlock(const std::vector<SchedulingEvent>& events);
+};
+
+// Sequential reader of an event log; throws std::runtime_error on a file that
+// is not an event log or is corrupt
+class EventLogReader {
+public:
+    explicit EventLogReader(const std::string& filename);
+    
+    // False at the end of the log
+    bool next(SchedulingEvent& event);
+    
+private:
+    std::ifstream file_;
+    std::vector<SchedulingEvent> block_;
+    size_t position_;
+    
+    bool readBlock();
+};
+
+const char* getEventTypeName(EventType type);
+
+#endif // EVENT_LOG_H
@@ -0,0 +1,127 @@
+#include "IdleGovernor.h"
+#include "Serialization.h"
+#include <algorithm>
+
+IdleGovernor::IdleGovernor() {
+    reset();
+}
+
+double IdleGovernor::idleEnergy(const EnergyModel& model, double leakage_power, PowerPolicy policy,
+                                int ticks, int expected_idle) {
+    const std::vector<CState>& states = model.getCStates();
+    enterIdle(model, policy, expected_idle);
+    
+    // Until the entry latency has elapsed the core still sits in the shallowest state
+    const CState& shallow = states[0];
+    const CState& target = states[state_];
+    int shallow_ticks = std::min(ticks, std::max(0, target.entry_latency - idle_ticks_));
+    double shallow_power = shallow.power_watts + leakage_power * shallow.leakage_fraction;
+    double target_power = target.power_watts + leakage_power * target.leakage_fraction;
+    
+    idle_ticks_ += ticks;
+    residency_[state_] += ticks;
+    return (shallow_ticks * shallow_power + (ticks - shallow_ticks) * target_power) / 1000.0;
+}
+
+const CState& IdleGovernor::idleTick(const EnergyModel& model, PowerPolicy policy, int expected_idle) {
+    const std::vector<CState>& states = model.getCStates();
+    enterIdle(model, policy, expected_idle);
+    bool entering = idle_ticks_ < states[state_].entry_latency;
+    idle_ticks_++;
+    residency_[state_]++;
+    return entering ? states[0] : states[state_];
+}
+
+double IdleGovernor::wakeupPower(const EnergyModel& model, double leakage_power) const {
+    // Powered but not yet able to run
+    return model.getCStates()[0].power_watts + leakage_power;
+}
+
+void IdleGovernor::park(const EnergyModel& model) {
+    int deepest = static_cast<int>(model.getCStates().size()) - 1;
+    if (state_ < 0) {
+        enterIdle(model, PowerPolicy::RACE_TO_IDLE, -1);
+    } else if (state_ != deepest) {
+        state_ = deepest;
+        idle_ticks_ = 0;
+    }
+}
+
+double IdleGovernor::wake(const EnergyModel& model) {
+    if (state_ < 0) {
+        return 0.0;
+    }
+    const CState& state = model.getCStates()[state_];
+    predicted_idle_ = 0.5 * predicted_idle_ + 0.5 * idle_ticks_;
+    wakeup_remaining_ = state.exit_latency;
+    wakeups_++;
+    state_ = -1;
+    idle_ticks_ = 0;
+    return state.transition_energy_joules;
+}
+
+void IdleGovernor::finishWakeupTick() {
+    if (wakeup_remaining_ > 0) {
+        wakeup_remaining_--;
+    }
+}
+
+void IdleGovernor::reset() {
+    state_ = -1;
+    idle_ticks_ = 0;
+    wakeup_remaining_ = 0;
+    predicted_idle_ = 0.0;
+    wakeups_ = 0;
+    residency_.clear();
+}
+
+void IdleGovernor::saveState(BinaryWriter& writer) const {
+    writer.writeInt(state_);
+    writer.writeInt(idle_ticks_);
+    writer.writeInt(wakeup_remaining_);
+    writer.writeDouble(predicted_idle_);
+    writer.writeInt(wakeups_);
+    writer.writeUInt(residency_.size());
+    for (int ticks : residency_) {
+        writer.writeInt(ticks);
+    }
+}
+
+void IdleGovernor::loadState(BinaryReader& reader) {
+    state_ = static_cast<int>(reader.readInt());
+    idle_ticks_ = static_cast<int>(reader.readInt());
+    wakeup_remaining_ = static_cast<int>(reader.readInt());
+    predicted_idle_ = reader.readDouble();
+    wakeups_ = static_cast<int>(reader.readInt());
+    residency_.resize(reader.readUInt());
+    for (int& ticks : residency_) {
+        ticks = static_cast<int>(reader.readInt());
+    }
+}
+
+void IdleGovernor::enterIdle(const EnergyModel& model, PowerPolicy policy, int expected_idle) {
+    if (state_ >= 0) {
+        return;
+    }
+    const std::vector<CState>& states = model.getCStates();
+    state_ = selectState(model, policy, (expected_idle >= 0) ? expected_idle : predicted_idle_);
+    idle_ticks_ = 0;
+    if (residency_.size() < states.size()) {
+        residency_.resize(states.size(), 0);
+    }
+}
+
+int IdleGovernor::selectState(const EnergyModel& model, PowerPolicy policy, double expected_idle) const {
+    const std::vector<CState>& states = model.getCStates();
+    if (policy == PowerPolicy::RACE_TO_IDLE) {
+        return static_cast<int>(states.size()) - 1;
+    }
+    // Deepest state whose target residency the expected idle period covers
+    int selected = 0;
+    for (size_t i = 1; i < states.size(); ++i) {
+        if (states[i].target_residency <= expected_idle) {
+            selected = static_cast<int>(i);
+        }
+    }
+    return selected;
+}
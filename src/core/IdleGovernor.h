@@ -0,0 +1,59 @@
+#ifndef IDLE_GOVERNOR_H
+#define IDLE_GOVERNOR_H
+
+#include "models/EnergyModel.h"
+#include "scheduler/Scheduler.h"
+#include <vector>
+
+// Picks a C-state whenever the CPU goes idle and tracks residency, wake-ups
+// and the exit latency that delays the next task
+class IdleGovernor {
+public:
+    IdleGovernor();
+    
+    // Energy (J) of an idle segment of the given length; the first segment after
+    // activity selects the C-state, using expected_idle (ticks) when it is known
+    double idleEnergy(const EnergyModel& model, double leakage_power, PowerPolicy policy,
+                      int ticks, int expected_idle = -1);
+    
+    // Per-tick variant for lockstep engines: accounts one idle tick and returns
+    // the state in effect during it
+    const CState& idleTick(const EnergyModel& model, PowerPolicy policy, int expected_idle = -1);
+    
+    // Power drawn while waking up (W)
+    double wakeupPower(const EnergyModel& model, double leakage_power) const;
+    
+    // Parked by the scheduler: go to the deepest C-state now, whatever the
+    // predicted idle period (entry latency counts from the switch)
+    void park(const EnergyModel& model);
+    
+    // Work became runnable: leave the C-state, returns the transition energy (J)
+    double wake(const EnergyModel& model);
+    
+    // Exit latency still pending; finishWakeupTick() consumes one tick of it
+    bool isWaking() const { return wakeup_remaining_ > 0; }
+    void finishWakeupTick();
+    
+    bool isIdle() const { return state_ >= 0; }
+    int getWakeups() const { return wakeups_; }
+    const std::vector<int>& getResidency() const { return residency_; }
+    
+    // Snapshot support
+    void saveState(BinaryWriter& writer) const;
+    void loadState(BinaryReader& reader);
+    
+    void reset();
+    
+private:
+    int state_;              // Index of the current C-state, -1 while active
+    int idle_ticks_;         // Ticks spent in the current idle period
+    int wakeup_remaining_;   // Exit latency ticks left before work can run
+    double predicted_idle_;  // Moving average of recent idle period lengths
+    int wakeups_;
+    std::vector<int> residency_;
+    
+    int selectState(const EnergyModel& model, PowerPolicy policy, double expected_idle) const;
+    void enterIdle(const EnergyModel& model, PowerPolicy policy, int expected_idle);
+};
+
+#endif // IDLE_GOVERNOR_H
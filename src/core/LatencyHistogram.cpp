@@ -0,0 +1,120 @@
+#include "LatencyHistogram.h"
+#include "Serialization.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+const int kSubBucketBits = 7;
+const int64_t kExactLimit = int64_t(1) << kSubBucketBits;           // Values stored exactly
+const int64_t kHalfSubBuckets = kExactLimit / 2;                     // Buckets per power of two above it
+}
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+void LatencyHistogram::record(int64_t value, uint64_t count) {
+    value = std::max<int64_t>(value, 0);
+    size_t bucket = bucketFor(value);
+    if (bucket >= counts_.size()) {
+        counts_.resize(bucket + 1, 0);
+    }
+    counts_[bucket] += count;
+    if (count_ == 0 || value < min_) {
+        min_ = value;
+    }
+    max_ = std::max(max_, value);
+    count_ += count;
+    sum_ += static_cast<double>(value) * count;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    if (other.count_ == 0) {
+        return;
+    }
+    if (other.counts_.size() > counts_.size()) {
+        counts_.resize(other.counts_.size(), 0);
+    }
+    for (size_t i = 0; i < other.counts_.size(); ++i) {
+        counts_[i] += other.counts_[i];
+    }
+    min_ = (count_ == 0) ? other.min_ : std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    count_ += other.count_;
+    sum_ += other.sum_;
+}
+
+int64_t LatencyHistogram::percentile(double p) const {
+    if (count_ == 0) {
+        return 0;
+    }
+    uint64_t rank = static_cast<uint64_t>(std::ceil(std::min(std::max(p, 0.0), 1.0) * count_));
+    rank = std::max<uint64_t>(rank, 1);
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < counts_.size(); ++bucket) {
+        seen += counts_[bucket];
+        if (seen >= rank) {
+            return std::min(std::max(bucketUpperBound(bucket), min_), max_);
+        }
+    }
+    return max_;
+}
+
+void LatencyHistogram::save(BinaryWriter& writer) const {
+    writer.writeUInt(count_);
+    writer.writeInt(min_);
+    writer.writeInt(max_);
+    writer.writeDouble(sum_);
+    size_t occupied = std::count_if(counts_.begin(), counts_.end(), [](uint64_t c) { return c > 0; });
+    writer.writeUInt(occupied);
+    for (size_t bucket = 0; bucket < counts_.size(); ++bucket) {
+        if (counts_[bucket] > 0) {
+            writer.writeUInt(bucket);
+            writer.writeUInt(counts_[bucket]);
+        }
+    }
+}
+
+void LatencyHistogram::load(BinaryReader& reader) {
+    reset();
+    count_ = reader.readUInt();
+    min_ = reader.readInt();
+    max_ = reader.readInt();
+    sum_ = reader.readDouble();
+    size_t occupied = reader.readUInt();
+    for (size_t i = 0; i < occupied; ++i) {
+        size_t bucket = reader.readUInt();
+        if (bucket >= counts_.size()) {
+            counts_.resize(bucket + 1, 0);
+        }
+        counts_[bucket] = reader.readUInt();
+    }
+}
+
+void LatencyHistogram::reset() {
+    counts_.clear();
+    count_ = 0;
+    min_ = 0;
+    max_ = 0;
+    sum_ = 0.0;
+}
+
+size_t LatencyHistogram::bucketFor(int64_t value) {
+    if (value < kExactLimit) {
+        return static_cast<size_t>(value);
+    }
+    // Keep the top kSubBucketBits bits: shift so the value lands in [64, 128)
+    int msb = 63 - __builtin_clzll(static_cast<uint64_t>(value));
+    int shift = msb - (kSubBucketBits - 1);
+    return static_cast<size_t>(kExactLimit + (shift - 1) * kHalfSubBuckets + ((value >> shift) - kHalfSubBuckets));
+}
+
+int64_t LatencyHistogram::bucketUpperBound(size_t bucket) {
+    if (static_cast<int64_t>(bucket) < kExactLimit) {
+        return static_cast<int64_t>(bucket);
+    }
+    int64_t offset = static_cast<int64_t>(bucket) - kExactLimit;
+    int shift = static_cast<int>(offset / kHalfSubBuckets) + 1;
+    int64_t sub_bucket = offset % kHalfSubBuckets + kHalfSubBuckets;
+    return ((sub_bucket + 1) << shift) - 1;
+}
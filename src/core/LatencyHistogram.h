@@ -0,0 +1,48 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+class BinaryWriter;
+class BinaryReader;
+
+// Streaming log-linear (HDR-style) histogram of non-negative tick values.
+// Values below 128 are exact; above that each power of two is split into 64
+// buckets, bounding the relative error to 1/64. Memory is bounded by the
+// value range, not the sample count, and histograms merge by adding buckets.
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+    
+    void record(int64_t value, uint64_t count = 1);
+    void merge(const LatencyHistogram& other);
+    
+    // Smallest recorded-value bound v such that a fraction p (0..1) of the
+    // samples are <= v, within the bucket resolution
+    int64_t percentile(double p) const;
+    
+    uint64_t getCount() const { return count_; }
+    int64_t getMin() const { return count_ > 0 ? min_ : 0; }
+    int64_t getMax() const { return max_; }
+    double getMean() const { return count_ > 0 ? sum_ / count_ : 0.0; }
+    
+    // Snapshot and result-cache support; only occupied buckets are written
+    void save(BinaryWriter& writer) const;
+    void load(BinaryReader& reader);
+    
+    void reset();
+    
+private:
+    std::vector<uint64_t> counts_;   // Grown on demand up to the highest bucket used
+    uint64_t count_;
+    int64_t min_;
+    int64_t max_;
+    double sum_;
+    
+    static size_t bucketFor(int64_t value);
+    static int64_t bucketUpperBound(size_t bucket);
+};
+
+#endif // LATENCY_HISTOGRAM_H
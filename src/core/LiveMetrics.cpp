@@ -0,0 +1,12 @@
+#include "LiveMetrics.h"
+
+LiveMetrics::Sample LiveMetrics::sample() const {
+    Sample sample;
+    sample.runs = runs_.load(std::memory_order_relaxed);
+    sample.simulated_ticks = simulated_ticks_.load(std::memory_order_relaxed);
+    sample.tasks_completed = tasks_completed_.load(std::memory_order_relaxed);
+    sample.energy_joules = energy_joules_.load(std::memory_order_relaxed);
+    sample.temperature_celsius = temperature_celsius_.load(std::memory_order_relaxed);
+    sample.cancel_requested = cancel_requested_.load(std::memory_order_relaxed);
+    return sample;
+}
@@ -0,0 +1,59 @@
+#ifndef LIVE_METRICS_H
+#define LIVE_METRICS_H
+
+#include <atomic>
+#include <cstdint>
+
+// Progress of a running simulation, shared between the simulation thread and
+// observers. The engine publishes its counters with relaxed atomic stores
+// every few hundred events, so observing them costs the simulation a handful
+// of plain writes; each value read is recent, but a sample of several values
+// is not taken at a single instant. The same object carries a cooperative
+// cancellation request, which the engine honours at its next publication by
+// ending the run with the statistics gathered so far.
+class LiveMetrics {
+public:
+    struct Sample {
+        int64_t runs;             // Runs started so far
+        int64_t simulated_ticks;  // Simulated time of the current run
+        int64_t tasks_completed;
+        double energy_joules;
+        double temperature_celsius;
+        bool cancel_requested;
+    };
+    
+    LiveMetrics() : runs_(0), simulated_ticks_(0), tasks_completed_(0), energy_joules_(0.0),
+                    temperature_celsius_(0.0), cancel_requested_(false) {}
+    
+    LiveMetrics(const LiveMetrics&) = delete;
+    LiveMetrics& operator=(const LiveMetrics&) = delete;
+    
+    // Simulation thread
+    void beginRun() {
+        runs_.fetch_add(1, std::memory_order_relaxed);
+        update(0, 0, 0.0, temperature_celsius_.load(std::memory_order_relaxed));
+    }
+    void update(int64_t simulated_ticks, int64_t tasks_completed, double energy_joules, double temperature_celsius) {
+        simulated_ticks_.store(simulated_ticks, std::memory_order_relaxed);
+        tasks_completed_.store(tasks_completed, std::memory_order_relaxed);
+        energy_joules_.store(energy_joules, std::memory_order_relaxed);
+        temperature_celsius_.store(temperature_celsius, std::memory_order_relaxed);
+    }
+    bool isCancelRequested() const { return cancel_requested_.load(std::memory_order_relaxed); }
+    
+    // Any thread, and async-signal-safe: the flag is lock-free
+    void requestCancel() { cancel_requested_.store(true, std::memory_order_relaxed); }
+    void clearCancel() { cancel_requested_.store(false, std::memory_order_relaxed); }
+    
+    Sample sample() const;
+    
+private:
+    std::atomic<int64_t> runs_;
+    std::atomic<int64_t> simulated_ticks_;
+    std::atomic<int64_t> tasks_completed_;
+    std::atomic<double> energy_joules_;
+    std::atomic<double> temperature_celsius_;
+    std::atomic<bool> cancel_requested_;
+};
+
+#endif // LIVE_METRICS_H
@@ -0,0 +1,525 @@
+#include "MulticoreEngine.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+MulticoreEngine::MulticoreEngine(const Platform& platform, std::unique_ptr<PlacementScheduler> scheduler)
+    : platform_(platform), scheduler_(std::move(scheduler)), core_thermal_(nullptr),
+      end_condition_(EndCondition::DRAIN), cooldown_ticks_(1000), current_time_(0), max_time_(0), finished_(false),
+      last_completion_time_(0), next_arrival_(0), total_energy_(0.0), leakage_energy_(0.0), idle_energy_(0.0),
+      metrics_(nullptr), cancelled_(false), publish_countdown_(0), event_log_(nullptr), logged_throttled_(false) {
+    energy_model_ = std::make_unique<EnergyModel>();
+    thermal_model_ = std::make_unique<ThermalModel>();
+    thermal_governor_ = std::make_unique<ThermalGovernor>();
+    reset();
+}
+
+SimulationStats MulticoreEngine::runSimulation(const std::vector<Task>& tasks, int max_time) {
+    start(tasks, max_time);
+    runUntil(max_time);
+    return collectStats();
+}
+
+void MulticoreEngine::start(const std::vector<Task>& tasks, int max_time) {
+    reset();
+    max_time_ = max_time;
+    pending_arrivals_ = tasks;
+    std::stable_sort(pending_arrivals_.begin(), pending_arrivals_.end(),
+                     [](const Task& a, const Task& b) { return a.getArrivalTime() < b.getArrivalTime(); });
+    dependencies_.reset(graph_.get());
+    if (graph_) {
+        arrival_slot_.assign(graph_->getNodeCount(), -1);
+        for (size_t i = 0; i < pending_arrivals_.size(); ++i) {
+            if (graph_->contains(pending_arrivals_[i].getId())) {
+                arrival_slot_[pending_arrivals_[i].getId()] = static_cast<int>(i);
+            }
+        }
+    }
+    scheduler_->prepare(platform_, pending_arrivals_, graph_.get());
+    if (metrics_) {
+        metrics_->beginRun();
+    }
+}
+
+bool MulticoreEngine::runUntil(int time) {
+    int limit = std::min(time, max_time_);
+    while (!finished_ && current_time_ < limit) {
+        if (metrics_ && --publish_countdown_ <= 0 && !publishProgress()) {
+            break;
+        }
+        if (event_log_ && thermal_governor_->isThrottled() != logged_throttled_) {
+            logged_throttled_ = !logged_throttled_;
+            event_log_->record(EventType::THROTTLE, current_time_, -1, -1, logged_throttled_ ? 1 : 0);
+        }
+        releaseArrivals();
+        placeTasks();
+        
+        if (busyCoreCount() == 0) {
+            // Every core idle: jump straight to the next event in one step
+            int next_event = nextEventTime();
+            if (next_event <= current_time_) {
+                finished_ = true;
+                break;
+            }
+            advanceIdle(next_event - current_time_);
+            continue;
+        }
+        step();
+    }
+    if (current_time_ >= max_time_) {
+        finished_ = true;
+    }
+    if (metrics_) {
+        publishProgress();
+    }
+    return !finished_;
+}
+
+SimulationStats MulticoreEngine::collectStats() const {
+    SimulationStats stats;
+    stats.total_tasks = completed_tasks_.size();
+    stats.total_execution_time = current_time_;
+    stats.total_energy_joules = total_energy_;
+    stats.average_power_watts = (current_time_ > 0) ? total_energy_ / (current_time_ / 1000.0) : 0.0;
+    stats.peak_temperature_celsius = thermal_model_->getPeakTemperature();
+    stats.throttled_time_ticks = thermal_governor_->getThrottledTime();
+    stats.throttle_events = thermal_governor_->getThrottleEvents();
+    stats.throughput_loss_percent = thermal_governor_->getThroughputLossPercent();
+    stats.power_capped_ticks = power_cap_.getCappedTime();
+    stats.power_cap_loss_percent = power_cap_.getThroughputLossPercent();
+    stats.contended_ticks = memory_.getContendedTime();
+    stats.contention_loss_percent = memory_.getThroughputLossPercent();
+    stats.leakage_energy_joules = leakage_energy_;
+    stats.idle_energy_joules = idle_energy_;
+    stats.wakeups = 0;
+    stats.context_switches = scheduler_->getContextSwitches();
+    stats.preemptions = 0;
+    stats.switch_overhead_ticks = 0;
+    stats.switch_energy_joules = 0.0;
+    stats.cancelled = cancelled_;
+    
+    const std::vector<CState>& states = energy_model_->getCStates();
+    std::vector<int> residency(states.size(), 0);
+    for (size_t i = 0; i < cores_.size(); ++i) {
+        const Core& core = cores_[i];
+        stats.wakeups += core.idle_governor.getWakeups();
+        const std::vector<int>& core_residency = core.idle_governor.getResidency();
+        for (size_t state = 0; state < core_residency.size() && state < residency.size(); ++state) {
+            residency[state] += core_residency[state];
+        }
+        double average_frequency = (core.busy_ticks > 0) ? core.frequency_ticks / core.busy_ticks : 0.0;
+        stats.cores.push_back({platform_.typeOf(i).getName(), core.busy_ticks, core.tasks_dispatched,
+                               core.energy, average_frequency});
+    }
+    for (size_t state = 0; state < states.size(); ++state) {
+        stats.cstate_residency.emplace_back(states[state].name, residency[state]);
+    }
+    stats.power_curve = power_curve_;
+    stats.latency = latency_;
+    stats.scheduler_name = scheduler_->getName();
+    stats.completed_tasks = completed_tasks_;
+    // Tasks still on a core have not been charged yet
+    EnergyAttribution attribution = attribution_;
+    for (const Core& core : cores_) {
+        if (core.busy) {
+            attribution.charge(core.task, core.task_energy);
+            attribution.heat(core.task, core.task_peak);
+        }
+    }
+    attribution.attribute(idle_energy_, stats.completed_tasks, stats.task_energy, stats.energy_by_type);
+    return stats;
+}
+
+// False once cancellation has been requested, which ends the run
+bool MulticoreEngine::publishProgress() {
+    publish_countdown_ = SimulationEngine::kPublishEvents;
+    metrics_->update(current_time_, static_cast<int64_t>(completed_tasks_.size()), total_energy_,
+                     thermal_model_->getCurrentTemperature());
+    if (metrics_->isCancelRequested()) {
+        cancelled_ = true;
+        finished_ = true;
+    }
+    return !cancelled_;
+}
+
+void MulticoreEngine::releaseArrivals() {
+    while (next_arrival_ < pending_arrivals_.size() &&
+           pending_arrivals_[next_arrival_].getArrivalTime() <= current_time_) {
+        attribution_.admit(pending_arrivals_[next_arrival_]);
+        // Tasks with unfinished parents are held until the last one completes
+        if (dependencies_.isReady(pending_arrivals_[next_arrival_].getId())) {
+            scheduler_->addTask(pending_arrivals_[next_arrival_]);
+        }
+        next_arrival_++;
+    }
+    woken_tasks_.clear();
+    wait_queue_.release(current_time_, woken_tasks_);
+    for (Task& task : woken_tasks_) {
+        task.completeBlockingPhase();
+        if (task.isCompleted()) {
+            completeTask(task, current_time_, -1);
+        } else {
+            scheduler_->addTask(task);
+        }
+    }
+    // Released tasks that have not arrived yet are queued on arrival
+    for (int id : released_) {
+        int slot = arrival_slot_[id];
+        if (slot >= 0 && static_cast<size_t>(slot) < next_arrival_) {
+            scheduler_->addTask(pending_arrivals_[slot]);
+        }
+    }
+    released_.clear();
+}
+
+void MulticoreEngine::placeTasks() {
+    idle_cores_.clear();
+    for (size_t i = 0; i < cores_.size(); ++i) {
+        if (!cores_[i].busy) {
+            idle_cores_.push_back(static_cast<int>(i));
+        }
+    }
+    scheduler_->updateParking(platform_, idle_cores_, energy_model_->getCStates().back());
+    
+    // Tasks placed at an I/O phase leave at once, freeing their core for another round
+    while (scheduler_->hasTasks()) {
+        idle_cores_.clear();
+        for (size_t i = 0; i < cores_.size(); ++i) {
+            if (!cores_[i].busy && !scheduler_->isParked(static_cast<int>(i))) {
+                idle_cores_.push_back(static_cast<int>(i));
+            }
+        }
+        if (idle_cores_.empty()) {
+            return;
+        }
+        
+        placements_.clear();
+        scheduler_->setBandwidthHeadroom(memory_.isEnabled() ? memory_.getBudget() - runningDemand() : 1e9);
+        scheduler_->place(platform_, idle_cores_, placements_);
+        bool blocked = false;
+        for (Placement& placement : placements_) {
+            if (placement.task.isBlocked()) {
+                if (event_log_) {
+                    event_log_->record(EventType::BLOCK, current_time_, placement.core, placement.task.getId(),
+                                       placement.task.getBlockingTicks());
+                }
+                wait_queue_.block(placement.task, current_time_, placement.task.getBlockingTicks());
+                blocked = true;
+                continue;
+            }
+            Core& core = cores_[placement.core];
+            core.busy = true;
+            core.task = placement.task;
+            core.level = placement.level;
+            core.tasks_dispatched++;
+            core.task_energy = 0.0;
+            core.task_peak = 0.0;
+            if (event_log_) {
+                double frequency = platform_.typeOf(placement.core).getFrequency(placement.level);
+                event_log_->record(EventType::DISPATCH, current_time_, placement.core, placement.task.getId(),
+                                   static_cast<int>(std::lround(frequency * 1000.0)));
+                core.logged_level = placement.level;
+            }
+            if (core.idle_governor.isIdle()) {
+                double transition_energy = core.idle_governor.wake(*energy_model_);
+                total_energy_ += transition_energy;
+                idle_energy_ += transition_energy;
+                core.energy += transition_energy;
+            }
+        }
+        if (!blocked) {
+            return;
+        }
+    }
+}
+
+void MulticoreEngine::completeTask(const Task& task, int end_time, int core) {
+    if (event_log_) {
+        event_log_->record(EventType::COMPLETE, end_time, core, task.getId(), 0);
+    }
+    Task completed = task;
+    completed.setEndTime(end_time);
+    completed_tasks_.push_back(completed);
+    latency_.record(completed);
+    last_completion_time_ = end_time;
+    dependencies_.complete(task.getId(), released_);
+}
+
+int MulticoreEngine::busyCoreCount() const {
+    int busy = 0;
+    for (const Core& core : cores_) {
+        busy += core.busy ? 1 : 0;
+    }
+    return busy;
+}
+
+// Bandwidth the running tasks ask for at their placed levels
+double MulticoreEngine::runningDemand() const {
+    double demand = 0.0;
+    for (size_t i = 0; i < cores_.size(); ++i) {
+        const Core& core = cores_[i];
+        if (core.busy && !core.idle_governor.isWaking()) {
+            TaskType type = core.task.getExecutionType();
+            demand += memory_.getDemand(type, platform_.typeOf(i).getSpeed(type, core.level));
+        }
+    }
+    return demand;
+}
+
+int MulticoreEngine::nextEventTime() const {
+    int next_event = -1;
+    if (!wait_queue_.empty()) {
+        next_event = wait_queue_.nextWakeTime();
+    }
+    if (next_arrival_ < pending_arrivals_.size()) {
+        int arrival = pending_arrivals_[next_arrival_].getArrivalTime();
+        next_event = (next_event < 0) ? arrival : std::min(next_event, arrival);
+    }
+    if (next_event >= 0) {
+        return std::min(max_time_, next_event);
+    }
+    if (scheduler_->hasTasks()) {
+        return current_time_ + 1;
+    }
+    switch (end_condition_) {
+        case EndCondition::LAST_COMPLETION:
+            return current_time_;
+        case EndCondition::HORIZON:
+            return max_time_;
+        case EndCondition::DRAIN:
+        default:
+            return std::min(max_time_, last_completion_time_ + cooldown_ticks_);
+    }
+}
+
+void MulticoreEngine::advanceIdle(int ticks) {
+    // Every core sits out the whole gap in its C-state; leakage is evaluated at
+    // the starting temperature, as in SimulationEngine
+    double leakage_factor = energy_model_->getLeakageFactor(thermal_model_->getCurrentTemperature());
+    double energy = 0.0;
+    for (size_t i = 0; i < cores_.size(); ++i) {
+        if (scheduler_->isParked(static_cast<int>(i))) {
+            cores_[i].idle_governor.park(*energy_model_);
+        }
+        double leakage = platform_.typeOf(i).getStaticPower(0) * leakage_factor;
+        double core_energy = cores_[i].idle_governor.idleEnergy(*energy_model_, leakage, scheduler_->getPowerPolicy(),
+                                                                ticks, ticks);
+        cores_[i].energy += core_energy;
+        energy += core_energy;
+        if (core_thermal_) {
+            core_thermal_->setCorePower(static_cast<int>(i), core_energy / (ticks / 1000.0));
+        }
+    }
+    total_energy_ += energy;
+    idle_energy_ += energy;
+    power_curve_[0].ticks += ticks;
+    power_curve_[0].energy_joules += energy;
+    if (core_thermal_) {
+        core_thermal_->advance(ticks);
+    } else {
+        thermal_model_->updateTemperature(energy / (ticks / 1000.0), ticks);
+    }
+    
+    double temperature = thermal_model_->getCurrentTemperature();
+    thermal_governor_->update(temperature, 0.0, 0.0, ticks, false);
+    power_cap_.update(energy / (ticks / 1000.0), 0.0, 0.0, ticks, false);
+    scheduler_->setThermalHeadroom(thermal_governor_->getHeadroom(temperature));
+    scheduler_->advanceTicks(ticks);
+    current_time_ += ticks;
+}
+
+void MulticoreEngine::step() {
+    double leakage_factor = energy_model_->getLeakageFactor(thermal_model_->getCurrentTemperature());
+    PowerPolicy policy = scheduler_->getPowerPolicy();
+    double total_power = 0.0;
+    double requested_frequency = 0.0;
+    double thermal_frequency = 0.0;
+    double applied_frequency = 0.0;
+    
+    // Throttling and then the power cap limit each running core's frequency;
+    // it drops to the nearest level below the limit. The levels set the
+    // bandwidth demand, which is served in proportion when oversubscribed.
+    double demand = 0.0;
+    for (size_t i = 0; i < cores_.size(); ++i) {
+        Core& core = cores_[i];
+        if (!core.busy || core.idle_governor.isWaking()) {
+            continue;
+        }
+        const CoreType& type = platform_.typeOf(i);
+        double requested = type.getFrequency(core.level);
+        double thermal_limit = thermal_governor_->limitFrequency(requested);
+        int thermal_level = std::min(core.level, type.levelAtOrBelow(thermal_limit));
+        core.run_level = std::min(thermal_level, type.levelAtOrBelow(power_cap_.limitFrequency(thermal_limit)));
+        if (event_log_ && core.run_level != core.logged_level) {
+            event_log_->record(EventType::FREQUENCY, current_time_, static_cast<int>(i), core.task.getId(),
+                               static_cast<int>(std::lround(type.getFrequency(core.run_level) * 1000.0)));
+            core.logged_level = core.run_level;
+        }
+        requested_frequency += requested;
+        thermal_frequency += type.getFrequency(thermal_level);
+        if (memory_.isEnabled()) {
+            TaskType task_type = core.task.getExecutionType();
+            demand += memory_.getDemand(task_type, type.getSpeed(task_type, core.run_level));
+        }
+    }
+    double served_fraction = memory_.getServedFraction(demand);
+    double requested_work = 0.0;
+    double retired_work = 0.0;
+    int running = 0;
+    running_cores_.clear();
+    
+    for (size_t i = 0; i < cores_.size(); ++i) {
+        Core& core = cores_[i];
+        const CoreType& type = platform_.typeOf(i);
+        double power = 0.0;
+        if (!core.busy) {
+            if (scheduler_->isParked(static_cast<int>(i))) {
+                core.idle_governor.park(*energy_model_);
+            }
+            double leakage = type.getStaticPower(0) * leakage_factor;
+            const CState& state = core.idle_governor.idleTick(*energy_model_, policy);
+            power = state.power_watts + leakage * state.leakage_fraction;
+            idle_energy_ += power / 1000.0;
+        } else if (core.idle_governor.isWaking()) {
+            // Exit latency: placed but not yet able to run
+            power = core.idle_governor.wakeupPower(*energy_model_, type.getStaticPower(core.level) * leakage_factor);
+            core.idle_governor.finishWakeupTick();
+            idle_energy_ += power / 1000.0;
+        } else {
+            int level = core.run_level;
+            TaskType task_type = core.task.getExecutionType();
+            double leakage = type.getStaticPower(level) * leakage_factor;
+            power = type.getDynamicPower(task_type, level) + leakage;
+            leakage_energy_ += leakage / 1000.0;
+            applied_frequency += type.getFrequency(level);
+            core.busy_ticks++;
+            core.frequency_ticks += type.getFrequency(level);
+            running++;
+            running_cores_.push_back(static_cast<int>(i));
+            core.task_energy += power / 1000.0;
+            
+            double speed = type.getSpeed(task_type, level);
+            double contended_speed = speed * memory_.getSpeedFactor(task_type, served_fraction);
+            requested_work += speed;
+            retired_work += contended_speed;
+            core.task.execute(1, contended_speed);
+            if (core.task.isCompleted()) {
+                completeTask(core.task, current_time_ + 1, static_cast<int>(i));
+                core.busy = false;
+            } else if (core.task.isBlocked()) {
+                if (event_log_) {
+                    event_log_->record(EventType::BLOCK, current_time_ + 1, static_cast<int>(i), core.task.getId(),
+                                       core.task.getBlockingTicks());
+                }
+                wait_queue_.block(core.task, current_time_ + 1, core.task.getBlockingTicks());
+                core.busy = false;
+            }
+        }
+        core.energy += power / 1000.0;
+        total_power += power;
+        if (core_thermal_) {
+            core_thermal_->setCorePower(static_cast<int>(i), power);
+        }
+    }
+    
+    total_energy_ += total_power / 1000.0;
+    power_curve_[running].ticks++;
+    power_curve_[running].energy_joules += total_power / 1000.0;
+    if (core_thermal_) {
+        core_thermal_->advance(1);
+    } else {
+        thermal_model_->updateTemperature(total_power);
+    }
+    double temperature = thermal_model_->getCurrentTemperature();
+    // Charged to the task once it leaves the core, including this tick
+    for (int index : running_cores_) {
+        Core& core = cores_[index];
+        core.task_peak = std::max(core.task_peak, temperature);
+        if (!core.busy) {
+            attribution_.charge(core.task, core.task_energy);
+            attribution_.heat(core.task, core.task_peak);
+        }
+    }
+    thermal_governor_->update(temperature, requested_frequency, thermal_frequency, 1, requested_frequency > 0.0);
+    power_cap_.update(total_power, thermal_frequency, applied_frequency, 1, requested_frequency > 0.0);
+    memory_.update(requested_work, retired_work);
+    scheduler_->setThermalHeadroom(thermal_governor_->getHeadroom(temperature));
+    scheduler_->tick();
+    current_time_++;
+}
+
+void MulticoreEngine::setEnergyModel(std::unique_ptr<EnergyModel> energy_model) {
+    energy_model_ = std::move(energy_model);
+}
+
+void MulticoreEngine::setThermalModel(std::unique_ptr<ThermalModel> thermal_model) {
+    thermal_model_ = std::move(thermal_model);
+    core_thermal_ = nullptr;
+}
+
+void MulticoreEngine::setCoreThermalModel(std::unique_ptr<RCThermalModel> thermal_model) {
+    if (thermal_model->getNumCores() != platform_.getCoreCount()) {
+        throw std::invalid_argument("thermal network has " + std::to_string(thermal_model->getNumCores()) +
+                                    " core nodes for " + std::to_string(platform_.getCoreCount()) + " cores");
+    }
+    core_thermal_ = thermal_model.get();
+    thermal_model_ = std::move(thermal_model);
+}
+
+void MulticoreEngine::setThermalGovernor(std::unique_ptr<ThermalGovernor> governor) {
+    thermal_governor_ = std::move(governor);
+}
+
+void MulticoreEngine::setIODevice(int channels, int latency_ticks) {
+    wait_queue_.configure(channels, latency_ticks);
+}
+
+void MulticoreEngine::setEndCondition(EndCondition condition, int cooldown_ticks) {
+    end_condition_ = condition;
+    cooldown_ticks_ = cooldown_ticks;
+}
+
+void MulticoreEngine::reset() {
+    scheduler_->reset();
+    thermal_model_->reset();
+    thermal_governor_->reset();
+    power_cap_.reset();
+    memory_.reset();
+    current_time_ = 0;
+    max_time_ = 0;
+    finished_ = false;
+    last_completion_time_ = 0;
+    pending_arrivals_.clear();
+    next_arrival_ = 0;
+    arrival_slot_.clear();
+    released_.clear();
+    wait_queue_.reset();
+    cores_.assign(platform_.getCoreCount(), Core());
+    for (Core& core : cores_) {
+        core.busy = false;
+        core.level = 0;
+        core.run_level = 0;
+        core.logged_level = 0;
+        core.idle_governor.reset();
+        core.busy_ticks = 0;
+        core.tasks_dispatched = 0;
+        core.energy = 0.0;
+        core.frequency_ticks = 0.0;
+        core.task_energy = 0.0;
+        core.task_peak = 0.0;
+    }
+    total_energy_ = 0.0;
+    leakage_energy_ = 0.0;
+    idle_energy_ = 0.0;
+    completed_tasks_.clear();
+    latency_.reset();
+    attribution_.reset();
+    cancelled_ = false;
+    publish_countdown_ = 0;
+    logged_throttled_ = false;
+    power_curve_.assign(platform_.getCoreCount() + 1, UtilizationBin());
+    for (size_t i = 0; i < power_curve_.size(); ++i) {
+        power_curve_[i] = {static_cast<int>(i), 0, 0.0};
+    }
+    scheduler_->setThermalHeadroom(thermal_governor_->getHeadroom(thermal_model_->getCurrentTemperature()));
+}
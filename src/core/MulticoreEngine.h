@@ -0,0 +1,138 @@
+#ifndef MULTICORE_ENGINE_H
+#define MULTICORE_ENGINE_H
+
+#include "core/SimulationEngine.h"
+#include "scheduler/PlacementScheduler.h"
+#include "models/CoreType.h"
+#include "models/EnergyModel.h"
+#include "models/MemoryBandwidthModel.h"
+#include "models/ThermalModel.h"
+#include "models/RCThermalModel.h"
+#include "core/ThermalGovernor.h"
+#include "core/IdleGovernor.h"
+#include "core/PowerCapController.h"
+#include "core/WaitQueue.h"
+#include "tasks/Task.h"
+#include "tasks/TaskGraph.h"
+#include <vector>
+#include <memory>
+
+// Simulates a heterogeneous multi-core package. Each core runs at the level
+// its task was placed with (capped by the thermal governor), idles through
+// the energy model's C-states on its own, and draws the power tabulated for
+// its core type; all cores heat one shared thermal model (or, with an RC
+// network, their own nodes on it) and contend for one memory bandwidth
+// budget. Cores the placement policy parks sleep in the deepest C-state until
+// it hands them work again. Ticks are stepped one at a time while any core is
+// busy and fast-forwarded when all are idle.
+class MulticoreEngine {
+public:
+    MulticoreEngine(const Platform& platform, std::unique_ptr<PlacementScheduler> scheduler);
+    
+    SimulationStats runSimulation(const std::vector<Task>& tasks, int max_time = 50000);
+    
+    void start(const std::vector<Task>& tasks, int max_time = 50000);
+    bool runUntil(int time);
+    SimulationStats collectStats() const;
+    bool isFinished() const { return finished_; }
+    int getCurrentTime() const { return current_time_; }
+    
+    // The energy model supplies C-states and the leakage temperature curve;
+    // dynamic and reference leakage power come from the core types
+    void setEnergyModel(std::unique_ptr<EnergyModel> energy_model);
+    void setThermalModel(std::unique_ptr<ThermalModel> thermal_model);
+    // RC network with one node per core: each core heats its own node and the
+    // hottest core is the reported temperature
+    void setCoreThermalModel(std::unique_ptr<RCThermalModel> thermal_model);
+    void setThermalGovernor(std::unique_ptr<ThermalGovernor> governor);
+    // Budget on the total power of all cores, averaged over the controller's window
+    void setPowerCap(const PowerCapController& controller) { power_cap_ = controller; }
+    // Shared bandwidth that running tasks compete for, unlimited by default
+    void setMemoryBandwidth(const MemoryBandwidthModel& model) { memory_ = model; }
+    // Dependencies between the workload's tasks (by id): a task that has
+    // arrived waits until all its parents have completed
+    void setTaskGraph(std::shared_ptr<const TaskGraph> graph) { graph_ = std::move(graph); }
+    void setIODevice(int channels, int latency_ticks);
+    void setEndCondition(EndCondition condition, int cooldown_ticks = 1000);
+    // Progress published every SimulationEngine::kPublishEvents events (not
+    // owned; null disables); a cancellation request ends the run at the next
+    // publication
+    void setLiveMetrics(LiveMetrics* metrics) { metrics_ = metrics; }
+    bool isCancelled() const { return cancelled_; }
+    // Scheduling events are recorded to the log when set (not owned; null
+    // disables)
+    void setEventLog(EventLogWriter* event_log) { event_log_ = event_log; }
+    
+    const Platform& getPlatform() const { return platform_; }
+    
+    void reset();
+    
+private:
+    struct Core {
+        bool busy;
+        Task task;
+        int level;                  // Level chosen at placement
+        int run_level;              // Level applied this tick, after the caps
+        int logged_level;           // Level the event log last saw applied
+        IdleGovernor idle_governor;
+        int busy_ticks;
+        int tasks_dispatched;
+        double energy;
+        double frequency_ticks;     // Sum of applied GHz over busy ticks
+        double task_energy;         // Drawn by the current task since placement
+        double task_peak;
+    };
+    
+    Platform platform_;
+    std::unique_ptr<PlacementScheduler> scheduler_;
+    std::unique_ptr<EnergyModel> energy_model_;
+    std::unique_ptr<ThermalModel> thermal_model_;
+    RCThermalModel* core_thermal_;        // thermal_model_ when it is per-core, else null
+    std::unique_ptr<ThermalGovernor> thermal_governor_;
+    PowerCapController power_cap_;
+    MemoryBandwidthModel memory_;
+    std::shared_ptr<const TaskGraph> graph_;
+    DependencyTracker dependencies_;
+    
+    EndCondition end_condition_;
+    int cooldown_ticks_;
+    
+    int current_time_;
+    int max_time_;
+    bool finished_;
+    int last_completion_time_;
+    std::vector<Task> pending_arrivals_;  // Sorted by arrival time
+    size_t next_arrival_;
+    std::vector<int> arrival_slot_;       // Index into pending_arrivals_ by task id, for DAG runs
+    std::vector<int> released_;           // Tasks whose last parent completed, not yet queued
+    WaitQueue wait_queue_;
+    std::vector<Task> woken_tasks_;
+    std::vector<Core> cores_;
+    std::vector<int> idle_cores_;         // Scratch for placement
+    std::vector<int> running_cores_;      // Scratch: cores that ran a task this tick
+    std::vector<Placement> placements_;
+    double total_energy_;
+    double leakage_energy_;
+    double idle_energy_;
+    std::vector<Task> completed_tasks_;
+    LatencyStats latency_;
+    EnergyAttribution attribution_;
+    std::vector<UtilizationBin> power_curve_;
+    LiveMetrics* metrics_;
+    bool cancelled_;
+    int publish_countdown_;
+    EventLogWriter* event_log_;
+    bool logged_throttled_;
+    
+    bool publishProgress();
+    void releaseArrivals();
+    void placeTasks();
+    void completeTask(const Task& task, int end_time, int core);
+    int busyCoreCount() const;
+    double runningDemand() const;
+    int nextEventTime() const;
+    void advanceIdle(int ticks);
+    void step();
+};
+
+#endif // MULTICORE_ENGINE_H
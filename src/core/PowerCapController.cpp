@@ -0,0 +1,134 @@
+#include "PowerCapController.h"
+#include "Serialization.h"
+#include <algorithm>
+
+PowerCapController::PowerCapController(double budget_watts, int window_ticks, double kp, double ki, double kd)
+    : min_scale_(0.1) {
+    setParameters(budget_watts, window_ticks, kp, ki, kd);
+    reset();
+}
+
+void PowerCapController::update(double power_watts, double requested_frequency, double applied_frequency,
+                                int elapsed_ticks, bool busy) {
+    if (elapsed_ticks <= 0) {
+        return;
+    }
+    if (scale_ < 1.0) {
+        capped_ticks_ += elapsed_ticks;
+    }
+    if (busy) {
+        requested_cycles_ += requested_frequency * elapsed_ticks;
+        lost_cycles_ += (requested_frequency - applied_frequency) * elapsed_ticks;
+    }
+    if (!isEnabled()) {
+        return;
+    }
+    
+    push(power_watts, elapsed_ticks);
+    
+    // Relative overshoot of the window average; the integral only holds
+    // accumulated overshoot (clamped to what can saturate the output), so the
+    // cap releases as soon as the average falls back under the budget
+    double error = (getWindowAverage() - budget_) / budget_;
+    double integral_limit = (ki_ > 0.0) ? (1.0 - min_scale_) / ki_ : 0.0;
+    integral_ = std::min(std::max(integral_ + error * elapsed_ticks, 0.0), integral_limit);
+    double derivative = (error - previous_error_) / elapsed_ticks;
+    previous_error_ = error;
+    
+    double output = kp_ * error + ki_ * integral_ + kd_ * derivative;
+    scale_ = std::min(1.0, std::max(min_scale_, 1.0 - output));
+}
+
+double PowerCapController::getThroughputLossPercent() const {
+    return (requested_cycles_ > 0.0) ? 100.0 * lost_cycles_ / requested_cycles_ : 0.0;
+}
+
+void PowerCapController::setParameters(double budget_watts, int window_ticks, double kp, double ki, double kd) {
+    budget_ = budget_watts;
+    window_length_ = std::max(1, window_ticks);
+    kp_ = kp;
+    ki_ = ki;
+    kd_ = kd;
+}
+
+void PowerCapController::push(double power, int ticks) {
+    // A segment longer than the window replaces it entirely
+    ticks = std::min(ticks, window_length_);
+    if (!window_.empty() && window_.back().power == power) {
+        window_.back().ticks += ticks;
+    } else {
+        window_.push_back({power, ticks});
+    }
+    window_energy_ += power * ticks;
+    window_ticks_ += ticks;
+    
+    // Drop whole segments, then trim the oldest one, until the window fits
+    while (window_ticks_ > window_length_) {
+        Segment& oldest = window_.front();
+        int excess = std::min(oldest.ticks, window_ticks_ - window_length_);
+        oldest.ticks -= excess;
+        window_energy_ -= oldest.power * excess;
+        window_ticks_ -= excess;
+        if (oldest.ticks == 0) {
+            window_.pop_front();
+        }
+    }
+    if (window_.size() == 1) {
+        // Resynchronize the running sum so rounding cannot drift
+        window_energy_ = window_.front().power * window_.front().ticks;
+    }
+}
+
+void PowerCapController::reset() {
+    window_.clear();
+    window_energy_ = 0.0;
+    window_ticks_ = 0;
+    integral_ = 0.0;
+    previous_error_ = 0.0;
+    scale_ = 1.0;
+    capped_ticks_ = 0;
+    lost_cycles_ = 0.0;
+    requested_cycles_ = 0.0;
+}
+
+void PowerCapController::saveState(BinaryWriter& writer) const {
+    writer.writeDouble(budget_);
+    writer.writeInt(window_length_);
+    writer.writeDouble(kp_);
+    writer.writeDouble(ki_);
+    writer.writeDouble(kd_);
+    writer.writeUInt(window_.size());
+    for (const auto& segment : window_) {
+        writer.writeDouble(segment.power);
+        writer.writeInt(segment.ticks);
+    }
+    writer.writeDouble(window_energy_);
+    writer.writeDouble(integral_);
+    writer.writeDouble(previous_error_);
+    writer.writeDouble(scale_);
+    writer.writeInt(capped_ticks_);
+    writer.writeDouble(lost_cycles_);
+    writer.writeDouble(requested_cycles_);
+}
+
+void PowerCapController::loadState(BinaryReader& reader) {
+    budget_ = reader.readDouble();
+    window_length_ = static_cast<int>(reader.readInt());
+    kp_ = reader.readDouble();
+    ki_ = reader.readDouble();
+    kd_ = reader.readDouble();
+    window_.resize(reader.readUInt());
+    window_ticks_ = 0;
+    for (auto& segment : window_) {
+        segment.power = reader.readDouble();
+        segment.ticks = static_cast<int>(reader.readInt());
+        window_ticks_ += segment.ticks;
+    }
+    window_energy_ = reader.readDouble();
+    integral_ = reader.readDouble();
+    previous_error_ = reader.readDouble();
+    scale_ = reader.readDouble();
+    capped_ticks_ = static_cast<int>(reader.readInt());
+    lost_cycles_ = reader.readDouble();
+    requested_cycles_ = reader.readDouble();
+}
@@ -0,0 +1,71 @@
+#ifndef POWER_CAP_CONTROLLER_H
+#define POWER_CAP_CONTROLLER_H
+
+#include <deque>
+
+class BinaryWriter;
+class BinaryReader;
+
+// Package power limit in the style of RAPL: the average power over a sliding
+// window is held at or below a budget by a PID loop whose output scales every
+// requested frequency down. The window is kept as constant-power segments with
+// a running sum, so each update is amortized O(1) however many ticks it covers.
+class PowerCapController {
+public:
+    // A budget of 0 or less disables the cap
+    PowerCapController(double budget_watts = 0.0, int window_ticks = 100,
+                       double kp = 0.5, double ki = 0.02, double kd = 0.0);
+    
+    // Cap a requested frequency (GHz) by the current controller output
+    double limitFrequency(double requested_frequency) const { return requested_frequency * scale_; }
+    double getScale() const { return scale_; }
+    
+    // Feed the power drawn over the elapsed ticks and account the cycles lost
+    // to the cap; busy is false while the package was idle
+    void update(double power_watts, double requested_frequency, double applied_frequency,
+                int elapsed_ticks, bool busy);
+    
+    bool isEnabled() const { return budget_ > 0.0; }
+    double getBudget() const { return budget_; }
+    double getWindowAverage() const { return window_ticks_ > 0 ? window_energy_ / window_ticks_ : 0.0; }
+    
+    int getCappedTime() const { return capped_ticks_; }
+    double getLostCycles() const { return lost_cycles_; }
+    double getThroughputLossPercent() const;
+    
+    void setParameters(double budget_watts, int window_ticks, double kp, double ki, double kd);
+    
+    // Snapshot support
+    void saveState(BinaryWriter& writer) const;
+    void loadState(BinaryReader& reader);
+    
+    void reset();
+    
+private:
+    struct Segment {
+        double power;
+        int ticks;
+    };
+    
+    double budget_;          // Average power limit (W)
+    int window_length_;      // Averaging window (ticks)
+    double kp_;
+    double ki_;              // Per tick
+    double kd_;              // Per tick
+    double min_scale_;       // Lowest frequency scale the loop may apply
+    
+    std::deque<Segment> window_;
+    double window_energy_;   // Sum of power * ticks over the window
+    int window_ticks_;
+    double integral_;
+    double previous_error_;
+    double scale_;
+    
+    int capped_ticks_;
+    double lost_cycles_;
+    double requested_cycles_;
+    
+    void push(double power, int ticks);
+};
+
+#endif // POWER_CAP_CONTROLLER_H
@@ -0,0 +1,71 @@
+#include "QuantumTuner.h"
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+QuantumTuner::QuantumTuner(Evaluator evaluator, int min_quantum, int max_quantum)
+    : evaluator_(std::move(evaluator)), min_quantum_(std::max(1, min_quantum)),
+      max_quantum_(std::max(min_quantum_, max_quantum)), best_quantum_(-1) {
+}
+
+double QuantumTuner::energyPerTask(const SimulationStats& stats) {
+    if (stats.total_tasks == 0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return stats.total_energy_joules / stats.total_tasks;
+}
+
+double QuantumTuner::evaluate(int quantum) {
+    auto it = trials_.find(quantum);
+    if (it == trials_.end()) {
+        SimulationStats stats = evaluator_(quantum);
+        it = trials_.emplace(quantum, Trial{quantum, energyPerTask(stats), stats}).first;
+        if (best_quantum_ < 0 || it->second.energy_per_task < trials_.at(best_quantum_).energy_per_task) {
+            best_quantum_ = quantum;
+        }
+    }
+    return it->second.energy_per_task;
+}
+
+int QuantumTuner::tune() {
+    // Coarse sweep: doubling quanta, always including the upper bound
+    std::vector<int> grid;
+    for (long long quantum = min_quantum_; quantum < max_quantum_; quantum *= 2) {
+        grid.push_back(static_cast<int>(quantum));
+    }
+    grid.push_back(max_quantum_);
+    
+    size_t best = 0;
+    for (size_t i = 0; i < grid.size(); ++i) {
+        if (evaluate(grid[i]) < evaluate(grid[best])) {
+            best = i;
+        }
+    }
+    
+    // Refine between the neighbours of the best grid point
+    int low = grid[best > 0 ? best - 1 : 0];
+    int high = grid[std::min(best + 1, grid.size() - 1)];
+    while (high - low > 2) {
+        int third = (high - low) / 3;
+        int left = low + third;
+        int right = high - third;
+        if (evaluate(left) <= evaluate(right)) {
+            high = right;
+        } else {
+            low = left;
+        }
+    }
+    for (int quantum = low; quantum <= high; ++quantum) {
+        evaluate(quantum);
+    }
+    return best_quantum_;
+}
+
+std::vector<QuantumTuner::Trial> QuantumTuner::getTrials() const {
+    std::vector<Trial> trials;
+    trials.reserve(trials_.size());
+    for (const auto& entry : trials_) {
+        trials.push_back(entry.second);
+    }
+    return trials;
+}
@@ -0,0 +1,47 @@
+#ifndef QUANTUM_TUNER_H
+#define QUANTUM_TUNER_H
+
+#include "core/SimulationEngine.h"
+#include <functional>
+#include <map>
+#include <vector>
+
+// Searches for the round-robin time quantum that minimises energy per completed
+// task. A doubling sweep over [min, max] brackets the best quantum, then an
+// integer ternary search refines within the bracket. Each quantum is simulated
+// at most once. Switch stalls do not eat into the quantum, so every quantum
+// makes progress and the cost falls smoothly towards the best one; only a
+// quantum too short to finish anything within the run scores infinite.
+class QuantumTuner {
+public:
+    // Runs the workload with the given quantum
+    typedef std::function<SimulationStats(int quantum)> Evaluator;
+    
+    struct Trial {
+        int quantum;
+        double energy_per_task;   // Joules; infinite when nothing completed
+        SimulationStats stats;
+    };
+    
+    QuantumTuner(Evaluator evaluator, int min_quantum = 1, int max_quantum = 1000);
+    
+    // Returns the best quantum found
+    int tune();
+    
+    // Every evaluated quantum in ascending order
+    std::vector<Trial> getTrials() const;
+    const Trial& getBest() const { return trials_.at(best_quantum_); }
+    
+    static double energyPerTask(const SimulationStats& stats);
+
+private:
+    Evaluator evaluator_;
+    int min_quantum_;
+    int max_quantum_;
+    int best_quantum_;
+    std::map<int, Trial> trials_;
+    
+    double evaluate(int quantum);
+};
+
+#endif // QUANTUM_TUNER_H
@@ -0,0 +1,85 @@
+#include "Serialization.h"
+#include <cstring>
+#include <stdexcept>
+
+void BinaryWriter::writeInt(int64_t value) {
+    // Zigzag so small negative values stay short
+    writeUInt((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+void BinaryWriter::writeUInt(uint64_t value) {
+    while (value >= 0x80) {
+        buffer_.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    buffer_.push_back(static_cast<uint8_t>(value));
+}
+
+void BinaryWriter::writeDouble(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    for (int i = 0; i < 8; ++i) {
+        buffer_.push_back(static_cast<uint8_t>(bits >> (8 * i)));
+    }
+}
+
+void BinaryWriter::writeString(const std::string& value) {
+    writeUInt(value.size());
+    buffer_.insert(buffer_.end(), value.begin(), value.end());
+}
+
+void BinaryWriter::writeBytes(const std::vector<uint8_t>& bytes) {
+    writeUInt(bytes.size());
+    buffer_.insert(buffer_.end(), bytes.begin(), bytes.end());
+}
+
+int64_t BinaryReader::readInt() {
+    uint64_t encoded = readUInt();
+    return static_cast<int64_t>(encoded >> 1) ^ -static_cast<int64_t>(encoded & 1);
+}
+
+uint64_t BinaryReader::readUInt() {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        require(1);
+        uint8_t byte = data_[offset_++];
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    throw std::runtime_error("malformed varint in snapshot");
+}
+
+double BinaryReader::readDouble() {
+    require(8);
+    uint64_t bits = 0;
+    for (int i = 0; i < 8; ++i) {
+        bits |= static_cast<uint64_t>(data_[offset_++]) << (8 * i);
+    }
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+std::string BinaryReader::readString() {
+    uint64_t length = readUInt();
+    require(length);
+    std::string value(reinterpret_cast<const char*>(data_ + offset_), length);
+    offset_ += length;
+    return value;
+}
+
+std::vector<uint8_t> BinaryReader::readBytes() {
+    uint64_t length = readUInt();
+    require(length);
+    std::vector<uint8_t> bytes(data_ + offset_, data_ + offset_ + length);
+    offset_ += length;
+    return bytes;
+}
+
+void BinaryReader::require(size_t bytes) const {
+    if (bytes > size_ - offset_) {
+        throw std::runtime_error("unexpected end of snapshot data");
+    }
+}
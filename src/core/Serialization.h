@@ -0,0 +1,50 @@
+#ifndef SERIALIZATION_H
+#define SERIALIZATION_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Compact little-endian binary encoding: integers as zigzag LEB128 varints,
+// doubles as raw 8-byte IEEE values
+class BinaryWriter {
+public:
+    void writeInt(int64_t value);
+    void writeUInt(uint64_t value);
+    void writeDouble(double value);
+    void writeBool(bool value) { writeUInt(value ? 1 : 0); }
+    void writeString(const std::string& value);
+    void writeBytes(const std::vector<uint8_t>& bytes);
+    
+    const std::vector<uint8_t>& getBuffer() const { return buffer_; }
+    std::vector<uint8_t> release() { return std::move(buffer_); }
+    
+private:
+    std::vector<uint8_t> buffer_;
+};
+
+// Reads what BinaryWriter produced; throws std::runtime_error on truncated input
+class BinaryReader {
+public:
+    BinaryReader(const uint8_t* data, size_t size) : data_(data), size_(size), offset_(0) {}
+    explicit BinaryReader(const std::vector<uint8_t>& buffer)
+        : data_(buffer.data()), size_(buffer.size()), offset_(0) {}
+    
+    int64_t readInt();
+    uint64_t readUInt();
+    double readDouble();
+    bool readBool() { return readUInt() != 0; }
+    std::string readString();
+    std::vector<uint8_t> readBytes();
+    
+    bool atEnd() const { return offset_ >= size_; }
+    
+private:
+    const uint8_t* data_;
+    size_t size_;
+    size_t offset_;
+    
+    void require(size_t bytes) const;
+};
+
+#endif // SERIALIZATION_H
@@ -1,65 +1,400 @@
 #include "SimulationEngine.h"
+#include "Serialization.h"
 #include <iostream>
 #include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace {
+// Task durations are expressed in ticks at this frequency
+const double kReferenceFrequencyGHz = 1.0;
+
+// Snapshot header
+const char kSnapshotMagic[] = "PPSN";
+const uint64_t kSnapshotVersion = 9;
+}
+
+void LatencyStats::record(const Task& task) {
+    turnaround.record(task.getEndTime() - task.getArrivalTime());
+    waiting.record(task.getWaitTime());
+    if (task.getStartTime() >= 0) {
+        response.record(task.getStartTime() - task.getArrivalTime());
+    }
+}
+
+void LatencyStats::merge(const LatencyStats& other) {
+    turnaround.merge(other.turnaround);
+    waiting.merge(other.waiting);
+    response.merge(other.response);
+}
+
+void LatencyStats::save(BinaryWriter& writer) const {
+    turnaround.save(writer);
+    waiting.save(writer);
+    response.save(writer);
+}
+
+void LatencyStats::load(BinaryReader& reader) {
+    turnaround.load(reader);
+    waiting.load(reader);
+    response.load(reader);
+}
+
+void LatencyStats::reset() {
+    turnaround.reset();
+    waiting.reset();
+    response.reset();
+}
 
 SimulationEngine::SimulationEngine(std::unique_ptr<Scheduler> scheduler)
-    : scheduler_(std::move(scheduler)), current_time_(0), total_energy_(0.0) {
+    : scheduler_(std::move(scheduler)), end_condition_(EndCondition::DRAIN), cooldown_ticks_(1000),
+      current_time_(0), max_time_(0), finished_(false), last_completion_time_(0), next_arrival_(0), total_energy_(0.0),
+      leakage_energy_(0.0), idle_energy_(0.0), current_power_(0.0), observed_switches_(0), switch_stall_(0),
+      switch_overhead_ticks_(0), switch_energy_(0.0), metrics_(nullptr), cancelled_(false),
+      publish_countdown_(0), event_log_(nullptr), logged_task_(-1), logged_frequency_(0), logged_throttled_(false) {
     energy_model_ = std::make_unique<EnergyModel>();
     thermal_model_ = std::make_unique<ThermalModel>();
+    thermal_governor_ = std::make_unique<ThermalGovernor>();
 }
 
 SimulationStats SimulationEngine::runSimulation(const std::vector<Task>& tasks, int max_time) {
+    start(tasks, max_time);
+    runUntil(max_time);
+    return collectStats();
+}
+
+void SimulationEngine::start(const std::vector<Task>& tasks, int max_time) {
     reset();
-    for (const auto& task : tasks) {
-        scheduler_->addTask(task);
-    }
-    int idle_time = 0;
-    const int max_idle_time = 1000;
-    while (current_time_ < max_time && (scheduler_->hasTasks() || idle_time < max_idle_time)) {
-        Task* current_task = scheduler_->getNextTask();
-        if (current_task != nullptr) {
-            idle_time = 0;
-            executeTask(current_task);
+    max_time_ = max_time;
+    pending_arrivals_ = tasks;
+    std::stable_sort(pending_arrivals_.begin(), pending_arrivals_.end(),
+                     [](const Task& a, const Task& b) { return a.getArrivalTime() < b.getArrivalTime(); });
+    if (metrics_) {
+        metrics_->beginRun();
+    }
+}
+
+bool SimulationEngine::runUntil(int time) {
+    return run(time, false);
+}
+
+bool SimulationEngine::advanceTo(int time) {
+    return run(time, true);
+}
+
+void SimulationEngine::submit(const Task& task) {
+    auto position = std::upper_bound(pending_arrivals_.begin() + next_arrival_, pending_arrivals_.end(), task,
+                                     [](const Task& a, const Task& b) { return a.getArrivalTime() < b.getArrivalTime(); });
+    pending_arrivals_.insert(position, task);
+}
+
+bool SimulationEngine::hasWork() const {
+    return next_arrival_ < pending_arrivals_.size() || !wait_queue_.empty() || scheduler_->hasTasks();
+}
+
+int SimulationEngine::getOutstandingTasks() const {
+    return static_cast<int>(pending_arrivals_.size() - next_arrival_ + wait_queue_.size()) +
+           scheduler_->getActiveTasksCount();
+}
+
+bool SimulationEngine::run(int time, bool exact) {
+    int limit = std::min(time, max_time_);
+    while (!finished_ && current_time_ < limit) {
+        if (metrics_ && --publish_countdown_ <= 0 && !publishProgress()) {
+            break;
+        }
+        releaseArrivals();
+        Task* current_task = dispatchTask();
+        if (scheduler_->getContextSwitches() != observed_switches_) {
+            observed_switches_ = scheduler_->getContextSwitches();
+            chargeContextSwitch(current_task);
+        }
+        double requested_frequency = scheduler_->getCurrentFrequency();
+        double thermal_frequency = thermal_governor_->limitFrequency(requested_frequency);
+        double frequency = power_cap_.limitFrequency(thermal_frequency);
+        if (event_log_) {
+            logScheduling(current_task, frequency);
+        }
+        
+        if (current_task == nullptr) {
+            // Nothing runnable: jump straight to the next event in one step
+            // An open-ended run stops at the limit, but the idle governor still
+            // plans for the whole known gap
+            int next_event = nextEventTime(max_time_);
+            int expected_idle = next_event - current_time_;
+            if (exact) {
+                next_event = std::min(next_event, limit);
+            }
+            if (next_event <= current_time_) {
+                finished_ = true;
+                break;
+            }
+            advanceIdle(next_event - current_time_, expected_idle, requested_frequency, thermal_frequency, frequency);
+            continue;
+        }
+        
+        if (idle_governor_.isIdle()) {
+            double transition_energy = idle_governor_.wake(*energy_model_);
+            total_energy_ += transition_energy;
+            idle_energy_ += transition_energy;
+        }
+        bool stalled = false;
+        if (idle_governor_.isWaking()) {
+            // Exit latency: the task is dispatched but cannot run yet
+            updateModels(nullptr, 1, frequency);
+            updateGovernors(nullptr, requested_frequency, thermal_frequency, frequency, 1);
+            idle_governor_.finishWakeupTick();
+        } else if (switch_stall_ > 0) {
+            // Switching in or refilling caches: busy, but the task makes no progress
+            double energy_before = total_energy_;
+            updateModels(current_task, 1, frequency);
+            updateGovernors(current_task, requested_frequency, thermal_frequency, frequency, 1);
+            switch_energy_ += total_energy_ - energy_before;
+            switch_overhead_ticks_++;
+            switch_stall_--;
+            stalled = true;
+        } else {
+            executeTask(current_task, frequency);
+            updateGovernors(current_task, requested_frequency, thermal_frequency, frequency, 1);
             if (current_task->isCompleted()) {
-                scheduler_->taskCompleted(current_task->getId());
-                completed_tasks_.push_back(*current_task);
+                completeTask(*current_task, current_time_ + 1);
             }
+        }
+        if (stalled) {
+            scheduler_->stallTick();
         } else {
-            idle_time++;
-            updateModels(nullptr, 1);
+            scheduler_->tick();
         }
-        scheduler_->tick();
         current_time_++;
     }
+    if (current_time_ >= max_time_) {
+        finished_ = true;
+    }
+    if (metrics_) {
+        publishProgress();
+    }
+    return !finished_;
+}
+
+// False once cancellation has been requested, which ends the run
+bool SimulationEngine::publishProgress() {
+    publish_countdown_ = kPublishEvents;
+    metrics_->update(current_time_, static_cast<int64_t>(completed_tasks_.size()), total_energy_,
+                     thermal_model_->getCurrentTemperature());
+    if (metrics_->isCancelRequested()) {
+        cancelled_ = true;
+        finished_ = true;
+    }
+    return !cancelled_;
+}
+
+// Compares what runs now with what the log last saw. A running task that
+// changed without completing or blocking was preempted.
+void SimulationEngine::logScheduling(const Task* task, double frequency) {
+    int id = (task != nullptr) ? task->getId() : -1;
+    int mhz = static_cast<int>(std::lround(frequency * 1000.0));
+    if (id != logged_task_) {
+        if (logged_task_ >= 0) {
+            event_log_->record(EventType::PREEMPT, current_time_, 0, logged_task_, 0);
+        }
+        if (task != nullptr) {
+            event_log_->record(EventType::DISPATCH, current_time_, 0, id, mhz);
+            logged_frequency_ = mhz;
+        }
+        logged_task_ = id;
+    } else if (task != nullptr && mhz != logged_frequency_) {
+        event_log_->record(EventType::FREQUENCY, current_time_, 0, id, mhz);
+        logged_frequency_ = mhz;
+    }
+    if (thermal_governor_->isThrottled() != logged_throttled_) {
+        logged_throttled_ = !logged_throttled_;
+        event_log_->record(EventType::THROTTLE, current_time_, -1, -1, logged_throttled_ ? 1 : 0);
+    }
+}
+
+SimulationStats SimulationEngine::collectStats() const {
     SimulationStats stats;
     stats.total_tasks = completed_tasks_.size();
     stats.total_execution_time = current_time_;
     stats.total_energy_joules = total_energy_;
     stats.average_power_watts = (current_time_ > 0) ? total_energy_ / (current_time_ / 1000.0) : 0.0;
     stats.peak_temperature_celsius = thermal_model_->getPeakTemperature();
+    stats.throttled_time_ticks = thermal_governor_->getThrottledTime();
+    stats.throttle_events = thermal_governor_->getThrottleEvents();
+    stats.throughput_loss_percent = thermal_governor_->getThroughputLossPercent();
+    stats.power_capped_ticks = power_cap_.getCappedTime();
+    stats.power_cap_loss_percent = power_cap_.getThroughputLossPercent();
+    stats.contended_ticks = 0;
+    stats.contention_loss_percent = 0.0;
+    stats.leakage_energy_joules = leakage_energy_;
+    stats.idle_energy_joules = idle_energy_;
+    stats.wakeups = idle_governor_.getWakeups();
+    stats.context_switches = scheduler_->getContextSwitches();
+    stats.preemptions = scheduler_->getPreemptions();
+    stats.switch_overhead_ticks = switch_overhead_ticks_;
+    stats.switch_energy_joules = switch_energy_;
+    stats.cancelled = cancelled_;
+    const std::vector<int>& residency = idle_governor_.getResidency();
+    for (size_t i = 0; i < residency.size(); ++i) {
+        stats.cstate_residency.emplace_back(energy_model_->getCStates()[i].name, residency[i]);
+    }
+    stats.latency = latency_;
     stats.scheduler_name = scheduler_->getName();
     stats.completed_tasks = completed_tasks_;
+    attribution_.attribute(idle_energy_, stats.completed_tasks, stats.task_energy, stats.energy_by_type);
     return stats;
 }
 
-void SimulationEngine::executeTask(Task* task) {
+void SimulationEngine::releaseArrivals() {
+    while (next_arrival_ < pending_arrivals_.size() &&
+           pending_arrivals_[next_arrival_].getArrivalTime() <= current_time_) {
+        attribution_.admit(pending_arrivals_[next_arrival_]);
+        scheduler_->addTask(pending_arrivals_[next_arrival_]);
+        next_arrival_++;
+    }
+    woken_tasks_.clear();
+    wait_queue_.release(current_time_, woken_tasks_);
+    for (Task& task : woken_tasks_) {
+        task.completeBlockingPhase();
+        if (task.isCompleted()) {
+            completeTask(task, current_time_);
+        } else {
+            scheduler_->addTask(task);
+        }
+    }
+}
+
+Task* SimulationEngine::dispatchTask() {
+    // A task reaching an I/O phase leaves the CPU until its wake-up time
+    Task* task = scheduler_->getNextTask();
+    while (task != nullptr && task->isBlocked()) {
+        if (event_log_) {
+            event_log_->record(EventType::BLOCK, current_time_, 0, task->getId(), task->getBlockingTicks());
+            if (task->getId() == logged_task_) {
+                logged_task_ = -1;
+            }
+        }
+        wait_queue_.block(*task, current_time_, task->getBlockingTicks());
+        scheduler_->taskBlocked(task->getId());
+        task = scheduler_->getNextTask();
+    }
+    return task;
+}
+
+void SimulationEngine::completeTask(const Task& task, int end_time) {
+    // Copy before notifying the scheduler, which drops its own instance
+    Task completed = task;
+    completed.setEndTime(end_time);
+    scheduler_->taskCompleted(completed.getId());
+    completed_tasks_.push_back(completed);
+    latency_.record(completed);
+    last_completion_time_ = end_time;
+    if (event_log_) {
+        // Tasks whose last phase was I/O finish off the CPU
+        bool running = completed.getId() == logged_task_;
+        event_log_->record(EventType::COMPLETE, end_time, running ? 0 : -1, completed.getId(), 0);
+        if (running) {
+            logged_task_ = -1;
+        }
+    }
+}
+
+void SimulationEngine::chargeContextSwitch(const Task* task) {
+    // Dispatches of tasks that blocked straight away never reach the CPU
+    if (task == nullptr) {
+        return;
+    }
+    switch_stall_ = switch_cost_.stallTicks(task->getExecutionType());
+    total_energy_ += switch_cost_.energy_joules;
+    attribution_.charge(*task, switch_cost_.energy_joules);
+    switch_energy_ += switch_cost_.energy_joules;
+}
+
+int SimulationEngine::nextEventTime(int max_time) const {
+    if (!wait_queue_.empty()) {
+        int wake_time = wait_queue_.nextWakeTime();
+        if (next_arrival_ < pending_arrivals_.size()) {
+            wake_time = std::min(wake_time, pending_arrivals_[next_arrival_].getArrivalTime());
+        }
+        return std::min(max_time, wake_time);
+    }
+    if (next_arrival_ < pending_arrivals_.size()) {
+        return std::min(max_time, pending_arrivals_[next_arrival_].getArrivalTime());
+    }
+    if (scheduler_->hasTasks()) {
+        // Work is queued but not dispatchable this tick
+        return current_time_ + 1;
+    }
+    switch (end_condition_) {
+        case EndCondition::LAST_COMPLETION:
+            return current_time_;
+        case EndCondition::HORIZON:
+            return max_time;
+        case EndCondition::DRAIN:
+        default:
+            return std::min(max_time, last_completion_time_ + cooldown_ticks_);
+    }
+}
+
+void SimulationEngine::advanceIdle(int ticks, int expected_idle, double requested_frequency, double thermal_frequency,
+                                   double frequency) {
+    // The whole gap is accounted at once: leakage is evaluated at the starting
+    // temperature and the thermal model integrates the gap in closed form
+    double voltage = energy_model_->getVoltageForFrequency(frequency);
+    double leakage = energy_model_->calculateLeakagePower(thermal_model_->getCurrentTemperature(), voltage);
+    double energy = idle_governor_.idleEnergy(*energy_model_, leakage, scheduler_->getPowerPolicy(), ticks,
+                                              expected_idle);
+    double power = energy / (ticks / 1000.0);
+    
+    total_energy_ += energy;
+    idle_energy_ += energy;
+    current_power_ = power;
+    thermal_model_->updateTemperature(power, ticks);
+    updateGovernors(nullptr, requested_frequency, thermal_frequency, frequency, ticks);
+    scheduler_->advanceTicks(ticks);
+    current_time_ += ticks;
+}
+
+void SimulationEngine::executeTask(Task* task, double frequency) {
     if (task == nullptr) return;
     int execution_slice = 1;
-    task->execute(execution_slice);
-    updateModels(task, execution_slice);
+    task->execute(execution_slice, frequency / kReferenceFrequencyGHz);
+    updateModels(task, execution_slice, frequency);
 }
 
-void SimulationEngine::updateModels(Task* task, int execution_time) {
-    double frequency = scheduler_->getCurrentFrequency();
+void SimulationEngine::updateModels(Task* task, int execution_time, double frequency) {
+    double time_seconds = execution_time / 1000.0;
+    double voltage = energy_model_->getVoltageForFrequency(frequency);
+    double leakage = energy_model_->calculateLeakagePower(thermal_model_->getCurrentTemperature(), voltage);
     double power = 0.0;
     if (task != nullptr) {
-        power = energy_model_->calculatePower(task->getType(), frequency);
-        total_energy_ += energy_model_->calculateTaskEnergy(*task, frequency, execution_time);
+        power = energy_model_->calculatePower(task->getExecutionType(), frequency) + leakage;
+        double energy = energy_model_->calculateTaskEnergy(*task, frequency, execution_time);
+        total_energy_ += energy;
+        total_energy_ += leakage * time_seconds;
+        leakage_energy_ += leakage * time_seconds;
+        attribution_.charge(*task, energy + leakage * time_seconds);
     } else {
-        power = energy_model_->calculatePower(TaskType::CPU_BOUND, 0.5) * 0.1;
-        total_energy_ += power * (execution_time / 1000.0);
+        power = idle_governor_.wakeupPower(*energy_model_, leakage);
+        total_energy_ += power * time_seconds;
+        idle_energy_ += power * time_seconds;
     }
+    current_power_ = power;
     thermal_model_->updateTemperature(power);
+    if (task != nullptr) {
+        attribution_.heat(*task, thermal_model_->getCurrentTemperature());
+    }
+}
+
+void SimulationEngine::updateGovernors(Task* task, double requested_frequency, double thermal_frequency,
+                                       double frequency, int elapsed) {
+    // Throttling and the power cap each account the cycles they removed
+    double temperature = thermal_model_->getCurrentTemperature();
+    thermal_governor_->update(temperature, requested_frequency, thermal_frequency, elapsed, task != nullptr);
+    power_cap_.update(current_power_, thermal_frequency, frequency, elapsed, task != nullptr);
+    scheduler_->setThermalHeadroom(thermal_governor_->getHeadroom(temperature));
 }
 
 void SimulationEngine::setEnergyModel(std::unique_ptr<EnergyModel> energy_model) {
@@ -70,8 +405,21 @@ void SimulationEngine::setThermalModel(std::unique_ptr<ThermalModel> thermal_mod
     thermal_model_ = std::move(thermal_model);
 }
 
+void SimulationEngine::setThermalGovernor(std::unique_ptr<ThermalGovernor> governor) {
+    thermal_governor_ = std::move(governor);
+}
+
+void SimulationEngine::setIODevice(int channels, int latency_ticks) {
+    wait_queue_.configure(channels, latency_ticks);
+}
+
+void SimulationEngine::setEndCondition(EndCondition condition, int cooldown_ticks) {
+    end_condition_ = condition;
+    cooldown_ticks_ = cooldown_ticks;
+}
+
 double SimulationEngine::getCurrentPower() const {
-    return 0.0;
+    return current_power_;
 }
 
 double SimulationEngine::getCurrentTemperature() const {
@@ -81,7 +429,175 @@ double SimulationEngine::getCurrentTemperature() const {
 void SimulationEngine::reset() {
     scheduler_->reset();
     thermal_model_->reset();
+    thermal_governor_->reset();
+    power_cap_.reset();
+    idle_governor_.reset();
     current_time_ = 0;
+    max_time_ = 0;
+    finished_ = false;
+    last_completion_time_ = 0;
+    pending_arrivals_.clear();
+    next_arrival_ = 0;
+    wait_queue_.reset();
     total_energy_ = 0.0;
+    leakage_energy_ = 0.0;
+    idle_energy_ = 0.0;
+    current_power_ = 0.0;
     completed_tasks_.clear();
+    latency_.reset();
+    attribution_.reset();
+    observed_switches_ = 0;
+    switch_stall_ = 0;
+    switch_overhead_ticks_ = 0;
+    switch_energy_ = 0.0;
+    cancelled_ = false;
+    publish_countdown_ = 0;
+    logged_task_ = -1;
+    logged_frequency_ = 0;
+    logged_throttled_ = false;
+    scheduler_->setThermalHeadroom(thermal_governor_->getHeadroom(thermal_model_->getCurrentTemperature()));
+}
+
+std::vector<uint8_t> SimulationEngine::saveSnapshot() const {
+    BinaryWriter writer;
+    writer.writeString(kSnapshotMagic);
+    writer.writeUInt(kSnapshotVersion);
+    
+    writer.writeInt(current_time_);
+    writer.writeInt(max_time_);
+    writer.writeBool(finished_);
+    writer.writeInt(last_completion_time_);
+    writer.writeUInt(static_cast<uint64_t>(end_condition_));
+    writer.writeInt(cooldown_ticks_);
+    writer.writeDouble(total_energy_);
+    writer.writeDouble(leakage_energy_);
+    writer.writeDouble(idle_energy_);
+    writer.writeDouble(current_power_);
+    
+    writer.writeUInt(pending_arrivals_.size() - next_arrival_);
+    for (size_t i = next_arrival_; i < pending_arrivals_.size(); ++i) {
+        pending_arrivals_[i].save(writer);
+    }
+    wait_queue_.saveState(writer);
+    writer.writeUInt(completed_tasks_.size());
+    for (const auto& task : completed_tasks_) {
+        task.save(writer);
+    }
+    latency_.save(writer);
+    attribution_.saveState(writer);
+    writer.writeInt(switch_cost_.latency_ticks);
+    writer.writeDouble(switch_cost_.energy_joules);
+    for (int ticks : switch_cost_.warmup_ticks) {
+        writer.writeInt(ticks);
+    }
+    writer.writeInt(switch_stall_);
+    writer.writeInt(switch_overhead_ticks_);
+    writer.writeDouble(switch_energy_);
+    
+    energy_model_->saveState(writer);
+    writer.writeString(thermal_model_->getName());
+    thermal_model_->saveState(writer);
+    thermal_governor_->saveState(writer);
+    power_cap_.saveState(writer);
+    idle_governor_.saveState(writer);
+    
+    writer.writeString(scheduler_->getName());
+    std::vector<Task> scheduled = scheduler_->getPendingTasks();
+    writer.writeUInt(scheduled.size());
+    for (const auto& task : scheduled) {
+        task.save(writer);
+    }
+    BinaryWriter scheduler_state;
+    scheduler_->saveState(scheduler_state);
+    writer.writeBytes(scheduler_state.getBuffer());
+    
+    return writer.release();
+}
+
+void SimulationEngine::restoreSnapshot(const std::vector<uint8_t>& snapshot) {
+    BinaryReader reader(snapshot);
+    if (reader.readString() != kSnapshotMagic || reader.readUInt() != kSnapshotVersion) {
+        throw std::runtime_error("not a compatible simulation snapshot");
+    }
+    reset();
+    
+    current_time_ = static_cast<int>(reader.readInt());
+    max_time_ = static_cast<int>(reader.readInt());
+    finished_ = reader.readBool();
+    last_completion_time_ = static_cast<int>(reader.readInt());
+    end_condition_ = static_cast<EndCondition>(reader.readUInt());
+    cooldown_ticks_ = static_cast<int>(reader.readInt());
+    total_energy_ = reader.readDouble();
+    leakage_energy_ = reader.readDouble();
+    idle_energy_ = reader.readDouble();
+    current_power_ = reader.readDouble();
+    
+    pending_arrivals_.resize(reader.readUInt());
+    for (auto& task : pending_arrivals_) {
+        task = Task::load(reader);
+    }
+    wait_queue_.loadState(reader);
+    completed_tasks_.resize(reader.readUInt());
+    for (auto& task : completed_tasks_) {
+        task = Task::load(reader);
+    }
+    latency_.load(reader);
+    attribution_.loadState(reader);
+    switch_cost_.latency_ticks = static_cast<int>(reader.readInt());
+    switch_cost_.energy_joules = reader.readDouble();
+    for (int& ticks : switch_cost_.warmup_ticks) {
+        ticks = static_cast<int>(reader.readInt());
+    }
+    switch_stall_ = static_cast<int>(reader.readInt());
+    switch_overhead_ticks_ = static_cast<int>(reader.readInt());
+    switch_energy_ = reader.readDouble();
+    
+    energy_model_->loadState(reader);
+    if (reader.readString() != thermal_model_->getName()) {
+        throw std::runtime_error("snapshot was taken with a different thermal model");
+    }
+    thermal_model_->loadState(reader);
+    thermal_governor_->loadState(reader);
+    power_cap_.loadState(reader);
+    idle_governor_.loadState(reader);
+    
+    std::string scheduler_name = reader.readString();
+    std::vector<Task> scheduled(reader.readUInt());
+    for (auto& task : scheduled) {
+        task = Task::load(reader);
+    }
+    std::vector<uint8_t> scheduler_state = reader.readBytes();
+    if (scheduler_name == scheduler_->getName()) {
+        BinaryReader state_reader(scheduler_state);
+        scheduler_->restoreState(scheduled, state_reader);
+    } else {
+        // Fork into a different policy: it starts from the same queued work and clock,
+        // so the running task becomes ready at the fork point
+        scheduler_->advanceTicks(current_time_);
+        for (const auto& task : scheduled) {
+            scheduler_->addTask(task);
+        }
+        scheduler_->setThermalHeadroom(thermal_governor_->getHeadroom(thermal_model_->getCurrentTemperature()));
+    }
+    observed_switches_ = scheduler_->getContextSwitches();
+}
+
+bool SimulationEngine::saveSnapshotFile(const std::string& filename) const {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::vector<uint8_t> snapshot = saveSnapshot();
+    file.write(reinterpret_cast<const char*>(snapshot.data()), snapshot.size());
+    return static_cast<bool>(file);
+}
+
+bool SimulationEngine::restoreSnapshotFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::vector<uint8_t> snapshot((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    restoreSnapshot(snapshot);
+    return true;
 }
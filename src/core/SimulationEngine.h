@@ -4,9 +4,70 @@
 #include "scheduler/Scheduler.h"
 #include "models/EnergyModel.h"
 #include "models/ThermalModel.h"
+#include "core/ThermalGovernor.h"
+#include "core/IdleGovernor.h"
+#include "core/EnergyAttribution.h"
+#include "core/EventLog.h"
+#include "core/LiveMetrics.h"
+#include "core/PowerCapController.h"
+#include "core/WaitQueue.h"
+#include "core/LatencyHistogram.h"
 #include "tasks/Task.h"
 #include <vector>
 #include <memory>
+#include <cstdint>
+#include <string>
+
+// When a run ends once no work is left: immediately, at the fixed horizon,
+// or after a cool-down period following the last completion
+enum class EndCondition {
+    LAST_COMPLETION,
+    HORIZON,
+    DRAIN
+};
+
+// Per-task latency distributions in ticks, recorded as tasks complete
+struct LatencyStats {
+    LatencyHistogram turnaround;   // Arrival to completion
+    LatencyHistogram waiting;      // Time spent runnable in a ready queue
+    LatencyHistogram response;     // Arrival to first dispatch
+    
+    void record(const Task& task);
+    void merge(const LatencyStats& other);
+    void save(BinaryWriter& writer) const;
+    void load(BinaryReader& reader);
+    void reset();
+};
+
+// Overhead of switching a task onto the CPU: a fixed stall and energy for the
+// switch itself, then a cache refill stall that depends on the task's type.
+// The core draws the task's power during both stalls but makes no progress.
+struct ContextSwitchCost {
+    int latency_ticks = 0;
+    double energy_joules = 0.0;
+    int warmup_ticks[3] = {0, 0, 0};   // Indexed by TaskType
+    
+    int stallTicks(TaskType type) const { return latency_ticks + warmup_ticks[static_cast<int>(type)]; }
+};
+
+// Per-core activity of a multi-core run
+struct CoreStats {
+    std::string type;
+    int busy_ticks;
+    int tasks_dispatched;
+    double energy_joules;
+    double average_frequency_ghz;   // Over the busy ticks
+};
+
+// Time and energy of a multi-core run spent with a given number of cores
+// running tasks: one point of its power-versus-utilization curve
+struct UtilizationBin {
+    int busy_cores;
+    int ticks;
+    double energy_joules;
+    
+    double getAveragePower() const { return (ticks > 0) ? energy_joules / (ticks / 1000.0) : 0.0; }
+};
 
 struct SimulationStats {
     int total_tasks;
@@ -14,20 +75,95 @@ struct SimulationStats {
     double total_energy_joules;
     double average_power_watts;
     double peak_temperature_celsius;
+    int throttled_time_ticks;
+    int throttle_events;
+    double throughput_loss_percent;
+    int power_capped_ticks;           // Ticks with the power cap lowering frequency
+    double power_cap_loss_percent;    // Requested cycles removed by the power cap
+    int contended_ticks;              // Ticks with memory bandwidth oversubscribed (multi-core)
+    double contention_loss_percent;   // Work lost to memory bandwidth contention
+    double leakage_energy_joules;
+    double idle_energy_joules;
+    int wakeups;
+    int context_switches;
+    int preemptions;
+    int switch_overhead_ticks;        // Ticks stalled on context switches and cache refills
+    double switch_energy_joules;
+    bool cancelled;                   // Stopped early on request: the figures cover the run so far
+    std::vector<std::pair<std::string, int>> cstate_residency;  // Idle ticks per C-state
+    std::vector<CoreStats> cores;     // Empty for single-core runs
+    std::vector<UtilizationBin> power_curve;  // By busy core count, 0 to all; empty for single-core runs
+    std::vector<TypeEnergy> energy_by_type;   // Indexed by TaskType
+    LatencyStats latency;
     std::string scheduler_name;
     std::vector<Task> completed_tasks;
+    std::vector<TaskEnergy> task_energy;      // Parallel to completed_tasks
 };
 
 class SimulationEngine {
 public:
+    // Events between two updates of the live metrics
+    static const int kPublishEvents = 256;
+    
     SimulationEngine(std::unique_ptr<Scheduler> scheduler);
     
     // Run simulation with given tasks
     SimulationStats runSimulation(const std::vector<Task>& tasks, int max_time = 50000);
     
+    // Incremental execution: start a run, advance it, then collect the statistics.
+    // runUntil() stops at the first event boundary at or after the given time and
+    // returns false once the run has ended.
+    void start(const std::vector<Task>& tasks, int max_time = 50000);
+    bool runUntil(int time);
+    SimulationStats collectStats() const;
+    
+    // Open-ended runs fed from outside (a cluster dispatcher): submit() adds a
+    // task arriving at or after the current time, and advanceTo() stops exactly
+    // at the given time, splitting an idle gap there since more work may follow
+    void submit(const Task& task);
+    bool advanceTo(int time);
+    bool hasWork() const;
+    // Tasks not yet completed: in flight to the CPU, queued, running or blocked
+    int getOutstandingTasks() const;
+    bool isFinished() const { return finished_; }
+    int getCurrentTime() const { return current_time_; }
+    
+    // Snapshots of the full run state (engine, scheduler queues, task pool,
+    // thermal and energy state). Restoring into an engine whose scheduler has a
+    // different policy forks the run: the pending tasks are handed to the new
+    // scheduler in their saved dispatch order.
+    std::vector<uint8_t> saveSnapshot() const;
+    void restoreSnapshot(const std::vector<uint8_t>& snapshot);
+    bool saveSnapshotFile(const std::string& filename) const;
+    bool restoreSnapshotFile(const std::string& filename);
+    
     // Set models
     void setEnergyModel(std::unique_ptr<EnergyModel> energy_model);
     void setThermalModel(std::unique_ptr<ThermalModel> thermal_model);
+    void setThermalGovernor(std::unique_ptr<ThermalGovernor> governor);
+    ThermalGovernor& getThermalGovernor() { return *thermal_governor_; }
+    
+    // Package power budget enforced on top of thermal throttling (disabled by default)
+    void setPowerCap(const PowerCapController& controller) { power_cap_ = controller; }
+    
+    // I/O device serving blocking phases: parallel channels (0 = unlimited) and
+    // the fixed latency added to every request
+    void setIODevice(int channels, int latency_ticks);
+    
+    // Charged whenever the scheduler switches a task onto the CPU
+    void setContextSwitchCost(const ContextSwitchCost& cost) { switch_cost_ = cost; }
+    
+    // End-of-run semantics; cooldown_ticks applies to DRAIN
+    void setEndCondition(EndCondition condition, int cooldown_ticks = 1000);
+    
+    // Progress published every kPublishEvents events (not owned; null
+    // disables). A cancellation request ends the run at the next publication.
+    void setLiveMetrics(LiveMetrics* metrics) { metrics_ = metrics; }
+    bool isCancelled() const { return cancelled_; }
+    
+    // Scheduling events are recorded to the log when set (not owned; null
+    // disables). A throttling change is recorded at the next scheduling point.
+    void setEventLog(EventLogWriter* event_log) { event_log_ = event_log; }
     
     // Get current state
     double getCurrentPower() const;
@@ -40,13 +176,55 @@ private:
     std::unique_ptr<Scheduler> scheduler_;
     std::unique_ptr<EnergyModel> energy_model_;
     std::unique_ptr<ThermalModel> thermal_model_;
+    std::unique_ptr<ThermalGovernor> thermal_governor_;
+    IdleGovernor idle_governor_;
+    PowerCapController power_cap_;
+    
+    EndCondition end_condition_;
+    int cooldown_ticks_;
     
     int current_time_;
+    int max_time_;
+    bool finished_;
+    int last_completion_time_;
+    std::vector<Task> pending_arrivals_;  // Sorted by arrival time
+    size_t next_arrival_;
+    WaitQueue wait_queue_;          // Tasks off the CPU in an I/O phase
+    std::vector<Task> woken_tasks_;
     double total_energy_;
+    double leakage_energy_;
+    double idle_energy_;
+    double current_power_;
     std::vector<Task> completed_tasks_;
+    LatencyStats latency_;
+    EnergyAttribution attribution_;
+    ContextSwitchCost switch_cost_;
+    int observed_switches_;         // Scheduler switch count already charged
+    int switch_stall_;              // Stall ticks left before the running task progresses
+    int switch_overhead_ticks_;
+    double switch_energy_;
+    LiveMetrics* metrics_;
+    bool cancelled_;
+    int publish_countdown_;         // Events until progress is next published
+    EventLogWriter* event_log_;
+    int logged_task_;               // Task the log last saw dispatched, -1 if none
+    int logged_frequency_;          // MHz
+    bool logged_throttled_;
     
-    void executeTask(Task* task);
-    void updateModels(Task* task, int execution_time);
+    bool publishProgress();
+    void logScheduling(const Task* task, double frequency);
+    bool run(int time, bool exact);
+    void releaseArrivals();
+    Task* dispatchTask();
+    void completeTask(const Task& task, int end_time);
+    void chargeContextSwitch(const Task* task);
+    int nextEventTime(int max_time) const;
+    void advanceIdle(int ticks, int expected_idle, double requested_frequency, double thermal_frequency,
+                     double frequency);
+    void executeTask(Task* task, double frequency);
+    void updateModels(Task* task, int execution_time, double frequency);
+    void updateGovernors(Task* task, double requested_frequency, double thermal_frequency, double frequency,
+                         int elapsed);
 };
 
 #endif // SIMULATION_ENGINE_H
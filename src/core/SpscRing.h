@@ -0,0 +1,71 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Bounded lock-free queue between exactly one producer and one consumer
+// thread. Each side owns one index and caches the other's, so a push or pop
+// touches the shared cache line only when its cached view runs out; an item
+// costs a copy plus one release store.
+template <typename T>
+class SpscRing {
+public:
+    // The capacity is rounded up to a power of two
+    explicit SpscRing(size_t capacity) : head_(0), cached_tail_(0), tail_(0), cached_head_(0) {
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        slots_.resize(size);
+        mask_ = size - 1;
+    }
+    
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+    
+    // Producer; false when the ring is full
+    bool tryPush(const T& item) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head - cached_tail_ > mask_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head - cached_tail_ > mask_) {
+                return false;
+            }
+        }
+        slots_[head & mask_] = item;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+    
+    // Consumer; moves up to max items to out and returns how many
+    size_t popBatch(T* out, size_t max) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (cached_head_ == tail) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+        }
+        size_t count = cached_head_ - tail;
+        if (count > max) {
+            count = max;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = slots_[(tail + i) & mask_];
+        }
+        tail_.store(tail + count, std::memory_order_release);
+        return count;
+    }
+    
+    size_t capacity() const { return slots_.size(); }
+    
+private:
+    // Producer and consumer indices on separate cache lines
+    alignas(64) std::atomic<size_t> head_;
+    size_t cached_tail_;
+    alignas(64) std::atomic<size_t> tail_;
+    size_t cached_head_;
+    alignas(64) std::vector<T> slots_;
+    size_t mask_;
+};
+
+#endif // SPSC_RING_H
@@ -0,0 +1,82 @@
+#include "ThermalGovernor.h"
+#include "Serialization.h"
+#include <algorithm>
+
+ThermalGovernor::ThermalGovernor(double trip_temp, double release_temp, double throttle_frequency)
+    : trip_temp_(trip_temp), release_temp_(std::min(release_temp, trip_temp)),
+      throttle_frequency_(throttle_frequency), enabled_(true) {
+    reset();
+}
+
+double ThermalGovernor::limitFrequency(double requested_frequency) const {
+    if (enabled_ && throttled_) {
+        return std::min(requested_frequency, throttle_frequency_);
+    }
+    return requested_frequency;
+}
+
+void ThermalGovernor::update(double temperature, double requested_frequency, double applied_frequency,
+                             int elapsed_ticks, bool busy) {
+    if (throttled_) {
+        throttled_ticks_ += elapsed_ticks;
+    }
+    if (busy) {
+        requested_cycles_ += requested_frequency * elapsed_ticks;
+        lost_cycles_ += (requested_frequency - applied_frequency) * elapsed_ticks;
+    }
+    
+    if (!enabled_) {
+        throttled_ = false;
+        return;
+    }
+    
+    // Hysteresis: engage above the trip point, release only once cooled below release_temp_
+    if (!throttled_ && temperature > trip_temp_) {
+        throttled_ = true;
+        throttle_events_++;
+    } else if (throttled_ && temperature < release_temp_) {
+        throttled_ = false;
+    }
+}
+
+double ThermalGovernor::getThroughputLossPercent() const {
+    return (requested_cycles_ > 0.0) ? 100.0 * lost_cycles_ / requested_cycles_ : 0.0;
+}
+
+void ThermalGovernor::setParameters(double trip_temp, double release_temp, double throttle_frequency) {
+    trip_temp_ = trip_temp;
+    release_temp_ = std::min(release_temp, trip_temp);
+    throttle_frequency_ = throttle_frequency;
+}
+
+void ThermalGovernor::reset() {
+    throttled_ = false;
+    throttled_ticks_ = 0;
+    throttle_events_ = 0;
+    lost_cycles_ = 0.0;
+    requested_cycles_ = 0.0;
+}
+
+void ThermalGovernor::saveState(BinaryWriter& writer) const {
+    writer.writeDouble(trip_temp_);
+    writer.writeDouble(release_temp_);
+    writer.writeDouble(throttle_frequency_);
+    writer.writeBool(enabled_);
+    writer.writeBool(throttled_);
+    writer.writeInt(throttled_ticks_);
+    writer.writeInt(throttle_events_);
+    writer.writeDouble(lost_cycles_);
+    writer.writeDouble(requested_cycles_);
+}
+
+void ThermalGovernor::loadState(BinaryReader& reader) {
+    trip_temp_ = reader.readDouble();
+    release_temp_ = reader.readDouble();
+    throttle_frequency_ = reader.readDouble();
+    enabled_ = reader.readBool();
+    throttled_ = reader.readBool();
+    throttled_ticks_ = static_cast<int>(reader.readInt());
+    throttle_events_ = static_cast<int>(reader.readInt());
+    lost_cycles_ = reader.readDouble();
+    requested_cycles_ = reader.readDouble();
+}
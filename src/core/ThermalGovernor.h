@@ -0,0 +1,53 @@
+#ifndef THERMAL_GOVERNOR_H
+#define THERMAL_GOVERNOR_H
+
+class BinaryWriter;
+class BinaryReader;
+
+class ThermalGovernor {
+public:
+    ThermalGovernor(double trip_temp = 85.0, double release_temp = 80.0, double throttle_frequency = 0.8);
+    
+    // Cap a requested frequency (GHz) according to the current throttle state
+    double limitFrequency(double requested_frequency) const;
+    
+    // Update throttle state from the latest temperature (with hysteresis) and account
+    // the cycles lost over the elapsed ticks; busy is false while the CPU was idle
+    void update(double temperature, double requested_frequency, double applied_frequency,
+                int elapsed_ticks, bool busy);
+    
+    // Degrees below the trip point (negative when above it)
+    double getHeadroom(double temperature) const { return trip_temp_ - temperature; }
+    
+    bool isThrottled() const { return throttled_; }
+    int getThrottledTime() const { return throttled_ticks_; }
+    int getThrottleEvents() const { return throttle_events_; }
+    
+    // Lost cycles in megacycles (GHz * ms) and as a percentage of the requested cycles
+    double getLostCycles() const { return lost_cycles_; }
+    double getThroughputLossPercent() const;
+    
+    void setEnabled(bool enabled) { enabled_ = enabled; }
+    bool isEnabled() const { return enabled_; }
+    void setParameters(double trip_temp, double release_temp, double throttle_frequency);
+    
+    // Snapshot support
+    void saveState(BinaryWriter& writer) const;
+    void loadState(BinaryReader& reader);
+    
+    void reset();
+    
+private:
+    double trip_temp_;           // Temperature that engages throttling (°C)
+    double release_temp_;        // Temperature that releases throttling (°C)
+    double throttle_frequency_;  // Frequency cap while throttled (GHz)
+    bool enabled_;
+    
+    bool throttled_;
+    int throttled_ticks_;
+    int throttle_events_;
+    double lost_cycles_;
+    double requested_cycles_;
+};
+
+#endif // THERMAL_GOVERNOR_H
@@ -0,0 +1,237 @@
+#include "TimerWheel.h"
+#include <algorithm>
+
+TimerWheel::TimerWheel(int64_t start_time) {
+    reset(start_time);
+}
+
+void TimerWheel::reset(int64_t start_time) {
+    nodes_.clear();
+    free_nodes_.clear();
+    std::fill(heads_, heads_ + kDueList + 1, -1);
+    for (int level = 0; level < kLevels; ++level) {
+        std::fill(occupied_[level], occupied_[level] + kWords, 0);
+        level_counts_[level] = 0;
+    }
+    due_count_ = 0;
+    now_ = start_time;
+    next_sequence_ = 0;
+    size_ = 0;
+}
+
+TimerWheel::Handle TimerWheel::schedule(int64_t expiry, uint64_t payload) {
+    int32_t index;
+    if (!free_nodes_.empty()) {
+        index = free_nodes_.back();
+        free_nodes_.pop_back();
+    } else {
+        index = static_cast<int32_t>(nodes_.size());
+        nodes_.push_back(Node());
+        nodes_.back().generation = 0;
+    }
+    Node& node = nodes_[index];
+    node.expiry = expiry;
+    node.payload = payload;
+    node.sequence = next_sequence_++;
+    node.generation++;
+    link(index);
+    size_++;
+    return (static_cast<Handle>(node.generation) << 32) | static_cast<uint32_t>(index);
+}
+
+bool TimerWheel::cancel(Handle handle) {
+    uint32_t index = static_cast<uint32_t>(handle);
+    if (handle == kInvalidHandle || index >= nodes_.size()) {
+        return false;
+    }
+    Node& node = nodes_[index];
+    if (node.list < 0 || node.generation != static_cast<uint32_t>(handle >> 32)) {
+        return false;
+    }
+    unlink(index);
+    free_nodes_.push_back(index);
+    size_--;
+    return true;
+}
+
+void TimerWheel::advance(int64_t time, std::vector<uint64_t>& expired) {
+    fired_.clear();
+    collect(kDueList);
+    
+    while (now_ < time) {
+        if (level_counts_[0] == 0) {
+            // Nothing left in the current 256-tick block: jump to the next boundary
+            // where the lowest non-empty level cascades, or straight to time
+            int level = 1;
+            while (level < kLevels && level_counts_[level] == 0) {
+                level++;
+            }
+            if (level == kLevels) {
+                now_ = time;
+                break;
+            }
+            int64_t span = static_cast<int64_t>(1) << (kSlotBits * level);
+            int64_t boundary = (now_ / span + 1) * span;
+            if (boundary > time) {
+                now_ = time;
+                break;
+            }
+            now_ = boundary;
+        } else {
+            now_++;
+        }
+        
+        // Crossing a block boundary moves the next block down a level, highest level first
+        int top = 0;
+        while (top + 1 < kLevels && (now_ & ((static_cast<int64_t>(1) << (kSlotBits * (top + 1))) - 1)) == 0) {
+            top++;
+        }
+        for (int level = top; level >= 1; --level) {
+            cascade(level);
+        }
+        collect(static_cast<int>(now_ & (kSlots - 1)));
+        collect(kDueList);
+    }
+    
+    std::sort(fired_.begin(), fired_.end(), [this](int32_t a, int32_t b) {
+        if (nodes_[a].expiry != nodes_[b].expiry) {
+            return nodes_[a].expiry < nodes_[b].expiry;
+        }
+        return nodes_[a].sequence < nodes_[b].sequence;
+    });
+    for (int32_t index : fired_) {
+        expired.push_back(nodes_[index].payload);
+        free_nodes_.push_back(index);
+    }
+    size_ -= fired_.size();
+}
+
+int64_t TimerWheel::nextExpiry() const {
+    if (size_ == 0) {
+        return -1;
+    }
+    int64_t best = -1;
+    for (int32_t index = heads_[kDueList]; index >= 0; index = nodes_[index].next) {
+        if (best < 0 || nodes_[index].expiry < best) {
+            best = nodes_[index].expiry;
+        }
+    }
+    if (best >= 0) {
+        return best;
+    }
+    
+    // Lower levels always hold earlier timers than higher ones, so the first
+    // occupied slot of the lowest non-empty level contains the minimum
+    for (int level = 0; level < kLevels; ++level) {
+        if (level_counts_[level] == 0) {
+            continue;
+        }
+        int current = static_cast<int>((now_ >> (kSlotBits * level)) & (kSlots - 1));
+        int slot = firstOccupied(level, level == 0 ? current : current + 1);
+        if (slot < 0) {
+            // Far-future timers parked in the top level wrap around
+            slot = firstOccupied(level, 0);
+        }
+        for (int32_t index = heads_[level * kSlots + slot]; index >= 0; index = nodes_[index].next) {
+            if (best < 0 || nodes_[index].expiry < best) {
+                best = nodes_[index].expiry;
+            }
+        }
+        return best;
+    }
+    return best;
+}
+
+int TimerWheel::listFor(int64_t expiry) const {
+    if (expiry <= now_) {
+        return kDueList;
+    }
+    for (int level = 0; level < kLevels - 1; ++level) {
+        int shift = kSlotBits * (level + 1);
+        if ((expiry >> shift) == (now_ >> shift)) {
+            return level * kSlots + static_cast<int>((expiry >> (kSlotBits * level)) & (kSlots - 1));
+        }
+    }
+    return (kLevels - 1) * kSlots + static_cast<int>((expiry >> (kSlotBits * (kLevels - 1))) & (kSlots - 1));
+}
+
+void TimerWheel::link(int32_t index) {
+    Node& node = nodes_[index];
+    int list = listFor(node.expiry);
+    node.list = list;
+    node.prev = -1;
+    node.next = heads_[list];
+    if (heads_[list] >= 0) {
+        nodes_[heads_[list]].prev = index;
+    }
+    heads_[list] = index;
+    if (list == kDueList) {
+        due_count_++;
+    } else {
+        int level = list / kSlots;
+        int slot = list % kSlots;
+        occupied_[level][slot / 64] |= static_cast<uint64_t>(1) << (slot % 64);
+        level_counts_[level]++;
+    }
+}
+
+void TimerWheel::unlink(int32_t index) {
+    Node& node = nodes_[index];
+    int list = node.list;
+    if (node.prev >= 0) {
+        nodes_[node.prev].next = node.next;
+    } else {
+        heads_[list] = node.next;
+    }
+    if (node.next >= 0) {
+        nodes_[node.next].prev = node.prev;
+    }
+    node.list = -1;
+    if (list == kDueList) {
+        due_count_--;
+    } else {
+        int level = list / kSlots;
+        int slot = list % kSlots;
+        if (heads_[list] < 0) {
+            occupied_[level][slot / 64] &= ~(static_cast<uint64_t>(1) << (slot % 64));
+        }
+        level_counts_[level]--;
+    }
+}
+
+void TimerWheel::cascade(int level) {
+    int slot = static_cast<int>((now_ >> (kSlotBits * level)) & (kSlots - 1));
+    int list = level * kSlots + slot;
+    int32_t index = heads_[list];
+    moved_.clear();
+    while (index >= 0) {
+        int32_t next = nodes_[index].next;
+        unlink(index);
+        moved_.push_back(index);
+        index = next;
+    }
+    for (int32_t node : moved_) {
+        link(node);
+    }
+}
+
+void TimerWheel::collect(int list) {
+    int32_t index = heads_[list];
+    while (index >= 0) {
+        int32_t next = nodes_[index].next;
+        unlink(index);
+        fired_.push_back(index);
+        index = next;
+    }
+}
+
+int TimerWheel::firstOccupied(int level, int from) const {
+    for (int slot = from; slot < kSlots; ) {
+        uint64_t word = occupied_[level][slot / 64] >> (slot % 64);
+        if (word != 0) {
+            return slot + __builtin_ctzll(word);
+        }
+        slot = (slot / 64 + 1) * 64;
+    }
+    return -1;
+}
@@ -0,0 +1,73 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Hierarchical timing wheel with one-tick resolution: four levels of 256 slots,
+// timers kept in intrusive lists over a slab of nodes. Scheduling and cancelling
+// are O(1); advancing costs O(1) per expired timer plus one cascade per 256 ticks,
+// skipping empty stretches of time.
+class TimerWheel {
+public:
+    typedef uint64_t Handle;
+    static const Handle kInvalidHandle = ~static_cast<Handle>(0);
+    
+    explicit TimerWheel(int64_t start_time = 0);
+    
+    // Fire payload once the clock reaches expiry (timers already due fire on the next advance)
+    Handle schedule(int64_t expiry, uint64_t payload);
+    bool cancel(Handle handle);
+    
+    // Move the clock to time and append the payloads of every expired timer,
+    // ordered by expiry and then by scheduling order
+    void advance(int64_t time, std::vector<uint64_t>& expired);
+    
+    // Earliest pending expiry, or -1 when no timer is pending
+    int64_t nextExpiry() const;
+    
+    int64_t getTime() const { return now_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    
+    void reset(int64_t start_time = 0);
+
+private:
+    static const int kLevels = 4;
+    static const int kSlotBits = 8;
+    static const int kSlots = 1 << kSlotBits;
+    static const int kDueList = kLevels * kSlots;
+    static const int kWords = kSlots / 64;
+    
+    struct Node {
+        int64_t expiry;
+        uint64_t payload;
+        uint64_t sequence;
+        uint32_t generation;
+        int32_t prev;
+        int32_t next;
+        int32_t list;   // Owning list, -1 when free
+    };
+    
+    std::vector<Node> nodes_;
+    std::vector<int32_t> free_nodes_;
+    int32_t heads_[kDueList + 1];
+    uint64_t occupied_[kLevels][kWords];
+    size_t level_counts_[kLevels];
+    size_t due_count_;
+    int64_t now_;
+    uint64_t next_sequence_;
+    size_t size_;
+    std::vector<int32_t> fired_;    // Scratch buffers reused across advances
+    std::vector<int32_t> moved_;
+    
+    int listFor(int64_t expiry) const;
+    void link(int32_t index);
+    void unlink(int32_t index);
+    void cascade(int level);
+    void collect(int list);
+    int firstOccupied(int level, int from) const;
+};
+
+#endif // TIMER_WHEEL_H
@@ -0,0 +1,101 @@
+#include "WaitQueue.h"
+#include "Serialization.h"
+#include <algorithm>
+#include <functional>
+
+WaitQueue::WaitQueue(int channels, int latency_ticks)
+    : next_order_(0), channels_(0), latency_ticks_(0) {
+    configure(channels, latency_ticks);
+}
+
+void WaitQueue::configure(int channels, int latency_ticks) {
+    channels_ = std::max(0, channels);
+    latency_ticks_ = std::max(0, latency_ticks);
+    reset();
+}
+
+int WaitQueue::block(const Task& task, int now, int transfer_ticks) {
+    int start = now;
+    if (channels_ > 0) {
+        // The earliest free channel takes the request once it is done with its queue
+        std::pop_heap(channel_free_.begin(), channel_free_.end(), std::greater<int>());
+        start = std::max(now, channel_free_.back());
+        channel_free_.back() = start + latency_ticks_ + transfer_ticks;
+        std::push_heap(channel_free_.begin(), channel_free_.end(), std::greater<int>());
+    }
+    int wake_time = start + latency_ticks_ + transfer_ticks;
+    
+    uint32_t slot;
+    if (!free_entries_.empty()) {
+        slot = free_entries_.back();
+        free_entries_.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(entries_.size());
+        entries_.emplace_back();
+    }
+    entries_[slot] = {task, wake_time, next_order_++};
+    wheel_.schedule(wake_time, slot);
+    return wake_time;
+}
+
+void WaitQueue::release(int now, std::vector<Task>& woken) {
+    expired_.clear();
+    wheel_.advance(now, expired_);
+    for (uint64_t slot : expired_) {
+        woken.push_back(entries_[slot].task);
+        free_entries_.push_back(static_cast<uint32_t>(slot));
+    }
+}
+
+void WaitQueue::saveState(BinaryWriter& writer) const {
+    writer.writeInt(channels_);
+    writer.writeInt(latency_ticks_);
+    for (int free_time : channel_free_) {
+        writer.writeInt(free_time);
+    }
+    writer.writeInt(wheel_.getTime());
+    
+    // Pending entries in blocking order, so that restored ties break the same way
+    std::vector<const Entry*> pending;
+    std::vector<bool> is_free(entries_.size(), false);
+    for (uint32_t slot : free_entries_) {
+        is_free[slot] = true;
+    }
+    for (size_t slot = 0; slot < entries_.size(); ++slot) {
+        if (!is_free[slot]) {
+            pending.push_back(&entries_[slot]);
+        }
+    }
+    std::sort(pending.begin(), pending.end(), [](const Entry* a, const Entry* b) { return a->order < b->order; });
+    writer.writeUInt(pending.size());
+    for (const Entry* entry : pending) {
+        writer.writeInt(entry->wake_time);
+        entry->task.save(writer);
+    }
+}
+
+void WaitQueue::loadState(BinaryReader& reader) {
+    channels_ = static_cast<int>(reader.readInt());
+    latency_ticks_ = static_cast<int>(reader.readInt());
+    reset();
+    for (int& free_time : channel_free_) {
+        free_time = static_cast<int>(reader.readInt());
+    }
+    wheel_.reset(reader.readInt());
+    
+    size_t count = reader.readUInt();
+    for (size_t i = 0; i < count; ++i) {
+        int wake_time = static_cast<int>(reader.readInt());
+        Task task = Task::load(reader);
+        entries_.push_back({task, wake_time, next_order_++});
+        wheel_.schedule(wake_time, entries_.size() - 1);
+    }
+}
+
+void WaitQueue::reset() {
+    wheel_.reset();
+    entries_.clear();
+    free_entries_.clear();
+    next_order_ = 0;
+    channel_free_.assign(channels_, 0);
+}
@@ -0,0 +1,59 @@
+#ifndef WAIT_QUEUE_H
+#define WAIT_QUEUE_H
+
+#include "core/TimerWheel.h"
+#include "tasks/Task.h"
+#include <vector>
+#include <cstdint>
+
+class BinaryWriter;
+class BinaryReader;
+
+// Tasks blocked on a simulated I/O device. A request waits for one of the
+// device's channels (FIFO, 0 channels = unlimited), then takes the device
+// latency plus its own transfer ticks; completions come from a timer wheel.
+class WaitQueue {
+public:
+    WaitQueue(int channels = 0, int latency_ticks = 0);
+    
+    void configure(int channels, int latency_ticks);
+    int getChannels() const { return channels_; }
+    int getLatency() const { return latency_ticks_; }
+    
+    // Park a task for an I/O request issued at time now; returns its wake-up time
+    int block(const Task& task, int now, int transfer_ticks);
+    
+    // Append, in wake-up order, every task whose I/O has completed by time now
+    void release(int now, std::vector<Task>& woken);
+    
+    // Earliest pending wake-up, or -1 when nothing is blocked
+    int nextWakeTime() const { return static_cast<int>(wheel_.nextExpiry()); }
+    
+    bool empty() const { return wheel_.empty(); }
+    size_t size() const { return wheel_.size(); }
+    
+    // Snapshot support
+    void saveState(BinaryWriter& writer) const;
+    void loadState(BinaryReader& reader);
+    
+    void reset();
+    
+private:
+    struct Entry {
+        Task task;
+        int wake_time;
+        uint64_t order;      // Blocking order, which breaks wake-up ties
+    };
+    
+    TimerWheel wheel_;
+    std::vector<Entry> entries_;          // Slab indexed by timer payload
+    std::vector<uint32_t> free_entries_;
+    std::vector<uint64_t> expired_;
+    uint64_t next_order_;
+    
+    int channels_;
+    int latency_ticks_;
+    std::vector<int> channel_free_;       // Min-heap of times each channel frees up
+};
+
+#endif // WAIT_QUEUE_H
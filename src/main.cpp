@@ -3,16 +3,46 @@
 #include <vector>
 #include <memory>
 #include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+#include <filesystem>
 #include <iomanip>
 #include <fstream>
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <csignal>
 
 #include "core/SimulationEngine.h"
+#include "core/BatchSimulationEngine.h"
+#include "core/QuantumTuner.h"
+#include "core/AutoTuner.h"
+#include "core/MulticoreEngine.h"
+#include "cluster/ClusterSimulator.h"
 #include "scheduler/RoundRobinScheduler.h"
 #include "scheduler/PriorityScheduler.h"
 #include "scheduler/FCFSScheduler.h"
 #include "scheduler/DVFSScheduler.h"
+#include "scheduler/EnergyAwareScheduler.h"
+#include "scheduler/PerformanceScheduler.h"
+#include "scheduler/ContentionAwareScheduler.h"
+#include "scheduler/SlackScheduler.h"
+#include "scheduler/ConsolidationScheduler.h"
+#include "models/RCThermalModel.h"
+#include "plugin/PluginScheduler.h"
+#include "plugin/GovernedScheduler.h"
 #include "tasks/TaskGenerator.h"
 #include "output/ReportGenerator.h"
+#include "output/ResultCache.h"
+#include "output/MetricsPublisher.h"
+#include "core/Serialization.h"
+#include "core/EventLog.h"
+#include "server/SimulationServer.h"
+#include "server/SimulationClient.h"
 
 struct SimulationConfig {
     std::string scheduler_type = "RR";
@@ -24,12 +54,74 @@ struct SimulationConfig {
     int min_task_duration = 50;
     int max_task_duration = 500;
     bool verbose = false;
+    double throttle_temp = 85.0;
+    double throttle_release_temp = 80.0;
+    double throttle_frequency = 0.8;
+    std::string thermal_model = "lumped";
+    std::string thermal_integrator = "exp";
+    std::string power_policy = "balanced";
+    double arrival_interval = 0.0;
+    std::string end_condition = "drain";
+    int cooldown_ticks = 1000;
+    std::string snapshot_file = "";
+    int snapshot_at = 0;
+    std::string restore_file = "";
+    int warmup_ticks = 0;
+    std::string cache_dir = "";
+    int batch_seeds = 0;
+    std::string rng = "mt";
+    int generator_threads = 1;
+    int max_phases = 1;
+    int min_io_ticks = 5;
+    int max_io_ticks = 50;
+    int io_channels = 0;
+    int io_latency = 0;
+    int quantum = 10;
+    int switch_ticks = 0;
+    double switch_energy_uj = 0.0;
+    std::string cache_warmup = "0,0,0";   // Refill ticks for CPU, IO, MEMORY tasks
+    bool tune_quantum = false;
+    int tune_max_quantum = 1000;
+    int dvfs_high_load = 5;
+    int dvfs_max_load = 10;
+    double dvfs_margin = 10.0;
+    bool autotune = false;
+    int tune_generations = 6;
+    int tune_threads = 0;
+    std::string scheduler_plugin = "";
+    std::string plugin_options = "";
+    std::string governor_plugin = "";
+    std::string governor_options = "";
+    std::string core_layout = "";
+    double mem_bandwidth = 0.0;
+    int dag_parents = 0;
+    int dag_window = 16;
+    double dag_stretch = 1.0;
+    double consolidate_target = 0.8;
+    std::string metrics_destination = "";
+    int metrics_interval = 1000;
+    std::string event_log = "";
+    double power_cap = 0.0;
+    int cap_window = 100;
+    std::string cap_gains = "0.5,0.02,0";  // Proportional, integral (per tick) and derivative gains
+    int machines = 0;
+    std::string cluster_policy = "p2c";
+    int epoch_ticks = 10;
+    int cluster_threads = 0;
+    std::string serve_socket = "";
+    int server_workers = 0;
+    int server_queue = 16;
+    std::string connect_socket = "";
 };
 
 void printUsage(const char* program_name) {
     std::cout << "Usage: " << program_name << " [OPTIONS]\n";
     std::cout << "\nOptions:\n";
-    std::cout << "  --scheduler TYPE    Scheduler type: RR (Round-Robin), Priority, FCFS, DVFS\n";
+    std::cout << "  --scheduler TYPE    Scheduler type: RR (Round-Robin), Priority, FCFS, DVFS, plugin\n";
+    std::cout << "                      (with --cores: EAS (energy-aware placement), Performance,\n";
+    std::cout << "                      Contention (energy- and memory-bandwidth-aware placement),\n";
+    std::cout << "                      Slack (critical-path-aware DVFS for --dag),\n";
+    std::cout << "                      Consolidate (pack work and park idle cores))\n";
     std::cout << "  --tasks NUM         Number of tasks to simulate (default: 50)\n";
     std::cout << "  --duration TIME     Maximum simulation time in ticks (default: 10000)\n";
     std::cout << "  --output FILE       Output CSV file for results\n";
@@ -37,6 +129,63 @@ void printUsage(const char* program_name) {
     std::cout << "  --seed NUM          Random seed for task generation (default: 42)\n";
     std::cout << "  --min-duration NUM  Minimum task duration (default: 50)\n";
     std::cout << "  --max-duration NUM  Maximum task duration (default: 500)\n";
+    std::cout << "  --throttle-temp C   Thermal throttling trip temperature (default: 85)\n";
+    std::cout << "  --throttle-release C  Temperature that releases throttling (default: 80)\n";
+    std::cout << "  --throttle-freq GHZ Frequency cap while throttled (default: 0.8)\n";
+    std::cout << "  --thermal-model M   Thermal model: lumped, rc (default: lumped)\n";
+    std::cout << "  --thermal-integrator I  RC network integrator: euler, exp (default: exp)\n";
+    std::cout << "  --power-policy P    Power policy: balanced, race (race-to-idle), stretch (default: balanced)\n";
+    std::cout << "  --arrival-interval T  Mean Poisson inter-arrival time in ticks (default: 0, all at start)\n";
+    std::cout << "  --end MODE          End of run: last (last completion), horizon, drain (default: drain)\n";
+    std::cout << "  --cooldown TICKS    Cool-down after the last completion for --end drain (default: 1000)\n";
+    std::cout << "  --snapshot FILE     Save a snapshot of the run state to FILE (see --snapshot-at)\n";
+    std::cout << "  --snapshot-at TICK  Tick at which --snapshot is taken (default: 0)\n";
+    std::cout << "  --restore FILE      Resume a run from a snapshot (with another --scheduler: fork)\n";
+    std::cout << "  --warmup TICKS      With --compare, warm up once with --scheduler and fork every policy\n";
+    std::cout << "  --cache DIR         Reuse results of identical runs stored in DIR\n";
+    std::cout << "  --phases N          Split tasks into up to N compute phases with blocking I/O between\n";
+    std::cout << "  --io-min TICKS      Shortest I/O phase for --phases (default: 5)\n";
+    std::cout << "  --io-max TICKS      Longest I/O phase for --phases (default: 50)\n";
+    std::cout << "  --io-channels N     Parallel requests the I/O device serves, 0 = unlimited (default: 0)\n";
+    std::cout << "  --io-latency TICKS  Device latency added to every I/O phase (default: 0)\n";
+    std::cout << "  --quantum TICKS     Round-robin time quantum (default: 10)\n";
+    std::cout << "  --switch-cost TICKS Stall for every context switch (default: 0)\n";
+    std::cout << "  --switch-energy UJ  Energy of every context switch in microjoules (default: 0)\n";
+    std::cout << "  --cache-warmup C,I,M  Cache refill stall after a switch for CPU, IO and memory tasks\n";
+    std::cout << "  --tune-quantum MAX  Search the RR quantum in [1, MAX] minimising energy per task\n";
+    std::cout << "  --dvfs-load H,M     DVFS queue lengths switching to the high and maximum level (default: 5,10)\n";
+    std::cout << "  --dvfs-margin C     DVFS backs off this many degrees below the trip point (default: 10)\n";
+    std::cout << "  --autotune          Search --scheduler's parameters for the energy / latency Pareto front\n";
+    std::cout << "  --tune-generations N  CMA-ES generations per trade-off weighting (default: 6)\n";
+    std::cout << "  --tune-threads N    Parallel simulations during --autotune, 0 = all cores (default: 0)\n";
+    std::cout << "  --plugin FILE       Load a scheduler plugin (shared object) and select it\n";
+    std::cout << "  --plugin-options S  Option string passed to the scheduler plugin\n";
+    std::cout << "  --governor-plugin FILE  Let a governor plugin choose the frequency for any scheduler\n";
+    std::cout << "  --governor-options S  Option string passed to the governor plugin\n";
+    std::cout << "  --cores LAYOUT      Simulate a heterogeneous multi-core, e.g. big:2,little:4\n";
+    std::cout << "  --mem-bandwidth GBPS  Memory bandwidth shared by the --cores, 0 = unlimited (default: 0)\n";
+    std::cout << "  --dag PARENTS       With --cores, make tasks depend on up to PARENTS earlier tasks\n";
+    std::cout << "  --dag-window N      Parents are drawn from the N tasks before each task (default: 16)\n";
+    std::cout << "  --dag-stretch F     Slack deadline as a multiple of the critical path (default: 1)\n";
+    std::cout << "  --consolidate-target U  Utilization Consolidate keeps unparked cores at (default: 0.8)\n";
+    std::cout << "  --power-cap W       Hold the windowed package power under W by lowering frequency\n";
+    std::cout << "  --cap-window TICKS  Power-cap averaging window (default: 100)\n";
+    std::cout << "  --cap-gains P,I,D   Power-cap PID gains, I and D per tick (default: 0.5,0.02,0)\n";
+    std::cout << "  --machines N        Simulate a cluster of N machines behind a load balancer\n";
+    std::cout << "  --cluster-policy P  Balancer: random, least (least-loaded), p2c (power of two), energy\n";
+    std::cout << "                      (default: p2c; --compare runs all four)\n";
+    std::cout << "  --epoch TICKS       Cluster synchronization epoch and balancer lookahead (default: 10)\n";
+    std::cout << "  --cluster-threads N Host threads advancing machines, 0 = all cores (default: 0)\n";
+    std::cout << "  --serve SOCKET      Run as a daemon serving simulation jobs on a Unix socket\n";
+    std::cout << "  --server-workers N  Jobs the daemon runs in parallel, 0 = all cores (default: 0)\n";
+    std::cout << "  --server-queue N    Jobs admitted beyond the running ones before rejecting (default: 16)\n";
+    std::cout << "  --connect SOCKET    Run the other options as a job on a daemon and report locally\n";
+    std::cout << "  --metrics DEST      Publish live progress in Prometheus text format to a file, or - for stderr\n";
+    std::cout << "  --metrics-interval MS  Milliseconds between --metrics updates (default: 1000)\n";
+    std::cout << "  --event-log FILE    Record dispatch, preemption, completion, frequency and throttling events\n";
+    std::cout << "  --rng ENGINE        Workload RNG: mt (sequential), philox (counter-based) (default: mt)\n";
+    std::cout << "  --gen-threads N     Threads generating a philox workload; results do not depend on N\n";
+    std::cout << "  --batch-seeds N     Run N seeds (from --seed) per scheduler as one lockstep batch\n";
     std::cout << "  --verbose           Enable verbose output\n";
     std::cout << "  --help              Show this help message\n";
     std::cout << "\nExamples:\n";
@@ -64,6 +213,122 @@ SimulationConfig parseArguments(int argc, char* argv[]) {
             config.min_task_duration = std::stoi(argv[++i]);
         } else if (strcmp(argv[i], "--max-duration") == 0 && i + 1 < argc) {
             config.max_task_duration = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--throttle-temp") == 0 && i + 1 < argc) {
+            config.throttle_temp = std::stod(argv[++i]);
+        } else if (strcmp(argv[i], "--throttle-release") == 0 && i + 1 < argc) {
+            config.throttle_release_temp = std::stod(argv[++i]);
+        } else if (strcmp(argv[i], "--throttle-freq") == 0 && i + 1 < argc) {
+            config.throttle_frequency = std::stod(argv[++i]);
+        } else if (strcmp(argv[i], "--thermal-model") == 0 && i + 1 < argc) {
+            config.thermal_model = argv[++i];
+        } else if (strcmp(argv[i], "--thermal-integrator") == 0 && i + 1 < argc) {
+            config.thermal_integrator = argv[++i];
+        } else if (strcmp(argv[i], "--power-policy") == 0 && i + 1 < argc) {
+            config.power_policy = argv[++i];
+        } else if (strcmp(argv[i], "--arrival-interval") == 0 && i + 1 < argc) {
+            config.arrival_interval = std::stod(argv[++i]);
+        } else if (strcmp(argv[i], "--end") == 0 && i + 1 < argc) {
+            config.end_condition = argv[++i];
+        } else if (strcmp(argv[i], "--cooldown") == 0 && i + 1 < argc) {
+            config.cooldown_ticks = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--snapshot") == 0 && i + 1 < argc) {
+            config.snapshot_file = argv[++i];
+        } else if (strcmp(argv[i], "--snapshot-at") == 0 && i + 1 < argc) {
+            config.snapshot_at = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--restore") == 0 && i + 1 < argc) {
+            config.restore_file = argv[++i];
+        } else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+            config.warmup_ticks = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--cache") == 0 && i + 1 < argc) {
+            config.cache_dir = argv[++i];
+        } else if (strcmp(argv[i], "--phases") == 0 && i + 1 < argc) {
+            config.max_phases = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--io-min") == 0 && i + 1 < argc) {
+            config.min_io_ticks = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--io-max") == 0 && i + 1 < argc) {
+            config.max_io_ticks = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--io-channels") == 0 && i + 1 < argc) {
+            config.io_channels = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--io-latency") == 0 && i + 1 < argc) {
+            config.io_latency = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--quantum") == 0 && i + 1 < argc) {
+            config.quantum = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--switch-cost") == 0 && i + 1 < argc) {
+            config.switch_ticks = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--switch-energy") == 0 && i + 1 < argc) {
+            config.switch_energy_uj = std::stod(argv[++i]);
+        } else if (strcmp(argv[i], "--cache-warmup") == 0 && i + 1 < argc) {
+            config.cache_warmup = argv[++i];
+        } else if (strcmp(argv[i], "--tune-quantum") == 0 && i + 1 < argc) {
+            config.tune_quantum = true;
+            config.tune_max_quantum = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--dvfs-load") == 0 && i + 1 < argc) {
+            if (std::sscanf(argv[++i], "%d,%d", &config.dvfs_high_load, &config.dvfs_max_load) != 2) {
+                throw std::invalid_argument("--dvfs-load expects HIGH,MAX");
+            }
+        } else if (strcmp(argv[i], "--dvfs-margin") == 0 && i + 1 < argc) {
+            config.dvfs_margin = std::stod(argv[++i]);
+        } else if (strcmp(argv[i], "--autotune") == 0) {
+            config.autotune = true;
+        } else if (strcmp(argv[i], "--tune-generations") == 0 && i + 1 < argc) {
+            config.tune_generations = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--tune-threads") == 0 && i + 1 < argc) {
+            config.tune_threads = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--plugin") == 0 && i + 1 < argc) {
+            config.scheduler_plugin = argv[++i];
+            config.scheduler_type = "plugin";
+        } else if (strcmp(argv[i], "--plugin-options") == 0 && i + 1 < argc) {
+            config.plugin_options = argv[++i];
+        } else if (strcmp(argv[i], "--governor-plugin") == 0 && i + 1 < argc) {
+            config.governor_plugin = argv[++i];
+        } else if (strcmp(argv[i], "--governor-options") == 0 && i + 1 < argc) {
+            config.governor_options = argv[++i];
+        } else if (strcmp(argv[i], "--cores") == 0 && i + 1 < argc) {
+            config.core_layout = argv[++i];
+        } else if (strcmp(argv[i], "--mem-bandwidth") == 0 && i + 1 < argc) {
+            config.mem_bandwidth = std::stod(argv[++i]);
+        } else if (strcmp(argv[i], "--dag") == 0 && i + 1 < argc) {
+            config.dag_parents = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--dag-window") == 0 && i + 1 < argc) {
+            config.dag_window = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--dag-stretch") == 0 && i + 1 < argc) {
+            config.dag_stretch = std::stod(argv[++i]);
+        } else if (strcmp(argv[i], "--metrics") == 0 && i + 1 < argc) {
+            config.metrics_destination = argv[++i];
+        } else if (strcmp(argv[i], "--metrics-interval") == 0 && i + 1 < argc) {
+            config.metrics_interval = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--event-log") == 0 && i + 1 < argc) {
+            config.event_log = argv[++i];
+        } else if (strcmp(argv[i], "--consolidate-target") == 0 && i + 1 < argc) {
+            config.consolidate_target = std::stod(argv[++i]);
+        } else if (strcmp(argv[i], "--power-cap") == 0 && i + 1 < argc) {
+            config.power_cap = std::stod(argv[++i]);
+        } else if (strcmp(argv[i], "--cap-window") == 0 && i + 1 < argc) {
+            config.cap_window = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--cap-gains") == 0 && i + 1 < argc) {
+            config.cap_gains = argv[++i];
+        } else if (strcmp(argv[i], "--machines") == 0 && i + 1 < argc) {
+            config.machines = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--cluster-policy") == 0 && i + 1 < argc) {
+            config.cluster_policy = argv[++i];
+        } else if (strcmp(argv[i], "--epoch") == 0 && i + 1 < argc) {
+            config.epoch_ticks = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--cluster-threads") == 0 && i + 1 < argc) {
+            config.cluster_threads = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--serve") == 0 && i + 1 < argc) {
+            config.serve_socket = argv[++i];
+        } else if (strcmp(argv[i], "--server-workers") == 0 && i + 1 < argc) {
+            config.server_workers = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--server-queue") == 0 && i + 1 < argc) {
+            config.server_queue = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--connect") == 0 && i + 1 < argc) {
+            config.connect_socket = argv[++i];
+        } else if (strcmp(argv[i], "--rng") == 0 && i + 1 < argc) {
+            config.rng = argv[++i];
+        } else if (strcmp(argv[i], "--gen-threads") == 0 && i + 1 < argc) {
+            config.generator_threads = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--batch-seeds") == 0 && i + 1 < argc) {
+            config.batch_seeds = std::stoi(argv[++i]);
         } else if (strcmp(argv[i], "--verbose") == 0) {
             config.verbose = true;
         } else if (strcmp(argv[i], "--help") == 0) {
@@ -74,46 +339,776 @@ SimulationConfig parseArguments(int argc, char* argv[]) {
     return config;
 }
 
-std::unique_ptr<Scheduler> createScheduler(const std::string& type) {
+std::unique_ptr<Scheduler> createScheduler(const SimulationConfig& config, const std::string& type) {
     if (type == "RR") {
-        return std::make_unique<RoundRobinScheduler>(10);
+        return std::make_unique<RoundRobinScheduler>(config.quantum);
     } else if (type == "Priority") {
         return std::make_unique<PriorityScheduler>(true);
     } else if (type == "FCFS") {
         return std::make_unique<FCFSScheduler>();
+    } else if (type == "plugin") {
+        if (config.scheduler_plugin.empty()) {
+            throw std::runtime_error("--scheduler plugin requires --plugin FILE");
+        }
+        return std::make_unique<PluginScheduler>(PluginLibrary::open(config.scheduler_plugin), config.plugin_options);
     } else if (type == "DVFS") {
-        return std::make_unique<DVFSScheduler>();
+        return std::make_unique<DVFSScheduler>(config.dvfs_high_load, config.dvfs_max_load, config.dvfs_margin);
     }
     
     // Default to Round-Robin
-    return std::make_unique<RoundRobinScheduler>(10);
+    return std::make_unique<RoundRobinScheduler>(config.quantum);
 }
 
-SimulationStats runSingleSimulation(const SimulationConfig& config, const std::string& scheduler_type) {
-    if (config.verbose) {
-        std::cout << "Running simulation with " << scheduler_type << " scheduler..." << std::endl;
+std::unique_ptr<Scheduler> createConfiguredScheduler(const SimulationConfig& config, const std::string& scheduler_type) {
+    auto scheduler = createScheduler(config, scheduler_type);
+    if (config.power_policy == "race") {
+        scheduler->setPowerPolicy(PowerPolicy::RACE_TO_IDLE);
+    } else if (config.power_policy == "stretch") {
+        scheduler->setPowerPolicy(PowerPolicy::STRETCH);
     }
-    
-    // Create scheduler
-    auto scheduler = createScheduler(scheduler_type);
-    
+    if (!config.governor_plugin.empty()) {
+        scheduler = std::make_unique<GovernedScheduler>(std::move(scheduler), PluginLibrary::open(config.governor_plugin),
+                                                        config.governor_options);
+    }
+    return scheduler;
+}
+
+// Policies run by --compare: the built-ins plus a loaded scheduler plugin, or
+// the placement policies for a multi-core layout (plus the contention-aware
+// one when memory bandwidth is limited and the slack-aware one for DAGs)
+std::vector<std::string> getComparedSchedulers(const SimulationConfig& config) {
+    if (!config.core_layout.empty()) {
+        std::vector<std::string> schedulers = {"EAS", "Performance", "Consolidate"};
+        if (config.mem_bandwidth > 0.0) {
+            schedulers.push_back("Contention");
+        }
+        if (config.dag_parents > 0) {
+            schedulers.push_back("Slack");
+        }
+        return schedulers;
+    }
+    std::vector<std::string> schedulers = {"RR", "Priority", "FCFS", "DVFS"};
+    if (!config.scheduler_plugin.empty()) {
+        schedulers.push_back("plugin");
+    }
+    return schedulers;
+}
+
+ContextSwitchCost createSwitchCost(const SimulationConfig& config) {
+    ContextSwitchCost cost;
+    cost.latency_ticks = config.switch_ticks;
+    cost.energy_joules = config.switch_energy_uj * 1e-6;
+    if (std::sscanf(config.cache_warmup.c_str(), "%d,%d,%d", &cost.warmup_ticks[0], &cost.warmup_ticks[1],
+                    &cost.warmup_ticks[2]) != 3) {
+        throw std::runtime_error("--cache-warmup expects three tick counts: CPU,IO,MEMORY");
+    }
+    return cost;
+}
+
+PowerCapController createPowerCap(const SimulationConfig& config) {
+    double kp = 0.0, ki = 0.0, kd = 0.0;
+    if (std::sscanf(config.cap_gains.c_str(), "%lf,%lf,%lf", &kp, &ki, &kd) != 3) {
+        throw std::runtime_error("--cap-gains expects three gains: P,I,D");
+    }
+    return PowerCapController(config.power_cap, config.cap_window, kp, ki, kd);
+}
+
+std::unique_ptr<SimulationEngine> createEngine(const SimulationConfig& config, const std::string& scheduler_type) {
     // Create simulation engine
-    SimulationEngine engine(std::move(scheduler));
+    auto engine = std::make_unique<SimulationEngine>(createConfiguredScheduler(config, scheduler_type));
+    engine->setThermalGovernor(std::make_unique<ThermalGovernor>(config.throttle_temp,
+                                                                 config.throttle_release_temp,
+                                                                 config.throttle_frequency));
+    if (config.thermal_model == "rc") {
+        auto integrator = (config.thermal_integrator == "euler") ? RCThermalModel::Integrator::EULER
+                                                                 : RCThermalModel::Integrator::EXPONENTIAL;
+        engine->setThermalModel(std::make_unique<RCThermalModel>(1, 25.0, integrator));
+    }
     
-    // Generate tasks
-    TaskGenerator generator(config.seed);
+    engine->setIODevice(config.io_channels, config.io_latency);
+    engine->setContextSwitchCost(createSwitchCost(config));
+    engine->setPowerCap(createPowerCap(config));
+    
+    if (config.end_condition == "last") {
+        engine->setEndCondition(EndCondition::LAST_COMPLETION);
+    } else if (config.end_condition == "horizon") {
+        engine->setEndCondition(EndCondition::HORIZON);
+    } else {
+        engine->setEndCondition(EndCondition::DRAIN, config.cooldown_ticks);
+    }
+    return engine;
+}
+
+std::vector<Task> generateWorkload(const SimulationConfig& config) {
+    TaskGenerator generator(config.seed, config.rng == "philox" ? RandomEngine::COUNTER : RandomEngine::SEQUENTIAL);
+    generator.setArrivalInterval(config.arrival_interval);
+    generator.setPhaseProfile(config.max_phases, config.min_io_ticks, config.max_io_ticks);
     auto tasks = generator.generateTasks(config.num_tasks, 
                                        config.min_task_duration, 
-                                       config.max_task_duration);
+                                       config.max_task_duration,
+                                       config.generator_threads);
     
     if (config.verbose) {
         std::cout << "Generated " << tasks.size() << " tasks" << std::endl;
     }
-    
-    // Run simulation
+    return tasks;
+}
+
+std::unique_ptr<PlacementScheduler> createPlacementScheduler(const SimulationConfig& config, const std::string& type) {
+    std::unique_ptr<PlacementScheduler> scheduler;
+    if (type == "Performance") {
+        scheduler = std::make_unique<PerformanceScheduler>();
+    } else if (type == "Slack") {
+        scheduler = std::make_unique<SlackScheduler>(config.dag_stretch);
+    } else if (type == "Consolidate") {
+        scheduler = std::make_unique<ConsolidationScheduler>(config.dvfs_margin, config.consolidate_target);
+    } else if (type == "Contention") {
+        scheduler = std::make_unique<ContentionAwareScheduler>(MemoryBandwidthModel(config.mem_bandwidth),
+                                                               config.dvfs_margin);
+    } else {
+        // Default to energy-aware placement
+        scheduler = std::make_unique<EnergyAwareScheduler>(config.dvfs_margin);
+    }
+    if (config.power_policy == "race") {
+        scheduler->setPowerPolicy(PowerPolicy::RACE_TO_IDLE);
+    } else if (config.power_policy == "stretch") {
+        scheduler->setPowerPolicy(PowerPolicy::STRETCH);
+    }
+    return scheduler;
+}
+
+// Event log of one run, or null without --event-log. Compared runs write one
+// log per scheduler: "events.bin" -> "events_RR.bin".
+std::unique_ptr<EventLogWriter> openEventLog(const SimulationConfig& config, const std::string& scheduler_type) {
+    if (config.event_log.empty()) {
+        return nullptr;
+    }
+    std::string file = config.event_log;
+    if (config.compare_schedulers) {
+        size_t dot_pos = file.find_last_of('.');
+        size_t slash_pos = file.find_last_of('/');
+        if (dot_pos != std::string::npos && (slash_pos == std::string::npos || dot_pos > slash_pos)) {
+            file.insert(dot_pos, "_" + scheduler_type);
+        } else {
+            file += "_" + scheduler_type;
+        }
+    }
+    if (config.verbose) {
+        std::cout << "Recording scheduling events to: " << file << std::endl;
+    }
+    return std::make_unique<EventLogWriter>(file);
+}
+
+SimulationStats runMulticoreSimulation(const SimulationConfig& config, const std::string& scheduler_type,
+                                       const std::vector<Task>& tasks, LiveMetrics* metrics = nullptr) {
+    Platform platform = Platform::parse(config.core_layout);
+    MulticoreEngine engine(platform, createPlacementScheduler(config, scheduler_type));
+    engine.setLiveMetrics(metrics);
+    std::unique_ptr<EventLogWriter> event_log = openEventLog(config, scheduler_type);
+    engine.setEventLog(event_log.get());
+    engine.setThermalGovernor(std::make_unique<ThermalGovernor>(config.throttle_temp, config.throttle_release_temp,
+                                                                config.throttle_frequency));
+    if (config.thermal_model == "rc") {
+        auto integrator = (config.thermal_integrator == "euler") ? RCThermalModel::Integrator::EULER
+                                                                 : RCThermalModel::Integrator::EXPONENTIAL;
+        engine.setCoreThermalModel(
+            std::make_unique<RCThermalModel>(platform.getCoreCount(), 25.0, integrator));
+    }
+    engine.setIODevice(config.io_channels, config.io_latency);
+    engine.setPowerCap(createPowerCap(config));
+    engine.setMemoryBandwidth(MemoryBandwidthModel(config.mem_bandwidth));
+    if (config.dag_parents > 0) {
+        TaskGenerator generator(config.seed, RandomEngine::COUNTER);
+        engine.setTaskGraph(std::make_shared<TaskGraph>(
+            generator.generateDependencies(config.num_tasks, config.dag_parents, config.dag_window)));
+    }
+    if (config.end_condition == "last") {
+        engine.setEndCondition(EndCondition::LAST_COMPLETION);
+    } else if (config.end_condition == "horizon") {
+        engine.setEndCondition(EndCondition::HORIZON);
+    } else {
+        engine.setEndCondition(EndCondition::DRAIN, config.cooldown_ticks);
+    }
     return engine.runSimulation(tasks, config.simulation_duration);
 }
 
+// metrics, when given, receives the run's progress and may cancel it
+SimulationStats runSingleSimulation(const SimulationConfig& config, const std::string& scheduler_type,
+                                    LiveMetrics* metrics = nullptr) {
+    if (config.verbose) {
+        std::cout << "Running simulation with " << scheduler_type << " scheduler..." << std::endl;
+    }
+    if (!config.core_layout.empty()) {
+        return runMulticoreSimulation(config, scheduler_type, generateWorkload(config), metrics);
+    }
+    
+    auto engine = createEngine(config, scheduler_type);
+    engine->setLiveMetrics(metrics);
+    std::unique_ptr<EventLogWriter> event_log = openEventLog(config, scheduler_type);
+    engine->setEventLog(event_log.get());
+    
+    if (!config.restore_file.empty()) {
+        // Resume (or fork, if the scheduler differs) from a saved snapshot
+        if (!engine->restoreSnapshotFile(config.restore_file)) {
+            throw std::runtime_error("cannot read snapshot " + config.restore_file);
+        }
+        engine->runUntil(std::numeric_limits<int>::max());
+        return engine->collectStats();
+    }
+    
+    engine->start(generateWorkload(config), config.simulation_duration);
+    if (!config.snapshot_file.empty()) {
+        engine->runUntil(config.snapshot_at);
+        if (!engine->saveSnapshotFile(config.snapshot_file)) {
+            throw std::runtime_error("cannot write snapshot " + config.snapshot_file);
+        }
+        if (config.verbose) {
+            std::cout << "Snapshot at tick " << engine->getCurrentTime()
+                      << " saved to: " << config.snapshot_file << std::endl;
+        }
+    }
+    engine->runUntil(config.simulation_duration);
+    return engine->collectStats();
+}
+
+std::vector<uint8_t> runWarmup(const SimulationConfig& config) {
+    if (config.verbose) {
+        std::cout << "Warming up with " << config.scheduler_type << " scheduler for "
+                  << config.warmup_ticks << " ticks..." << std::endl;
+    }
+    auto engine = createEngine(config, config.scheduler_type);
+    engine->start(generateWorkload(config), config.simulation_duration);
+    engine->runUntil(config.warmup_ticks);
+    return engine->saveSnapshot();
+}
+
+SimulationStats runForkedSimulation(const SimulationConfig& config, const std::string& scheduler_type,
+                                    const std::vector<uint8_t>& snapshot, LiveMetrics* metrics = nullptr) {
+    if (config.verbose) {
+        std::cout << "Forking " << scheduler_type << " scheduler from warm-up snapshot..." << std::endl;
+    }
+    auto engine = createEngine(config, scheduler_type);
+    engine->setLiveMetrics(metrics);
+    std::unique_ptr<EventLogWriter> event_log = openEventLog(config, scheduler_type);
+    engine->setEventLog(event_log.get());
+    engine->restoreSnapshot(snapshot);
+    engine->runUntil(config.simulation_duration);
+    return engine->collectStats();
+}
+
+// Seed sweep: every (scheduler, seed) pair becomes one lane of a lockstep batch
+std::vector<SimulationStats> runBatchSweep(const SimulationConfig& config, const std::vector<std::string>& schedulers) {
+    if (config.thermal_model != "lumped") {
+        throw std::runtime_error("--batch-seeds requires the lumped thermal model");
+    }
+    if (config.power_cap > 0.0) {
+        throw std::runtime_error("--batch-seeds does not support --power-cap");
+    }
+    BatchSimulationEngine batch;
+    batch.setThermalGovernor(ThermalGovernor(config.throttle_temp, config.throttle_release_temp,
+                                             config.throttle_frequency));
+    batch.setIODevice(config.io_channels, config.io_latency);
+    batch.setContextSwitchCost(createSwitchCost(config));
+    if (config.end_condition == "last") {
+        batch.setEndCondition(EndCondition::LAST_COMPLETION);
+    } else if (config.end_condition == "horizon") {
+        batch.setEndCondition(EndCondition::HORIZON);
+    } else {
+        batch.setEndCondition(EndCondition::DRAIN, config.cooldown_ticks);
+    }
+    
+    std::vector<unsigned int> lane_seeds;
+    for (const auto& sched : schedulers) {
+        for (int i = 0; i < config.batch_seeds; ++i) {
+            SimulationConfig lane_config = config;
+            lane_config.seed = config.seed + i;
+            batch.addLane(createConfiguredScheduler(lane_config, sched), generateWorkload(lane_config),
+                          config.simulation_duration);
+            lane_seeds.push_back(lane_config.seed);
+        }
+    }
+    if (config.verbose) {
+        std::cout << "Running " << batch.getLaneCount() << " lanes in lockstep ("
+                  << BatchSimulationEngine::getInstructionSet() << " kernels)..." << std::endl;
+    }
+    
+    std::vector<SimulationStats> results = batch.run();
+    for (size_t i = 0; i < results.size(); ++i) {
+        results[i].scheduler_name += " (seed " + std::to_string(lane_seeds[i]) + ")";
+    }
+    return results;
+}
+
+// Fleet run: every machine is a fully configured single-CPU engine, and the
+// balancer's pack limit and thermal margin follow the DVFS load and margin
+SimulationStats runClusterSimulation(const SimulationConfig& config, const std::string& policy,
+                                     const std::vector<Task>& tasks, std::ostream& out) {
+    LoadBalancer balancer(LoadBalancer::parsePolicy(policy), config.seed, config.dvfs_high_load, config.dvfs_margin);
+    ClusterSimulator cluster(config.machines, [&config](int) { return createEngine(config, config.scheduler_type); },
+                             balancer, config.epoch_ticks, static_cast<size_t>(std::max(0, config.cluster_threads)));
+    
+    auto started = std::chrono::steady_clock::now();
+    SimulationStats stats = cluster.run(tasks, config.simulation_duration);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    out << stats.scheduler_name << ": " << cluster.getMachineCount() << " machines, " << cluster.getEpochs()
+              << " epochs of " << config.epoch_ticks << " ticks on " << cluster.getThreadCount() << " threads in "
+              << std::fixed << std::setprecision(2) << seconds << " s" << std::endl;
+    return stats;
+}
+
+// Canonical description of everything that determines a run's result: the
+// workload parameters plus a snapshot of the freshly configured engine, which
+// captures the scheduler and all model parameters
+std::string makeCacheKey(const SimulationConfig& config, const std::string& scheduler_type) {
+    BinaryWriter writer;
+    writer.writeString(scheduler_type);
+    writer.writeInt(config.num_tasks);
+    writer.writeInt(config.simulation_duration);
+    writer.writeUInt(config.seed);
+    writer.writeInt(config.min_task_duration);
+    writer.writeInt(config.max_task_duration);
+    writer.writeDouble(config.arrival_interval);
+    writer.writeString(config.rng);
+    writer.writeInt(config.max_phases);
+    writer.writeInt(config.min_io_ticks);
+    writer.writeInt(config.max_io_ticks);
+    writer.writeString(config.end_condition);
+    writer.writeInt(config.cooldown_ticks);
+    writer.writeString(config.power_policy);
+    writer.writeString(config.thermal_model);
+    writer.writeString(config.thermal_integrator);
+    writer.writeInt(config.warmup_ticks);
+    writer.writeString(config.warmup_ticks > 0 ? config.scheduler_type : "");
+    // Plugins are identified by path, modification time and size, plus their options
+    for (const std::string& plugin : {scheduler_type == "plugin" ? config.scheduler_plugin : std::string(),
+                                      config.governor_plugin}) {
+        writer.writeString(plugin);
+        if (!plugin.empty()) {
+            writer.writeInt(std::filesystem::last_write_time(plugin).time_since_epoch().count());
+            writer.writeUInt(std::filesystem::file_size(plugin));
+        }
+    }
+    writer.writeString(scheduler_type == "plugin" ? config.plugin_options : "");
+    writer.writeString(config.governor_options);
+    writer.writeString(config.core_layout);
+    writer.writeDouble(config.mem_bandwidth);
+    writer.writeInt(config.dag_parents);
+    writer.writeInt(config.dag_window);
+    writer.writeDouble(config.dag_stretch);
+    writer.writeDouble(config.consolidate_target);
+    // Multi-core runs take the thermal, governor and device settings from the
+    // same configuration, but place with their own policy
+    if (!config.core_layout.empty()) {
+        createPlacementScheduler(config, scheduler_type)->saveParameters(writer);
+    }
+    writer.writeBytes(createEngine(config, scheduler_type)->saveSnapshot());
+    return ResultCache::makeKey(writer.getBuffer());
+}
+
+// Quantum search: every candidate replays the same workload under round-robin;
+// returns the statistics of the best quantum
+SimulationStats runQuantumTuning(const SimulationConfig& config, ResultCache* cache) {
+    QuantumTuner tuner([&](int quantum) {
+        SimulationConfig trial_config = config;
+        trial_config.quantum = quantum;
+        if (config.verbose) {
+            std::cout << "Simulating quantum " << quantum << "..." << std::endl;
+        }
+        SimulationStats stats;
+        std::string key = cache ? makeCacheKey(trial_config, "RR") : "";
+        if (!cache || !cache->lookup(key, stats)) {
+            stats = runSingleSimulation(trial_config, "RR");
+            if (cache) {
+                cache->store(key, stats);
+            }
+        }
+        return stats;
+    }, 1, config.tune_max_quantum);
+    
+    int best = tuner.tune();
+    ReportGenerator::printQuantumTuning(tuner.getTrials(), best);
+    return tuner.getBest().stats;
+}
+
+// Search space for --autotune: shared policy and thermal parameters plus the
+// chosen scheduler's own
+std::vector<TunerDimension> createTuningSpace(const std::string& scheduler_type) {
+    std::vector<TunerDimension> space = {
+        {"power_policy", 0, 2, true, false, {"balanced", "race", "stretch"}},
+        {"throttle_temp", 70.0, 95.0, false, false, {}},
+    };
+    if (scheduler_type == "RR") {
+        space.push_back({"quantum", 1, 500, true, true, {}});
+    } else if (scheduler_type == "DVFS") {
+        space.push_back({"high_load", 1, 20, true, false, {}});
+        space.push_back({"max_load_gap", 1, 20, true, false, {}});
+        space.push_back({"thermal_margin", 0.0, 30.0, false, false, {}});
+    }
+    return space;
+}
+
+SimulationConfig applyTunedParameters(const SimulationConfig& config, const std::vector<TunerDimension>& space,
+                                      const AutoTuner::Point& params) {
+    static const char* const kPolicies[] = {"balanced", "race", "stretch"};
+    SimulationConfig tuned = config;
+    for (size_t i = 0; i < space.size(); ++i) {
+        const std::string& name = space[i].name;
+        if (name == "power_policy") {
+            tuned.power_policy = kPolicies[static_cast<int>(params[i])];
+        } else if (name == "throttle_temp") {
+            tuned.throttle_temp = params[i];
+            tuned.throttle_release_temp = params[i] - (config.throttle_temp - config.throttle_release_temp);
+        } else if (name == "quantum") {
+            tuned.quantum = static_cast<int>(params[i]);
+        } else if (name == "high_load") {
+            tuned.dvfs_high_load = static_cast<int>(params[i]);
+        } else if (name == "max_load_gap") {
+            tuned.dvfs_max_load = tuned.dvfs_high_load + static_cast<int>(params[i]);
+        } else if (name == "thermal_margin") {
+            tuned.dvfs_margin = params[i];
+        }
+    }
+    return tuned;
+}
+
+// Parameter search: shortened runs scale the task count with the duration so
+// that the offered load stays the same
+void runAutoTune(const SimulationConfig& config) {
+    std::vector<TunerDimension> space = createTuningSpace(config.scheduler_type);
+    AutoTuner::Options options;
+    options.generations = config.tune_generations;
+    options.threads = static_cast<size_t>(std::max(0, config.tune_threads));
+    options.seed = config.seed;
+    
+    AutoTuner tuner(space, [&config, &space](const AutoTuner::Point& params, double fidelity) {
+        SimulationConfig trial = applyTunedParameters(config, space, params);
+        trial.verbose = false;
+        trial.num_tasks = std::max(1, static_cast<int>(std::lround(config.num_tasks * fidelity)));
+        trial.simulation_duration = std::max(1, static_cast<int>(std::lround(config.simulation_duration * fidelity)));
+        auto engine = createEngine(trial, trial.scheduler_type);
+        engine->start(generateWorkload(trial), trial.simulation_duration);
+        engine->runUntil(trial.simulation_duration);
+        return engine->collectStats();
+    }, options);
+    
+    if (config.verbose) {
+        std::cout << "Tuning " << space.size() << " parameters of " << config.scheduler_type << "..." << std::endl;
+    }
+    tuner.run();
+    
+    std::vector<AutoTuner::Candidate> front = tuner.getParetoFront();
+    ReportGenerator::printParetoFront(space, front);
+    std::cout << "Simulations: " << tuner.getSimulationCount() << " (" << std::fixed << std::setprecision(1)
+              << tuner.getFullRunEquivalents() << " full-run equivalents)" << std::endl;
+    if (!config.output_file.empty()) {
+        if (ReportGenerator::generateParetoCSV(space, front, config.output_file)) {
+            std::cout << "Pareto front saved to: " << config.output_file << std::endl;
+        }
+    }
+}
+
+// Combinations of run modes that cannot work together
+void validateConfig(const SimulationConfig& config) {
+    if (config.machines > 0 &&
+        (!config.core_layout.empty() || !config.snapshot_file.empty() || !config.restore_file.empty() ||
+         config.warmup_ticks > 0 || config.batch_seeds > 0 || config.autotune || config.tune_quantum)) {
+        throw std::invalid_argument("--machines cannot be combined with --cores, snapshots, warm-up, batches "
+                                    "or tuning");
+    }
+    if (!config.core_layout.empty() &&
+        (!config.snapshot_file.empty() || !config.restore_file.empty() || config.warmup_ticks > 0 ||
+         config.batch_seeds > 0 || config.autotune || config.tune_quantum)) {
+        throw std::invalid_argument("--cores cannot be combined with snapshots, warm-up, batches or tuning");
+    }
+    if (!config.core_layout.empty() &&
+        (config.switch_ticks > 0 || config.switch_energy_uj > 0.0 || config.cache_warmup != "0,0,0")) {
+        throw std::invalid_argument("--switch-cost, --switch-energy and --cache-warmup apply to single-core runs "
+                                    "only, not --cores");
+    }
+    if ((config.mem_bandwidth > 0.0 || config.dag_parents > 0) && config.core_layout.empty()) {
+        throw std::invalid_argument("--mem-bandwidth and --dag require --cores");
+    }
+    if (config.dag_window < 1) {
+        throw std::invalid_argument("--dag-window must be at least 1");
+    }
+    if (config.consolidate_target <= 0.0 || config.consolidate_target > 1.0) {
+        throw std::invalid_argument("--consolidate-target must be in (0, 1]");
+    }
+    if (!config.metrics_destination.empty() &&
+        (config.machines > 0 || config.batch_seeds > 0 || config.autotune || config.tune_quantum ||
+         !config.serve_socket.empty() || !config.connect_socket.empty())) {
+        throw std::invalid_argument("--metrics covers single and compared runs only, not clusters, batches, "
+                                    "tuning or the daemon");
+    }
+    if (!config.event_log.empty() &&
+        (config.machines > 0 || config.batch_seeds > 0 || config.autotune || config.tune_quantum ||
+         !config.serve_socket.empty() || !config.connect_socket.empty())) {
+        throw std::invalid_argument("--event-log covers single and compared runs only, not clusters, batches, "
+                                    "tuning or the daemon");
+    }
+    if (config.metrics_interval <= 0) {
+        throw std::invalid_argument("--metrics-interval must be positive");
+    }
+}
+
+// Progress of the local simulation in flight. The first SIGINT or SIGTERM
+// cancels it cooperatively, so the partial results are still reported; the
+// handler then reverts to the default and a second signal terminates.
+LiveMetrics live_metrics;
+
+void cancelSimulation(int) {
+    live_metrics.requestCancel();
+}
+
+void installCancelHandler() {
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = cancelSimulation;
+    action.sa_flags = SA_RESETHAND;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+}
+
+// Output file next to the --output one: "results.csv" -> "results_tasks.csv"
+std::string siblingFile(const std::string& output_file, const std::string& suffix) {
+    std::string file = output_file;
+    size_t dot_pos = file.find_last_of('.');
+    if (dot_pos != std::string::npos) {
+        file.insert(dot_pos, suffix);
+    } else {
+        file += suffix + ".csv";
+    }
+    return file;
+}
+
+// Power-versus-utilization curves of multi-core runs next to the summary CSV
+void savePowerCurves(const SimulationConfig& config, const std::vector<SimulationStats>& results) {
+    if (config.output_file.empty() ||
+        std::none_of(results.begin(), results.end(),
+                     [](const SimulationStats& stats) { return !stats.power_curve.empty(); })) {
+        return;
+    }
+    std::string curve_file = siblingFile(config.output_file, "_power");
+    if (ReportGenerator::generatePowerCurveCSV(results, curve_file)) {
+        std::cout << "Power curves saved to: " << curve_file << std::endl;
+    }
+}
+
+// Summary CSV of a single run plus the detailed task CSV next to it
+void saveSingleResult(const SimulationConfig& config, const SimulationStats& stats) {
+    if (config.output_file.empty()) {
+        return;
+    }
+    if (ReportGenerator::generateCSVReport(stats, config.output_file)) {
+        std::cout << "Results saved to: " << config.output_file << std::endl;
+    }
+    
+    std::string task_file = siblingFile(config.output_file, "_tasks");
+    if (ReportGenerator::generateTaskCSV(stats, task_file)) {
+        std::cout << "Task details saved to: " << task_file << std::endl;
+    }
+    savePowerCurves(config, {stats});
+}
+
+// Daemon state shared by the jobs of one server process. Generated workloads
+// are cached across requests; configured engines are kept per worker thread
+// and restarted for every run, which resets them to their initial state.
+const size_t kMaxCachedWorkloads = 64;
+const size_t kMaxPooledEngines = 16;
+
+std::mutex workload_cache_mutex;
+std::map<std::string, std::shared_ptr<const std::vector<Task>>> workload_cache;
+
+std::shared_ptr<const std::vector<Task>> getCachedWorkload(const SimulationConfig& config) {
+    BinaryWriter writer;
+    writer.writeUInt(config.seed);
+    writer.writeInt(config.num_tasks);
+    writer.writeInt(config.min_task_duration);
+    writer.writeInt(config.max_task_duration);
+    writer.writeDouble(config.arrival_interval);
+    writer.writeString(config.rng);
+    writer.writeInt(config.max_phases);
+    writer.writeInt(config.min_io_ticks);
+    writer.writeInt(config.max_io_ticks);
+    std::string key(writer.getBuffer().begin(), writer.getBuffer().end());
+    {
+        std::lock_guard<std::mutex> lock(workload_cache_mutex);
+        auto cached = workload_cache.find(key);
+        if (cached != workload_cache.end()) {
+            return cached->second;
+        }
+    }
+    
+    // Generated outside the lock; a concurrent miss on the same key just duplicates work
+    auto tasks = std::make_shared<const std::vector<Task>>(generateWorkload(config));
+    std::lock_guard<std::mutex> lock(workload_cache_mutex);
+    if (workload_cache.size() >= kMaxCachedWorkloads) {
+        workload_cache.clear();
+    }
+    workload_cache.emplace(key, tasks);
+    return tasks;
+}
+
+// Everything createEngine reads, so equal keys give interchangeable engines
+SimulationEngine& getPooledEngine(const SimulationConfig& config, const std::string& scheduler_type) {
+    thread_local std::map<std::string, std::unique_ptr<SimulationEngine>> engines;
+    
+    BinaryWriter writer;
+    writer.writeString(scheduler_type);
+    writer.writeInt(config.quantum);
+    writer.writeString(config.power_policy);
+    writer.writeInt(config.dvfs_high_load);
+    writer.writeInt(config.dvfs_max_load);
+    writer.writeDouble(config.dvfs_margin);
+    writer.writeString(config.scheduler_plugin);
+    writer.writeString(config.plugin_options);
+    writer.writeString(config.governor_plugin);
+    writer.writeString(config.governor_options);
+    writer.writeDouble(config.throttle_temp);
+    writer.writeDouble(config.throttle_release_temp);
+    writer.writeDouble(config.throttle_frequency);
+    writer.writeString(config.thermal_model);
+    writer.writeString(config.thermal_integrator);
+    writer.writeInt(config.io_channels);
+    writer.writeInt(config.io_latency);
+    writer.writeInt(config.switch_ticks);
+    writer.writeDouble(config.switch_energy_uj);
+    writer.writeString(config.cache_warmup);
+    writer.writeDouble(config.power_cap);
+    writer.writeInt(config.cap_window);
+    writer.writeString(config.cap_gains);
+    writer.writeString(config.end_condition);
+    writer.writeInt(config.cooldown_ticks);
+    std::string key(writer.getBuffer().begin(), writer.getBuffer().end());
+    
+    auto pooled = engines.find(key);
+    if (pooled == engines.end()) {
+        if (engines.size() >= kMaxPooledEngines) {
+            engines.clear();
+        }
+        pooled = engines.emplace(key, createEngine(config, scheduler_type)).first;
+    }
+    return *pooled->second;
+}
+
+SimulationStats runServedSimulation(const SimulationConfig& config, const std::string& scheduler_type) {
+    std::shared_ptr<const std::vector<Task>> tasks = getCachedWorkload(config);
+    if (!config.core_layout.empty()) {
+        return runMulticoreSimulation(config, scheduler_type, *tasks);
+    }
+    SimulationEngine& engine = getPooledEngine(config, scheduler_type);
+    engine.start(*tasks, config.simulation_duration);
+    engine.runUntil(config.simulation_duration);
+    return engine.collectStats();
+}
+
+// One daemon job: the request is a command line, parsed as if given locally.
+// Every run is streamed back as soon as it finishes; reports and files are
+// left to the client.
+void serveJob(const std::vector<std::string>& args, SimulationServer::JobStream& stream) {
+    std::vector<std::string> arguments = {"powerprofile"};
+    arguments.insert(arguments.end(), args.begin(), args.end());
+    std::vector<char*> argv;
+    for (auto& argument : arguments) {
+        argv.push_back(&argument[0]);
+    }
+    SimulationConfig config = parseArguments(static_cast<int>(argv.size()), argv.data());
+    config.verbose = false;
+    config.output_file = "";
+    if (!config.serve_socket.empty() || !config.connect_socket.empty() || !config.snapshot_file.empty() ||
+        !config.restore_file.empty() || config.warmup_ticks > 0 || config.batch_seeds > 0 || config.autotune ||
+        config.tune_quantum) {
+        throw std::invalid_argument("the server does not run snapshot, warm-up, batch or tuning jobs");
+    }
+    validateConfig(config);
+    
+    if (config.machines > 0) {
+        std::vector<std::string> policies = {config.cluster_policy};
+        if (config.compare_schedulers) {
+            policies = {"random", "least", "p2c", "energy"};
+        }
+        std::shared_ptr<const std::vector<Task>> tasks = getCachedWorkload(config);
+        for (const auto& policy : policies) {
+            std::ostringstream progress;
+            SimulationStats stats = runClusterSimulation(config, policy, *tasks, progress);
+            stream.sendText(progress.str());
+            stream.sendStats(stats);
+        }
+        return;
+    }
+    
+    std::unique_ptr<ResultCache> cache;
+    if (!config.cache_dir.empty()) {
+        cache = std::make_unique<ResultCache>(config.cache_dir);
+    }
+    std::vector<std::string> schedulers = {config.scheduler_type};
+    if (config.compare_schedulers) {
+        schedulers = getComparedSchedulers(config);
+    }
+    for (const auto& sched : schedulers) {
+        if (!stream.isOpen()) {
+            return;
+        }
+        SimulationStats stats;
+        std::string key = cache ? makeCacheKey(config, sched) : "";
+        if (!cache || !cache->lookup(key, stats)) {
+            stats = runServedSimulation(config, sched);
+            if (cache) {
+                cache->store(key, stats);
+            }
+        }
+        stream.sendStats(stats);
+    }
+}
+
+void runServer(const SimulationConfig& config) {
+    SimulationServer server(config.serve_socket, serveJob, static_cast<size_t>(std::max(0, config.server_workers)),
+                            static_cast<size_t>(std::max(0, config.server_queue)));
+    std::cout << "Serving on " << config.serve_socket << " with " << server.getWorkerCount()
+              << " workers (queue " << config.server_queue << ")" << std::endl;
+    server.run();
+    std::cout << "Served " << server.getJobsServed() << " jobs, rejected " << server.getJobsRejected()
+              << std::endl;
+}
+
+// Send the command line (minus --connect) to a daemon and report the streamed
+// results as a local run would
+void runClient(const SimulationConfig& config, int argc, char* argv[]) {
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--connect") == 0 && i + 1 < argc) {
+            i++;
+        } else {
+            args.push_back(argv[i]);
+        }
+    }
+    
+    std::vector<SimulationStats> results;
+    SimulationClient client(config.connect_socket);
+    client.run(args, [&](const SimulationStats& stats) {
+        results.push_back(stats);
+        if (config.verbose) {
+            ReportGenerator::printConsoleReport(stats);
+        }
+    }, [](const std::string& text) {
+        std::cout << text;
+    });
+    
+    if (results.size() == 1 && !config.compare_schedulers) {
+        ReportGenerator::printConsoleReport(results[0]);
+        saveSingleResult(config, results[0]);
+    } else if (!results.empty()) {
+        ReportGenerator::compareResults(results);
+        if (!config.output_file.empty()) {
+            if (ReportGenerator::generateComparisonCSV(results, config.output_file)) {
+                std::cout << "Comparison results saved to: " << config.output_file << std::endl;
+            }
+        }
+        savePowerCurves(config, results);
+    }
+}
+
 int main(int argc, char* argv[]) {    
     SimulationConfig config = parseArguments(argc, argv);
     
@@ -124,66 +1119,132 @@ int main(int argc, char* argv[]) {
     }
     
     try {
-        if (config.compare_schedulers) {
+        validateConfig(config);
+        
+        if (!config.connect_socket.empty()) {
+            runClient(config, argc, argv);
+            return 0;
+        } else if (!config.serve_socket.empty()) {
+            runServer(config);
+            return 0;
+        }
+        
+        installCancelHandler();
+        std::unique_ptr<MetricsPublisher> publisher;
+        if (!config.metrics_destination.empty()) {
+            publisher = std::make_unique<MetricsPublisher>(live_metrics, config.metrics_destination,
+                                                           config.metrics_interval);
+        }
+        
+        // Runs that read or write snapshots are not cached
+        std::unique_ptr<ResultCache> cache;
+        if (!config.cache_dir.empty() && config.snapshot_file.empty() && config.restore_file.empty()) {
+            cache = std::make_unique<ResultCache>(config.cache_dir);
+        }
+        
+        if (config.machines > 0) {
+            std::vector<std::string> policies = {config.cluster_policy};
+            if (config.compare_schedulers) {
+                policies = {"random", "least", "p2c", "energy"};
+            }
+            std::vector<Task> tasks = generateWorkload(config);
+            std::vector<SimulationStats> results;
+            for (const auto& policy : policies) {
+                results.push_back(runClusterSimulation(config, policy, tasks, std::cout));
+            }
+            if (results.size() > 1) {
+                ReportGenerator::compareResults(results);
+            } else {
+                ReportGenerator::printConsoleReport(results[0]);
+            }
+            if (!config.output_file.empty()) {
+                if (ReportGenerator::generateComparisonCSV(results, config.output_file)) {
+                    std::cout << "Cluster results saved to: " << config.output_file << std::endl;
+                }
+            }
+        } else if (config.autotune) {
+            runAutoTune(config);
+        } else if (config.tune_quantum) {
+            SimulationStats stats = runQuantumTuning(config, cache.get());
+            ReportGenerator::printConsoleReport(stats);
+            if (!config.output_file.empty()) {
+                if (ReportGenerator::generateCSVReport(stats, config.output_file)) {
+                    std::cout << "Results saved to: " << config.output_file << std::endl;
+                }
+            }
+        } else if (config.batch_seeds > 0) {
+            std::vector<std::string> schedulers = {config.scheduler_type};
+            if (config.compare_schedulers) {
+                schedulers = getComparedSchedulers(config);
+            }
+            std::vector<SimulationStats> results = runBatchSweep(config, schedulers);
+            ReportGenerator::compareResults(results);
+            if (!config.output_file.empty()) {
+                if (ReportGenerator::generateComparisonCSV(results, config.output_file)) {
+                    std::cout << "Sweep results saved to: " << config.output_file << std::endl;
+                }
+            }
+        } else if (config.compare_schedulers) {
             // Compare all schedulers
-            std::vector<std::string> schedulers = {"RR", "Priority", "FCFS", "DVFS"};
+            std::vector<std::string> schedulers = getComparedSchedulers(config);
             std::vector<SimulationStats> results;
             
+            // With a warm-up, every policy branches from one shared warmed-up state,
+            // simulated only when some policy is not already cached
+            std::vector<uint8_t> warm_snapshot;
+            
             for (const auto& sched : schedulers) {
-                auto stats = runSingleSimulation(config, sched);
+                SimulationStats stats;
+                std::string key = cache ? makeCacheKey(config, sched) : "";
+                if (!cache || !cache->lookup(key, stats)) {
+                    if (config.warmup_ticks > 0 && warm_snapshot.empty()) {
+                        warm_snapshot = runWarmup(config);
+                    }
+                    stats = warm_snapshot.empty() ? runSingleSimulation(config, sched, &live_metrics)
+                                                  : runForkedSimulation(config, sched, warm_snapshot, &live_metrics);
+                    if (cache && !stats.cancelled) {
+                        cache->store(key, stats);
+                    }
+                }
                 results.push_back(stats);
                 
                 if (config.verbose) {
                     ReportGenerator::printConsoleReport(stats);
                 }
+                // A cancelled comparison reports the policies run so far
+                if (stats.cancelled) {
+                    break;
+                }
             }
             
             ReportGenerator::compareResults(results);
             
             // Save comparison to CSV if requested
             if (!config.output_file.empty()) {
-                std::ofstream comp_file(config.output_file);
-                if (comp_file.is_open()) {
-                    comp_file << "scheduler,total_tasks,completed_tasks,execution_time_ticks,total_energy_J,average_power_W,peak_temp_C\n";
-                    for (const auto& stat : results) {
-                        comp_file << stat.scheduler_name << ","
-                                 << stat.total_tasks << ","
-                                 << stat.completed_tasks.size() << ","
-                                 << stat.total_execution_time << ","
-                                 << std::fixed << std::setprecision(6) << stat.total_energy_joules << ","
-                                 << std::fixed << std::setprecision(3) << stat.average_power_watts << ","
-                                 << std::fixed << std::setprecision(2) << stat.peak_temperature_celsius << "\n";
-                    }
-                    comp_file.close();
+                if (ReportGenerator::generateComparisonCSV(results, config.output_file)) {
                     std::cout << "Comparison results saved to: " << config.output_file << std::endl;
                 }
             }
+            savePowerCurves(config, results);
         } else {
             // Single scheduler simulation
-            auto stats = runSingleSimulation(config, config.scheduler_type);
+            SimulationStats stats;
+            std::string key = cache ? makeCacheKey(config, config.scheduler_type) : "";
+            if (!cache || !cache->lookup(key, stats)) {
+                stats = runSingleSimulation(config, config.scheduler_type, &live_metrics);
+                if (cache && !stats.cancelled) {
+                    cache->store(key, stats);
+                }
+            }
             
             // Print results
             ReportGenerator::printConsoleReport(stats);
-            
-            // Save to CSV if requested
-            if (!config.output_file.empty()) {
-                if (ReportGenerator::generateCSVReport(stats, config.output_file)) {
-                    std::cout << "Results saved to: " << config.output_file << std::endl;
-                }
-                
-                // Also save detailed task CSV
-                std::string task_file = config.output_file;
-                size_t dot_pos = task_file.find_last_of('.');
-                if (dot_pos != std::string::npos) {
-                    task_file.insert(dot_pos, "_tasks");
-                } else {
-                    task_file += "_tasks.csv";
-                }
-                
-                if (ReportGenerator::generateTaskCSV(stats, task_file)) {
-                    std::cout << "Task details saved to: " << task_file << std::endl;
-                }
-            }
+            saveSingleResult(config, stats);
+        }
+        
+        if (cache) {
+            std::cout << "Result cache: " << cache->getHits() << " hits, "
+                      << cache->getMisses() << " simulated" << std::endl;
         }
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
@@ -0,0 +1,175 @@
+#include "CoreType.h"
+#include "core/Serialization.h"
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+CoreType::CoreType(const std::string& name, const std::vector<OperatingPoint>& levels,
+                   const double capacitance[kTaskTypes], const double ipc[kTaskTypes], double leakage_power_watts)
+    : name_(name), levels_(levels), leakage_power_(leakage_power_watts) {
+    if (levels_.empty()) {
+        throw std::invalid_argument("core type " + name + " needs at least one operating point");
+    }
+    for (int type = 0; type < kTaskTypes; ++type) {
+        capacitance_[type] = capacitance[type];
+        ipc_[type] = ipc[type];
+    }
+    buildTables();
+}
+
+CoreType CoreType::big() {
+    // Matches the reference core at 1 GHz-class voltages and extends the ladder upwards
+    const double capacitance[kTaskTypes] = {1.2e-9, 0.6e-9, 0.9e-9};
+    const double ipc[kTaskTypes] = {1.0, 1.0, 1.0};
+    return CoreType("big", {{0.8, 0.80}, {1.2, 0.90}, {1.6, 1.00}, {2.0, 1.10}, {2.4, 1.20}},
+                    capacitance, ipc, 0.02);
+}
+
+CoreType CoreType::little() {
+    // Narrow in-order pipeline: a fraction of the switched capacitance, and
+    // compute-bound work loses the most per cycle
+    const double capacitance[kTaskTypes] = {0.35e-9, 0.2e-9, 0.3e-9};
+    const double ipc[kTaskTypes] = {0.55, 0.8, 0.7};
+    return CoreType("little", {{0.4, 0.60}, {0.6, 0.65}, {0.8, 0.70}, {1.0, 0.80}, {1.2, 0.90}, {1.4, 1.00}},
+                    capacitance, ipc, 0.005);
+}
+
+CoreType CoreType::preset(const std::string& name) {
+    if (name == "big") {
+        return big();
+    } else if (name == "little") {
+        return little();
+    }
+    throw std::invalid_argument("unknown core type: " + name);
+}
+
+int CoreType::levelAtOrBelow(double frequency_ghz) const {
+    int level = 0;
+    for (int i = 1; i < getLevelCount(); ++i) {
+        if (levels_[i].frequency_ghz <= frequency_ghz) {
+            level = i;
+        }
+    }
+    return level;
+}
+
+void CoreType::buildTables() {
+    size_t count = levels_.size();
+    speed_.assign(kTaskTypes * count, 0.0);
+    dynamic_power_.assign(kTaskTypes * count, 0.0);
+    energy_per_work_.assign(kTaskTypes * count, 0.0);
+    static_power_.assign(count, 0.0);
+    
+    for (size_t level = 0; level < count; ++level) {
+        static_power_[level] = leakage_power_ * levels_[level].voltage / getMaxVoltage();
+    }
+    for (int type = 0; type < kTaskTypes; ++type) {
+        for (size_t level = 0; level < count; ++level) {
+            double frequency = levels_[level].frequency_ghz;
+            double voltage = levels_[level].voltage;
+            size_t i = type * count + level;
+            speed_[i] = ipc_[type] * frequency;
+            dynamic_power_[i] = capacitance_[type] * voltage * voltage * frequency * 1e9;
+            energy_per_work_[i] = (dynamic_power_[i] + static_power_[level]) / 1000.0 / speed_[i];
+        }
+    }
+    
+    for (int urgency = 0; urgency < kUrgencyLevels; ++urgency) {
+        for (int type = 0; type < kTaskTypes; ++type) {
+            double best = std::numeric_limits<double>::infinity();
+            int best_level = 0;
+            for (size_t level = 0; level < count; ++level) {
+                size_t i = type * count + level;
+                double cost = energy_per_work_[i] * std::pow(1.0 / speed_[i], urgency);
+                if (cost < best) {
+                    best = cost;
+                    best_level = static_cast<int>(level);
+                }
+            }
+            best_level_[urgency * kTaskTypes + type] = best_level;
+            best_cost_[urgency * kTaskTypes + type] = best;
+        }
+    }
+}
+
+void CoreType::saveState(BinaryWriter& writer) const {
+    writer.writeString(name_);
+    writer.writeUInt(levels_.size());
+    for (const auto& level : levels_) {
+        writer.writeDouble(level.frequency_ghz);
+        writer.writeDouble(level.voltage);
+    }
+    for (int type = 0; type < kTaskTypes; ++type) {
+        writer.writeDouble(capacitance_[type]);
+        writer.writeDouble(ipc_[type]);
+    }
+    writer.writeDouble(leakage_power_);
+}
+
+void CoreType::loadState(BinaryReader& reader) {
+    name_ = reader.readString();
+    levels_.resize(reader.readUInt());
+    for (auto& level : levels_) {
+        level.frequency_ghz = reader.readDouble();
+        level.voltage = reader.readDouble();
+    }
+    for (int type = 0; type < kTaskTypes; ++type) {
+        capacitance_[type] = reader.readDouble();
+        ipc_[type] = reader.readDouble();
+    }
+    leakage_power_ = reader.readDouble();
+    buildTables();
+}
+
+Platform Platform::parse(const std::string& layout) {
+    Platform platform;
+    std::stringstream stream(layout);
+    std::string entry;
+    while (std::getline(stream, entry, ',')) {
+        size_t colon = entry.find(':');
+        std::string name = entry.substr(0, colon);
+        int count = (colon == std::string::npos) ? 1 : std::stoi(entry.substr(colon + 1));
+        if (count < 0) {
+            throw std::invalid_argument("negative core count in layout: " + layout);
+        }
+        
+        int type = -1;
+        for (size_t i = 0; i < platform.types.size(); ++i) {
+            if (platform.types[i].getName() == name) {
+                type = static_cast<int>(i);
+            }
+        }
+        if (type < 0) {
+            platform.types.push_back(CoreType::preset(name));
+            type = static_cast<int>(platform.types.size()) - 1;
+        }
+        platform.cores.insert(platform.cores.end(), count, type);
+    }
+    if (platform.cores.empty()) {
+        throw std::invalid_argument("core layout has no cores: " + layout);
+    }
+    return platform;
+}
+
+void Platform::saveState(BinaryWriter& writer) const {
+    writer.writeUInt(types.size());
+    for (const auto& type : types) {
+        type.saveState(writer);
+    }
+    writer.writeUInt(cores.size());
+    for (int type : cores) {
+        writer.writeInt(type);
+    }
+}
+
+void Platform::loadState(BinaryReader& reader) {
+    types.resize(reader.readUInt());
+    for (auto& type : types) {
+        type.loadState(reader);
+    }
+    cores.resize(reader.readUInt());
+    for (int& type : cores) {
+        type = static_cast<int>(reader.readInt());
+    }
+}
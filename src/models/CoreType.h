@@ -0,0 +1,104 @@
+#ifndef CORE_TYPE_H
+#define CORE_TYPE_H
+
+#include "tasks/Task.h"
+#include <string>
+#include <vector>
+
+class BinaryWriter;
+class BinaryReader;
+
+// One DVFS level of a core type
+struct OperatingPoint {
+    double frequency_ghz;
+    double voltage;
+};
+
+// Descriptor of one kind of core in a heterogeneous (big.LITTLE) system: its
+// own frequency/voltage table, and per task type the effective switched
+// capacitance and the work retired per cycle relative to the 1 GHz reference.
+// Power, speed and energy per unit of work are tabulated for every (task type,
+// level) pair when the descriptor is built, so placement only does lookups.
+class CoreType {
+public:
+    static const int kTaskTypes = 3;
+    // Delay exponents for which the best level is tabulated, see getBestLevel()
+    static const int kUrgencyLevels = 4;
+    
+    CoreType() : leakage_power_(0.0) {}
+    CoreType(const std::string& name, const std::vector<OperatingPoint>& levels,
+             const double capacitance[kTaskTypes], const double ipc[kTaskTypes], double leakage_power_watts);
+    
+    // Presets: an out-of-order performance core and an in-order efficiency core
+    static CoreType big();
+    static CoreType little();
+    static CoreType preset(const std::string& name);
+    
+    const std::string& getName() const { return name_; }
+    int getLevelCount() const { return static_cast<int>(levels_.size()); }
+    const OperatingPoint& getLevel(int level) const { return levels_[level]; }
+    double getFrequency(int level) const { return levels_[level].frequency_ghz; }
+    double getVoltage(int level) const { return levels_[level].voltage; }
+    double getMaxVoltage() const { return levels_.back().voltage; }
+    
+    // Highest level whose frequency does not exceed the cap (level 0 if none does)
+    int levelAtOrBelow(double frequency_ghz) const;
+    
+    // Reference ticks of work retired per tick
+    double getSpeed(TaskType type, int level) const { return speed_[index(type, level)]; }
+    // Switching power while running the task type (W)
+    double getDynamicPower(TaskType type, int level) const { return dynamic_power_[index(type, level)]; }
+    // Leakage at the reference temperature (W)
+    double getStaticPower(int level) const { return static_power_[level]; }
+    // Energy per reference tick of work at the reference temperature (J)
+    double getEnergyPerWork(TaskType type, int level) const { return energy_per_work_[index(type, level)]; }
+    
+    // Level minimising energy_per_work * (1 / speed)^urgency: 0 is the most
+    // efficient level, each step weighs completion time more heavily
+    int getBestLevel(TaskType type, int urgency) const {
+        return best_level_[urgency * kTaskTypes + static_cast<int>(type)];
+    }
+    double getPlacementCost(TaskType type, int urgency) const {
+        return best_cost_[urgency * kTaskTypes + static_cast<int>(type)];
+    }
+    
+    // Snapshot support
+    void saveState(BinaryWriter& writer) const;
+    void loadState(BinaryReader& reader);
+    
+private:
+    std::string name_;
+    std::vector<OperatingPoint> levels_;   // Ascending frequency
+    double capacitance_[kTaskTypes];       // Effective switched capacitance (F)
+    double ipc_[kTaskTypes];               // Work per cycle relative to the reference core
+    double leakage_power_;                 // Leakage at the top level's voltage and 25 °C (W)
+    
+    // Tables indexed by type * levels + level
+    std::vector<double> speed_;
+    std::vector<double> dynamic_power_;
+    std::vector<double> static_power_;
+    std::vector<double> energy_per_work_;
+    int best_level_[kUrgencyLevels * kTaskTypes];
+    double best_cost_[kUrgencyLevels * kTaskTypes];
+    
+    size_t index(TaskType type, int level) const { return static_cast<int>(type) * levels_.size() + level; }
+    void buildTables();
+};
+
+// Cores of a heterogeneous system: the distinct core types and, per core, the
+// index of its type
+struct Platform {
+    std::vector<CoreType> types;
+    std::vector<int> cores;
+    
+    int getCoreCount() const { return static_cast<int>(cores.size()); }
+    const CoreType& typeOf(int core) const { return types[cores[core]]; }
+    
+    // Layout such as "big:2,little:4" built from the presets
+    static Platform parse(const std::string& layout);
+    
+    void saveState(BinaryWriter& writer) const;
+    void loadState(BinaryReader& reader);
+};
+
+#endif // CORE_TYPE_H
@@ -1,13 +1,31 @@
 #include "EnergyModel.h"
+#include "core/Serialization.h"
+#include <algorithm>
 #include <cmath>
 
+namespace {
+// Leakage curve sampling range and resolution (°C)
+const double kLeakageTableMin = -40.0;
+const double kLeakageTableMax = 150.0;
+const double kLeakageTableStep = 0.5;
+}
+
 EnergyModel::EnergyModel(double base_capacitance, double base_voltage)
     : base_capacitance_(base_capacitance), base_voltage_(base_voltage),
-      cpu_bound_multiplier_(1.2), io_bound_multiplier_(0.6), memory_multiplier_(0.9) {
+      cpu_bound_multiplier_(1.2), io_bound_multiplier_(0.6), memory_multiplier_(0.9),
+      leakage_reference_power_(0.02), leakage_reference_temp_(25.0), leakage_temp_coeff_(0.035),
+      cached_frequency_(-1.0), cached_voltage_(0.0) {
+    buildLeakageTable();
+    
+    c_states_ = {
+        {"C1", 0.030, 1.0, 0, 0, 0.0, 0},
+        {"C3", 0.010, 0.5, 1, 2, 0.0002, 10},
+        {"C6", 0.002, 0.0, 2, 5, 0.0010, 50}
+    };
 }
 
 double EnergyModel::calculateTaskEnergy(const Task& task, double frequency_ghz, int execution_time) {
-    double power = calculatePower(task.getType(), frequency_ghz);
+    double power = calculatePower(task.getExecutionType(), frequency_ghz);
     // Energy = Power * Time (assuming execution_time is in simulation ticks, convert to seconds)
     double time_seconds = execution_time / 1000.0; // 1 tick = 1ms
     return power * time_seconds; // Joules
@@ -24,11 +42,38 @@ double EnergyModel::calculatePower(TaskType task_type, double frequency_ghz) {
     return power;
 }
 
+double EnergyModel::calculateLeakagePower(double temperature_celsius, double voltage) const {
+    // P_leak = P_ref * (V / V_base) * exp(k * (T - T_ref))
+    return getLeakageScale(voltage) * getLeakageFactor(temperature_celsius);
+}
+
+double EnergyModel::getLeakageFactor(double temperature_celsius) const {
+    // exp(k * (T - T_ref)) interpolated from the precomputed table
+    double position = (std::min(std::max(temperature_celsius, kLeakageTableMin), kLeakageTableMax)
+                       - kLeakageTableMin) / kLeakageTableStep;
+    size_t index = std::min(static_cast<size_t>(position), leakage_table_.size() - 2);
+    double fraction = position - index;
+    return leakage_table_[index] + (leakage_table_[index + 1] - leakage_table_[index]) * fraction;
+}
+
+double EnergyModel::getLeakageTableMin() {
+    return kLeakageTableMin;
+}
+
+double EnergyModel::getLeakageTableStep() {
+    return kLeakageTableStep;
+}
+
 double EnergyModel::getVoltageForFrequency(double frequency_ghz) const {
+    if (frequency_ghz == cached_frequency_) {
+        return cached_voltage_;
+    }
     // Simplified voltage scaling: V = V_base * (f/f_base)^0.8
     // Assuming base frequency is 1.0 GHz
     double frequency_ratio = frequency_ghz / 1.0;
-    return base_voltage_ * std::pow(frequency_ratio, 0.8);
+    cached_frequency_ = frequency_ghz;
+    cached_voltage_ = base_voltage_ * std::pow(frequency_ratio, 0.8);
+    return cached_voltage_;
 }
 
 void EnergyModel::setTaskTypeMultipliers(double cpu_bound_mult, double io_bound_mult, double memory_mult) {
@@ -37,6 +82,63 @@ void EnergyModel::setTaskTypeMultipliers(double cpu_bound_mult, double io_bound_
     memory_multiplier_ = memory_mult;
 }
 
+void EnergyModel::setLeakageParameters(double reference_power_watts, double reference_temp, double temp_coeff) {
+    leakage_reference_power_ = reference_power_watts;
+    leakage_reference_temp_ = reference_temp;
+    leakage_temp_coeff_ = temp_coeff;
+    buildLeakageTable();
+}
+
+void EnergyModel::setCStates(const std::vector<CState>& c_states) {
+    if (!c_states.empty()) {
+        c_states_ = c_states;
+    }
+}
+
+void EnergyModel::saveState(BinaryWriter& writer) const {
+    writer.writeDouble(base_capacitance_);
+    writer.writeDouble(base_voltage_);
+    writer.writeDouble(cpu_bound_multiplier_);
+    writer.writeDouble(io_bound_multiplier_);
+    writer.writeDouble(memory_multiplier_);
+    writer.writeDouble(leakage_reference_power_);
+    writer.writeDouble(leakage_reference_temp_);
+    writer.writeDouble(leakage_temp_coeff_);
+    writer.writeUInt(c_states_.size());
+    for (const auto& state : c_states_) {
+        writer.writeString(state.name);
+        writer.writeDouble(state.power_watts);
+        writer.writeDouble(state.leakage_fraction);
+        writer.writeInt(state.entry_latency);
+        writer.writeInt(state.exit_latency);
+        writer.writeDouble(state.transition_energy_joules);
+        writer.writeInt(state.target_residency);
+    }
+}
+
+void EnergyModel::loadState(BinaryReader& reader) {
+    base_capacitance_ = reader.readDouble();
+    base_voltage_ = reader.readDouble();
+    cpu_bound_multiplier_ = reader.readDouble();
+    io_bound_multiplier_ = reader.readDouble();
+    memory_multiplier_ = reader.readDouble();
+    leakage_reference_power_ = reader.readDouble();
+    leakage_reference_temp_ = reader.readDouble();
+    leakage_temp_coeff_ = reader.readDouble();
+    c_states_.resize(reader.readUInt());
+    for (auto& state : c_states_) {
+        state.name = reader.readString();
+        state.power_watts = reader.readDouble();
+        state.leakage_fraction = reader.readDouble();
+        state.entry_latency = static_cast<int>(reader.readInt());
+        state.exit_latency = static_cast<int>(reader.readInt());
+        state.transition_energy_joules = reader.readDouble();
+        state.target_residency = static_cast<int>(reader.readInt());
+    }
+    cached_frequency_ = -1.0;
+    buildLeakageTable();
+}
+
 double EnergyModel::getTaskTypeMultiplier(TaskType type) const {
     switch (type) {
         case TaskType::CPU_BOUND:
@@ -49,3 +151,12 @@ double EnergyModel::getTaskTypeMultiplier(TaskType type) const {
             return 1.0;
     }
 }
+
+void EnergyModel::buildLeakageTable() {
+    size_t samples = static_cast<size_t>((kLeakageTableMax - kLeakageTableMin) / kLeakageTableStep) + 1;
+    leakage_table_.resize(samples);
+    for (size_t i = 0; i < samples; ++i) {
+        double temperature = kLeakageTableMin + i * kLeakageTableStep;
+        leakage_table_[i] = std::exp(leakage_temp_coeff_ * (temperature - leakage_reference_temp_));
+    }
+}
@@ -2,6 +2,19 @@
 #define ENERGY_MODEL_H
 
 #include "tasks/Task.h"
+#include <string>
+#include <vector>
+
+// Idle (C-) state: residency power plus the cost of getting in and out
+struct CState {
+    std::string name;
+    double power_watts;              // Residency power excluding leakage (W)
+    double leakage_fraction;         // Share of leakage still drawn (0 when power-gated)
+    int entry_latency;               // Ticks spent at the shallowest state before reaching this one
+    int exit_latency;                // Ticks needed to wake up before work can run
+    double transition_energy_joules; // Energy of one entry/exit round trip (J)
+    int target_residency;            // Minimum idle ticks for the state to pay off
+};
 
 class EnergyModel {
 public:
@@ -13,12 +26,37 @@ public:
     // Calculate instantaneous power consumption
     double calculatePower(TaskType task_type, double frequency_ghz);
     
+    // Temperature-dependent static power at the given supply voltage (W)
+    double calculateLeakagePower(double temperature_celsius, double voltage) const;
+    
+    // Leakage split for vectorized evaluation: calculateLeakagePower(T, V) equals
+    // getLeakageScale(V) times the table interpolated at T
+    double getLeakageScale(double voltage) const { return leakage_reference_power_ * (voltage / base_voltage_); }
+    const std::vector<double>& getLeakageTable() const { return leakage_table_; }
+    static double getLeakageTableMin();
+    static double getLeakageTableStep();
+    
+    // Temperature dependence of leakage relative to the reference temperature,
+    // for core types that carry their own reference leakage
+    double getLeakageFactor(double temperature_celsius) const;
+    
     // Get voltage for a given frequency (simplified model)
     double getVoltageForFrequency(double frequency_ghz) const;
     
     // Task type specific power multipliers
     void setTaskTypeMultipliers(double cpu_bound_mult, double io_bound_mult, double memory_mult);
     
+    // Leakage at the base voltage and reference temperature, and its exponential temperature slope
+    void setLeakageParameters(double reference_power_watts, double reference_temp, double temp_coeff);
+    
+    // Idle states, ordered from shallowest to deepest
+    const std::vector<CState>& getCStates() const { return c_states_; }
+    void setCStates(const std::vector<CState>& c_states);
+    
+    // Snapshot support (model parameters and idle-state table)
+    void saveState(BinaryWriter& writer) const;
+    void loadState(BinaryReader& reader);
+    
 private:
     double base_capacitance_;  // Effective capacitance (F)
     double base_voltage_;      // Base voltage (V)
@@ -26,7 +64,19 @@ private:
     double io_bound_multiplier_;
     double memory_multiplier_;
     
+    double leakage_reference_power_;  // Leakage at base voltage and reference temperature (W)
+    double leakage_reference_temp_;   // (°C)
+    double leakage_temp_coeff_;       // Exponential slope (1/°C)
+    std::vector<double> leakage_table_;  // exp(coeff * (T - T_ref)) sampled over the table range
+    
+    std::vector<CState> c_states_;
+    
+    // Voltage of the last frequency asked for, since the same level repeats every tick
+    mutable double cached_frequency_;
+    mutable double cached_voltage_;
+    
     double getTaskTypeMultiplier(TaskType type) const;
+    void buildLeakageTable();
 };
 
 #endif // ENERGY_MODEL_H
@@ -0,0 +1,34 @@
+#include "MemoryBandwidthModel.h"
+
+MemoryBandwidthModel::MemoryBandwidthModel(double budget_gbps)
+    : budget_(budget_gbps) {
+    // Compute- and I/O-bound work mostly hits in the caches; memory-heavy
+    // work streams and spends most of its time waiting on DRAM
+    setTaskType(TaskType::CPU_BOUND, 0.5, 0.1);
+    setTaskType(TaskType::IO_BOUND, 0.5, 0.1);
+    setTaskType(TaskType::MEMORY_HEAVY, 8.0, 0.7);
+    reset();
+}
+
+void MemoryBandwidthModel::setTaskType(TaskType type, double demand_gbps, double memory_share) {
+    demand_[static_cast<int>(type)] = demand_gbps;
+    memory_share_[static_cast<int>(type)] = memory_share;
+}
+
+void MemoryBandwidthModel::update(double requested_work, double retired_work) {
+    requested_work_ += requested_work;
+    if (retired_work < requested_work) {
+        contended_ticks_++;
+        lost_work_ += requested_work - retired_work;
+    }
+}
+
+double MemoryBandwidthModel::getThroughputLossPercent() const {
+    return (requested_work_ > 0.0) ? lost_work_ / requested_work_ * 100.0 : 0.0;
+}
+
+void MemoryBandwidthModel::reset() {
+    contended_ticks_ = 0;
+    requested_work_ = 0.0;
+    lost_work_ = 0.0;
+}
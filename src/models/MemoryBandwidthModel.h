@@ -0,0 +1,60 @@
+#ifndef MEMORY_BANDWIDTH_MODEL_H
+#define MEMORY_BANDWIDTH_MODEL_H
+
+#include "tasks/Task.h"
+
+// Shared memory bandwidth of a multi-core package. A running task demands
+// bandwidth in proportion to the work it retires per tick, at a rate set by
+// its type. While the total demand exceeds the budget every request is served
+// at the same fraction, and a task that spends share m of its time waiting on
+// memory retires work at 1 / ((1 - m) + m / fraction) of its uncontended
+// speed. The core keeps drawing its power while stalled, so contention raises
+// the energy per unit of work.
+class MemoryBandwidthModel {
+public:
+    static const int kTaskTypes = 3;
+    
+    // A budget of 0 or less means unlimited bandwidth
+    explicit MemoryBandwidthModel(double budget_gbps = 0.0);
+    
+    bool isEnabled() const { return budget_ > 0.0; }
+    double getBudget() const { return budget_; }
+    
+    // Bandwidth (GB/s) a task of the type needs at the given speed
+    double getDemand(TaskType type, double speed) const { return demand_[static_cast<int>(type)] * speed; }
+    // Fraction of every request served under a total demand
+    double getServedFraction(double total_demand) const {
+        return (!isEnabled() || total_demand <= budget_) ? 1.0 : budget_ / total_demand;
+    }
+    // Speed multiplier of a task of the type at a served fraction
+    double getSpeedFactor(TaskType type, double served_fraction) const {
+        if (served_fraction >= 1.0) {
+            return 1.0;
+        }
+        double memory_share = memory_share_[static_cast<int>(type)];
+        return 1.0 / ((1.0 - memory_share) + memory_share / served_fraction);
+    }
+    
+    // Bandwidth per unit of speed (GB/s) and share of time waiting on memory
+    void setTaskType(TaskType type, double demand_gbps, double memory_share);
+    
+    // Account one tick of the package: work the running tasks would have
+    // retired without contention, and what they retired
+    void update(double requested_work, double retired_work);
+    
+    int getContendedTime() const { return contended_ticks_; }
+    double getThroughputLossPercent() const;
+    
+    void reset();
+    
+private:
+    double budget_;                      // Sustained bandwidth of the memory system (GB/s)
+    double demand_[kTaskTypes];          // Indexed by TaskType
+    double memory_share_[kTaskTypes];
+    
+    int contended_ticks_;
+    double requested_work_;
+    double lost_work_;
+};
+
+#endif // MEMORY_BANDWIDTH_MODEL_H
@@ -0,0 +1,253 @@
+#include "RCThermalModel.h"
+#include "SimdKernels.h"
+#include "core/Serialization.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// Default die parameters
+const double kCoreCapacitance = 0.01;        // J/K
+const double kSpreaderCapacitance = 1.0;     // J/K
+const double kHeatsinkCapacitance = 20.0;    // J/K
+const double kCoreToCore = 0.5;              // W/K between grid neighbours
+const double kCoreToSpreader = 2.0;          // W/K
+const double kSpreaderToHeatsink = 5.0;      // W/K per core
+const double kHeatsinkToAmbient = 1.0;       // W/K per core
+
+// out = a * b for square m x m row-major matrices
+void multiply(const std::vector<double>& a, const std::vector<double>& b, std::vector<double>& out, int m) {
+    std::fill(out.begin(), out.end(), 0.0);
+    for (int i = 0; i < m; ++i) {
+        for (int k = 0; k < m; ++k) {
+            double a_ik = a[i * m + k];
+            if (a_ik == 0.0) continue;
+            const double* b_row = &b[k * m];
+            double* out_row = &out[i * m];
+            for (int j = 0; j < m; ++j) {
+                out_row[j] += a_ik * b_row[j];
+            }
+        }
+    }
+}
+
+// Matrix exponential by scaling and squaring with a truncated Taylor series
+std::vector<double> expm(std::vector<double> x, int m) {
+    double norm = 0.0;
+    for (int j = 0; j < m; ++j) {
+        double column = 0.0;
+        for (int i = 0; i < m; ++i) {
+            column += std::fabs(x[i * m + j]);
+        }
+        norm = std::max(norm, column);
+    }
+    int squarings = (norm > 0.5) ? static_cast<int>(std::ceil(std::log2(norm / 0.5))) : 0;
+    double scale = std::ldexp(1.0, -squarings);
+    for (double& v : x) {
+        v *= scale;
+    }
+    
+    std::vector<double> result(m * m, 0.0);
+    std::vector<double> term(m * m, 0.0);
+    std::vector<double> next(m * m, 0.0);
+    for (int i = 0; i < m; ++i) {
+        result[i * m + i] = 1.0;
+        term[i * m + i] = 1.0;
+    }
+    for (int k = 1; k <= 16; ++k) {
+        multiply(term, x, next, m);
+        for (int i = 0; i < m * m; ++i) {
+            term[i] = next[i] / k;
+            result[i] += term[i];
+        }
+    }
+    for (int s = 0; s < squarings; ++s) {
+        multiply(result, result, next, m);
+        result.swap(next);
+    }
+    return result;
+}
+
+} // namespace
+
+RCThermalModel::RCThermalModel(int num_cores, double ambient_temp, Integrator integrator)
+    : ThermalModel(ambient_temp), num_cores_(std::max(1, num_cores)), num_nodes_(num_cores_ + 2),
+      integrator_(integrator), tick_seconds_(0.001) {
+    stride_ = SimdKernels::paddedSize(2 * num_nodes_);
+    capacitance_.assign(num_nodes_, kCoreCapacitance);
+    conductance_.assign(num_nodes_ * num_nodes_, 0.0);
+    ambient_conductance_.assign(num_nodes_, 0.0);
+    state_.assign(stride_, 0.0);
+    scratch_.assign(num_nodes_, 0.0);
+    
+    capacitance_[getSpreaderNode()] = kSpreaderCapacitance * num_cores_;
+    capacitance_[getHeatsinkNode()] = kHeatsinkCapacitance * num_cores_;
+    
+    int columns = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(num_cores_))));
+    for (int core = 0; core < num_cores_; ++core) {
+        if (core % columns + 1 < columns && core + 1 < num_cores_) {
+            setConductance(core, core + 1, kCoreToCore);
+        }
+        if (core + columns < num_cores_) {
+            setConductance(core, core + columns, kCoreToCore);
+        }
+        setConductance(core, getSpreaderNode(), kCoreToSpreader);
+    }
+    setConductance(getSpreaderNode(), getHeatsinkNode(), kSpreaderToHeatsink * num_cores_);
+    setAmbientConductance(getHeatsinkNode(), kHeatsinkToAmbient * num_cores_);
+}
+
+void RCThermalModel::setCapacitance(int node, double joules_per_kelvin) {
+    if (joules_per_kelvin <= 0.0) {
+        throw std::invalid_argument("thermal capacitance must be positive");
+    }
+    capacitance_.at(node) = joules_per_kelvin;
+    invalidate();
+}
+
+void RCThermalModel::setConductance(int node_a, int node_b, double watts_per_kelvin) {
+    if (node_a == node_b) return;
+    conductance_.at(node_a * num_nodes_ + node_b) = watts_per_kelvin;
+    conductance_.at(node_b * num_nodes_ + node_a) = watts_per_kelvin;
+    invalidate();
+}
+
+void RCThermalModel::setAmbientConductance(int node, double watts_per_kelvin) {
+    ambient_conductance_.at(node) = watts_per_kelvin;
+    invalidate();
+}
+
+void RCThermalModel::setTickDuration(double seconds) {
+    tick_seconds_ = seconds;
+    invalidate();
+}
+
+void RCThermalModel::setIntegrator(Integrator integrator) {
+    integrator_ = integrator;
+    invalidate();
+}
+
+void RCThermalModel::setCorePower(int core, double watts) {
+    state_[num_nodes_ + core] = watts;
+}
+
+void RCThermalModel::advance(int ticks) {
+    // Decompose into power-of-two steps so a long step costs O(log ticks) mat-vecs
+    for (int level = 0; ticks > 0; ++level, ticks >>= 1) {
+        if (ticks & 1) {
+            ensureLevel(level);
+            applyStep(step_levels_[level]);
+        }
+    }
+    updateHotspot();
+}
+
+void RCThermalModel::updateTemperature(double power_watts) {
+    updateTemperature(power_watts, 1);
+}
+
+void RCThermalModel::updateTemperature(double power_watts, int ticks) {
+    setCorePower(0, power_watts);
+    advance(ticks);
+}
+
+void RCThermalModel::reset() {
+    ThermalModel::reset();
+    std::fill(state_.begin(), state_.end(), 0.0);
+}
+
+void RCThermalModel::saveState(BinaryWriter& writer) const {
+    ThermalModel::saveState(writer);
+    writer.writeUInt(num_nodes_);
+    for (int i = 0; i < 2 * num_nodes_; ++i) {
+        writer.writeDouble(state_[i]);
+    }
+}
+
+void RCThermalModel::loadState(BinaryReader& reader) {
+    ThermalModel::loadState(reader);
+    if (static_cast<int>(reader.readUInt()) != num_nodes_) {
+        throw std::runtime_error("snapshot RC network has a different number of nodes");
+    }
+    for (int i = 0; i < 2 * num_nodes_; ++i) {
+        state_[i] = reader.readDouble();
+    }
+}
+
+void RCThermalModel::buildSingleTickStep() {
+    int n = num_nodes_;
+    
+    // System matrix A = -C^-1 * L, where L is the conductance Laplacian plus
+    // the ambient conductances on the diagonal: d(theta)/dt = A*theta + C^-1*P
+    std::vector<double> a(n * n, 0.0);
+    for (int i = 0; i < n; ++i) {
+        double diagonal = ambient_conductance_[i];
+        for (int j = 0; j < n; ++j) {
+            diagonal += conductance_[i * n + j];
+            a[i * n + j] = conductance_[i * n + j] / capacitance_[i];
+        }
+        a[i * n + i] = -diagonal / capacitance_[i];
+    }
+    
+    std::vector<double> step(n * stride_, 0.0);
+    if (integrator_ == Integrator::EULER) {
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                step[i * stride_ + j] = (i == j ? 1.0 : 0.0) + tick_seconds_ * a[i * n + j];
+            }
+            step[i * stride_ + n + i] = tick_seconds_ / capacitance_[i];
+        }
+    } else {
+        // exp([[A, C^-1], [0, 0]] * dt) = [[Phi, Gamma], [0, I]]
+        int m = 2 * n;
+        std::vector<double> augmented(m * m, 0.0);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                augmented[i * m + j] = a[i * n + j] * tick_seconds_;
+            }
+            augmented[i * m + n + i] = tick_seconds_ / capacitance_[i];
+        }
+        std::vector<double> exponential = expm(augmented, m);
+        for (int i = 0; i < n; ++i) {
+            std::copy(&exponential[i * m], &exponential[i * m] + m, &step[i * stride_]);
+        }
+    }
+    step_levels_.assign(1, std::move(step));
+}
+
+void RCThermalModel::ensureLevel(int level) {
+    if (step_levels_.empty()) {
+        buildSingleTickStep();
+    }
+    int n = num_nodes_;
+    while (static_cast<int>(step_levels_.size()) <= level) {
+        // Doubling with constant power: Phi' = Phi*Phi, Gamma' = Phi*Gamma + Gamma
+        const std::vector<double>& prev = step_levels_.back();
+        std::vector<double> next(n * stride_, 0.0);
+        for (int i = 0; i < n; ++i) {
+            double* out_row = &next[i * stride_];
+            std::copy(&prev[i * stride_ + n], &prev[i * stride_ + 2 * n], out_row + n);
+            for (int k = 0; k < n; ++k) {
+                double phi_ik = prev[i * stride_ + k];
+                if (phi_ik == 0.0) continue;
+                const double* prev_row = &prev[k * stride_];
+                for (int j = 0; j < 2 * n; ++j) {
+                    out_row[j] += phi_ik * prev_row[j];
+                }
+            }
+        }
+        step_levels_.push_back(std::move(next));
+    }
+}
+
+void RCThermalModel::applyStep(const std::vector<double>& step) {
+    SimdKernels::matVec(step.data(), state_.data(), scratch_.data(), num_nodes_, stride_);
+    std::copy(scratch_.begin(), scratch_.end(), state_.begin());
+}
+
+void RCThermalModel::updateHotspot() {
+    double hottest = *std::max_element(state_.begin(), state_.begin() + num_cores_);
+    current_temp_ = ambient_temp_ + hottest;
+    peak_temp_ = std::max(peak_temp_, current_temp_);
+}
@@ -0,0 +1,79 @@
+#ifndef RC_THERMAL_MODEL_H
+#define RC_THERMAL_MODEL_H
+
+#include "ThermalModel.h"
+#include <vector>
+
+// Compact RC thermal network: one node per core plus a heat spreader and a
+// heatsink node. Nodes exchange heat through a symmetric conductance matrix
+// and the heatsink (or any node) loses heat to ambient.
+class RCThermalModel : public ThermalModel {
+public:
+    enum class Integrator {
+        EULER,        // Forward Euler, one tick per step
+        EXPONENTIAL   // Exact solution for piecewise-constant power
+    };
+    
+    // Builds a default die: cores on a square grid coupled to their neighbours,
+    // all cores coupled to the spreader, spreader to heatsink, heatsink to ambient
+    explicit RCThermalModel(int num_cores = 1, double ambient_temp = 25.0,
+                            Integrator integrator = Integrator::EXPONENTIAL);
+    
+    // Node layout: cores are 0..num_cores-1, followed by the spreader and the heatsink
+    int getNumCores() const { return num_cores_; }
+    int getNumNodes() const { return num_nodes_; }
+    int getSpreaderNode() const { return num_cores_; }
+    int getHeatsinkNode() const { return num_cores_ + 1; }
+    
+    // Network parameters (J/K and W/K); changing them invalidates the cached step matrices
+    void setCapacitance(int node, double joules_per_kelvin);
+    void setConductance(int node_a, int node_b, double watts_per_kelvin);
+    void setAmbientConductance(int node, double watts_per_kelvin);
+    void setTickDuration(double seconds);
+    void setIntegrator(Integrator integrator);
+    Integrator getIntegrator() const { return integrator_; }
+    
+    // Multi-core interface: set per-core power, then advance the network
+    void setCorePower(int core, double watts);
+    void advance(int ticks);
+    
+    double getCoreTemperature(int core) const { return ambient_temp_ + state_[core]; }
+    double getNodeTemperature(int node) const { return ambient_temp_ + state_[node]; }
+    
+    // Single-core interface: the power is attributed to core 0
+    void updateTemperature(double power_watts) override;
+    void updateTemperature(double power_watts, int ticks) override;
+    
+    void reset() override;
+    
+    std::string getName() const override { return "rc"; }
+    
+    // Saves node temperatures and powers; the network topology must match on load
+    void saveState(BinaryWriter& writer) const override;
+    void loadState(BinaryReader& reader) override;
+    
+private:
+    int num_cores_;
+    int num_nodes_;
+    int stride_;                         // Padded row length of [Phi | Gamma]
+    Integrator integrator_;
+    double tick_seconds_;
+    
+    std::vector<double> capacitance_;
+    std::vector<double> conductance_;    // num_nodes_ x num_nodes_, symmetric, zero diagonal
+    std::vector<double> ambient_conductance_;
+    
+    // Step matrices [Phi | Gamma] for 2^level ticks, rows = nodes, built lazily
+    std::vector<std::vector<double>> step_levels_;
+    
+    std::vector<double> state_;          // [temperature rise per node | power per node | padding]
+    std::vector<double> scratch_;
+    
+    void invalidate() { step_levels_.clear(); }
+    void buildSingleTickStep();
+    void ensureLevel(int level);
+    void applyStep(const std::vector<double>& step);
+    void updateHotspot();
+};
+
+#endif // RC_THERMAL_MODEL_H
@@ -0,0 +1,189 @@
+#include "SimdKernels.h"
+#include <algorithm>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define POWERPROFILE_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+void matVecScalar(const double* matrix, const double* x, double* y, int rows, int stride) {
+    for (int r = 0; r < rows; ++r) {
+        const double* row = matrix + static_cast<size_t>(r) * stride;
+        double sum = 0.0;
+        for (int c = 0; c < stride; ++c) {
+            sum += row[c] * x[c];
+        }
+        y[r] = sum;
+    }
+}
+
+void stepLanesScalar(const SimdKernels::LaneArrays& lanes, int count, const SimdKernels::LeakageTable& leakage,
+                     double tick_seconds) {
+    double max_temperature = leakage.min_temperature + leakage.step * (leakage.size - 1);
+    for (int k = 0; k < count; ++k) {
+        double temperature = lanes.temperature[k];
+        double position = (std::min(std::max(temperature, leakage.min_temperature), max_temperature)
+                           - leakage.min_temperature) / leakage.step;
+        int index = std::min(static_cast<int>(position), leakage.size - 2);
+        double fraction = position - index;
+        double scale = leakage.values[index] + (leakage.values[index + 1] - leakage.values[index]) * fraction;
+        
+        double leakage_power = lanes.leakage_scale[k] * scale;
+        double power = lanes.dynamic_power[k] + leakage_power;
+        lanes.leakage_power[k] = leakage_power;
+        lanes.power[k] = power;
+        lanes.energy[k] += power * tick_seconds;
+        
+        temperature = temperature + lanes.heating[k] * power - lanes.cooling[k] * (temperature - lanes.ambient[k]);
+        temperature = std::max(temperature, lanes.ambient[k]);
+        lanes.temperature[k] = temperature;
+        lanes.peak_temperature[k] = std::max(lanes.peak_temperature[k], temperature);
+    }
+}
+
+#ifdef POWERPROFILE_X86_SIMD
+__attribute__((target("avx2,fma")))
+void matVecAVX2(const double* matrix, const double* x, double* y, int rows, int stride) {
+    for (int r = 0; r < rows; ++r) {
+        const double* row = matrix + static_cast<size_t>(r) * stride;
+        __m256d acc0 = _mm256_setzero_pd();
+        __m256d acc1 = _mm256_setzero_pd();
+        for (int c = 0; c < stride; c += 8) {
+            acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(row + c), _mm256_loadu_pd(x + c), acc0);
+            acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(row + c + 4), _mm256_loadu_pd(x + c + 4), acc1);
+        }
+        __m256d acc = _mm256_add_pd(acc0, acc1);
+        __m128d low = _mm256_castpd256_pd128(acc);
+        __m128d high = _mm256_extractf128_pd(acc, 1);
+        low = _mm_add_pd(low, high);
+        y[r] = _mm_cvtsd_f64(_mm_add_sd(low, _mm_unpackhi_pd(low, low)));
+    }
+}
+
+__attribute__((target("avx512f")))
+void matVecAVX512(const double* matrix, const double* x, double* y, int rows, int stride) {
+    for (int r = 0; r < rows; ++r) {
+        const double* row = matrix + static_cast<size_t>(r) * stride;
+        __m512d acc = _mm512_setzero_pd();
+        for (int c = 0; c < stride; c += 8) {
+            acc = _mm512_fmadd_pd(_mm512_loadu_pd(row + c), _mm512_loadu_pd(x + c), acc);
+        }
+        y[r] = _mm512_reduce_add_pd(acc);
+    }
+}
+
+__attribute__((target("avx2")))
+void stepLanesAVX2(const SimdKernels::LaneArrays& lanes, int count, const SimdKernels::LeakageTable& leakage,
+                   double tick_seconds) {
+    const __m256d min_temperature = _mm256_set1_pd(leakage.min_temperature);
+    const __m256d max_temperature = _mm256_set1_pd(leakage.min_temperature + leakage.step * (leakage.size - 1));
+    const __m256d inverse_step = _mm256_set1_pd(1.0 / leakage.step);
+    const __m128i last_index = _mm_set1_epi32(leakage.size - 2);
+    const __m256d dt = _mm256_set1_pd(tick_seconds);
+    for (int k = 0; k < count; k += 4) {
+        __m256d temperature = _mm256_loadu_pd(lanes.temperature + k);
+        __m256d position = _mm256_mul_pd(
+            _mm256_sub_pd(_mm256_min_pd(_mm256_max_pd(temperature, min_temperature), max_temperature), min_temperature),
+            inverse_step);
+        __m128i index = _mm_min_epi32(_mm256_cvttpd_epi32(position), last_index);
+        __m256d fraction = _mm256_sub_pd(position, _mm256_cvtepi32_pd(index));
+        __m256d low = _mm256_i32gather_pd(leakage.values, index, 8);
+        __m256d high = _mm256_i32gather_pd(leakage.values + 1, index, 8);
+        __m256d scale = _mm256_add_pd(low, _mm256_mul_pd(_mm256_sub_pd(high, low), fraction));
+        
+        __m256d leakage_power = _mm256_mul_pd(_mm256_loadu_pd(lanes.leakage_scale + k), scale);
+        __m256d power = _mm256_add_pd(_mm256_loadu_pd(lanes.dynamic_power + k), leakage_power);
+        _mm256_storeu_pd(lanes.leakage_power + k, leakage_power);
+        _mm256_storeu_pd(lanes.power + k, power);
+        _mm256_storeu_pd(lanes.energy + k,
+                         _mm256_add_pd(_mm256_loadu_pd(lanes.energy + k), _mm256_mul_pd(power, dt)));
+        
+        __m256d ambient = _mm256_loadu_pd(lanes.ambient + k);
+        __m256d heating = _mm256_mul_pd(_mm256_loadu_pd(lanes.heating + k), power);
+        __m256d cooling = _mm256_mul_pd(_mm256_loadu_pd(lanes.cooling + k), _mm256_sub_pd(temperature, ambient));
+        temperature = _mm256_max_pd(_mm256_sub_pd(_mm256_add_pd(temperature, heating), cooling), ambient);
+        _mm256_storeu_pd(lanes.temperature + k, temperature);
+        _mm256_storeu_pd(lanes.peak_temperature + k,
+                         _mm256_max_pd(_mm256_loadu_pd(lanes.peak_temperature + k), temperature));
+    }
+}
+
+__attribute__((target("avx512f")))
+void stepLanesAVX512(const SimdKernels::LaneArrays& lanes, int count, const SimdKernels::LeakageTable& leakage,
+                     double tick_seconds) {
+    const __m512d min_temperature = _mm512_set1_pd(leakage.min_temperature);
+    const __m512d max_temperature = _mm512_set1_pd(leakage.min_temperature + leakage.step * (leakage.size - 1));
+    const __m512d inverse_step = _mm512_set1_pd(1.0 / leakage.step);
+    const __m256i last_index = _mm256_set1_epi32(leakage.size - 2);
+    const __m512d dt = _mm512_set1_pd(tick_seconds);
+    for (int k = 0; k < count; k += 8) {
+        __m512d temperature = _mm512_loadu_pd(lanes.temperature + k);
+        __m512d position = _mm512_mul_pd(
+            _mm512_sub_pd(_mm512_min_pd(_mm512_max_pd(temperature, min_temperature), max_temperature), min_temperature),
+            inverse_step);
+        __m256i index = _mm256_min_epi32(_mm512_cvttpd_epi32(position), last_index);
+        __m512d fraction = _mm512_sub_pd(position, _mm512_cvtepi32_pd(index));
+        __m512d low = _mm512_i32gather_pd(index, leakage.values, 8);
+        __m512d high = _mm512_i32gather_pd(index, leakage.values + 1, 8);
+        __m512d scale = _mm512_add_pd(low, _mm512_mul_pd(_mm512_sub_pd(high, low), fraction));
+        
+        __m512d leakage_power = _mm512_mul_pd(_mm512_loadu_pd(lanes.leakage_scale + k), scale);
+        __m512d power = _mm512_add_pd(_mm512_loadu_pd(lanes.dynamic_power + k), leakage_power);
+        _mm512_storeu_pd(lanes.leakage_power + k, leakage_power);
+        _mm512_storeu_pd(lanes.power + k, power);
+        _mm512_storeu_pd(lanes.energy + k,
+                         _mm512_add_pd(_mm512_loadu_pd(lanes.energy + k), _mm512_mul_pd(power, dt)));
+        
+        __m512d ambient = _mm512_loadu_pd(lanes.ambient + k);
+        __m512d heating = _mm512_mul_pd(_mm512_loadu_pd(lanes.heating + k), power);
+        __m512d cooling = _mm512_mul_pd(_mm512_loadu_pd(lanes.cooling + k), _mm512_sub_pd(temperature, ambient));
+        temperature = _mm512_max_pd(_mm512_sub_pd(_mm512_add_pd(temperature, heating), cooling), ambient);
+        _mm512_storeu_pd(lanes.temperature + k, temperature);
+        _mm512_storeu_pd(lanes.peak_temperature + k,
+                         _mm512_max_pd(_mm512_loadu_pd(lanes.peak_temperature + k), temperature));
+    }
+}
+#endif
+
+typedef void (*MatVecFn)(const double*, const double*, double*, int, int);
+typedef void (*StepLanesFn)(const SimdKernels::LaneArrays&, int, const SimdKernels::LeakageTable&, double);
+
+struct KernelTable {
+    MatVecFn mat_vec;
+    StepLanesFn step_lanes;
+    const char* name;
+};
+
+KernelTable selectKernels() {
+#ifdef POWERPROFILE_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return {matVecAVX512, stepLanesAVX512, "AVX-512"};
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return {matVecAVX2, stepLanesAVX2, "AVX2"};
+    }
+#endif
+    return {matVecScalar, stepLanesScalar, "scalar"};
+}
+
+const KernelTable& kernels() {
+    static const KernelTable table = selectKernels();
+    return table;
+}
+
+} // namespace
+
+void SimdKernels::matVec(const double* matrix, const double* x, double* y, int rows, int stride) {
+    kernels().mat_vec(matrix, x, y, rows, stride);
+}
+
+void SimdKernels::stepLanes(const LaneArrays& lanes, int count, const LeakageTable& leakage, double tick_seconds) {
+    kernels().step_lanes(lanes, count, leakage, tick_seconds);
+}
+
+const char* SimdKernels::getInstructionSet() {
+    return kernels().name;
+}
@@ -0,0 +1,48 @@
+#ifndef SIMD_KERNELS_H
+#define SIMD_KERNELS_H
+
+#include <cstddef>
+
+// Vectorized numeric kernels with AVX-512 / AVX2 paths selected at runtime
+// and a portable scalar fallback
+class SimdKernels {
+public:
+    // Pad row strides to this many doubles so every vector path runs without tails
+    static const int kPadding = 8;
+    static int paddedSize(int n) { return (n + kPadding - 1) / kPadding * kPadding; }
+    
+    // y[r] = sum_c matrix[r * stride + c] * x[c], for r < rows and c < stride
+    // (stride must be a multiple of kPadding, padded entries must be zero)
+    static void matVec(const double* matrix, const double* x, double* y, int rows, int stride);
+    
+    // Lane-wise state of independent lumped-model simulations, one entry per lane
+    struct LaneArrays {
+        const double* dynamic_power;   // Dynamic or idle-state power this tick (W)
+        const double* leakage_scale;   // Leakage power per unit of the leakage table (W)
+        const double* ambient;         // Ambient temperature (°C)
+        const double* heating;         // Heating coefficient
+        const double* cooling;         // Cooling coefficient
+        double* temperature;           // In/out (°C)
+        double* peak_temperature;      // In/out (°C)
+        double* energy;                // In/out, accumulated (J)
+        double* power;                 // Out: total power this tick (W)
+        double* leakage_power;         // Out: leakage share of it (W)
+    };
+    
+    // Temperature-indexed leakage scale factors, linearly interpolated
+    struct LeakageTable {
+        const double* values;
+        int size;
+        double min_temperature;
+        double step;
+    };
+    
+    // One tick for every lane: leakage from the current temperature, total power,
+    // energy and the lumped thermal update (lanes must be a multiple of kPadding)
+    static void stepLanes(const LaneArrays& lanes, int count, const LeakageTable& leakage, double tick_seconds);
+    
+    // Name of the instruction set used by the kernels on this machine
+    static const char* getInstructionSet();
+};
+
+#endif // SIMD_KERNELS_H
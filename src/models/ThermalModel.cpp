@@ -1,5 +1,7 @@
 #include "ThermalModel.h"
+#include "core/Serialization.h"
 #include <algorithm>
+#include <cmath>
 
 ThermalModel::ThermalModel(double ambient_temp, double heating_coeff, double cooling_coeff)
     : current_temp_(ambient_temp), peak_temp_(ambient_temp), ambient_temp_(ambient_temp),
@@ -20,6 +22,25 @@ void ThermalModel::updateTemperature(double power_watts) {
     peak_temp_ = std::max(peak_temp_, current_temp_);
 }
 
+void ThermalModel::updateTemperature(double power_watts, int ticks) {
+    if (ticks <= 0) return;
+    if (ticks == 1 || cooling_coeff_ <= 0.0 || cooling_coeff_ >= 1.0) {
+        for (int i = 0; i < ticks; ++i) {
+            updateTemperature(power_watts);
+        }
+        return;
+    }
+    
+    // Closed form of the per-tick recurrence: the rise above ambient decays by
+    // (1 - d) per tick towards the steady state k*Power/d
+    double decay = std::pow(1.0 - cooling_coeff_, ticks);
+    double steady_rise = heating_coeff_ * power_watts / cooling_coeff_;
+    double rise = (current_temp_ - ambient_temp_) * decay + steady_rise * (1.0 - decay);
+    
+    current_temp_ = std::max(ambient_temp_ + rise, ambient_temp_);
+    peak_temp_ = std::max(peak_temp_, current_temp_);
+}
+
 void ThermalModel::reset() {
     current_temp_ = ambient_temp_;
     peak_temp_ = ambient_temp_;
@@ -34,3 +55,19 @@ void ThermalModel::setParameters(double ambient_temp, double heating_coeff, doub
     heating_coeff_ = heating_coeff;
     cooling_coeff_ = cooling_coeff;
 }
+
+void ThermalModel::saveState(BinaryWriter& writer) const {
+    writer.writeDouble(current_temp_);
+    writer.writeDouble(peak_temp_);
+    writer.writeDouble(ambient_temp_);
+    writer.writeDouble(heating_coeff_);
+    writer.writeDouble(cooling_coeff_);
+}
+
+void ThermalModel::loadState(BinaryReader& reader) {
+    current_temp_ = reader.readDouble();
+    peak_temp_ = reader.readDouble();
+    ambient_temp_ = reader.readDouble();
+    heating_coeff_ = reader.readDouble();
+    cooling_coeff_ = reader.readDouble();
+}
@@ -1,12 +1,21 @@
 #ifndef THERMAL_MODEL_H
 #define THERMAL_MODEL_H
 
+#include <string>
+
+class BinaryWriter;
+class BinaryReader;
+
 class ThermalModel {
 public:
     ThermalModel(double ambient_temp = 25.0, double heating_coeff = 0.1, double cooling_coeff = 0.05);
+    virtual ~ThermalModel() = default;
     
     // Update temperature based on current power consumption
-    void updateTemperature(double power_watts);
+    virtual void updateTemperature(double power_watts);
+    
+    // Advance several ticks at constant power in one step
+    virtual void updateTemperature(double power_watts, int ticks);
     
     // Get current temperature
     double getCurrentTemperature() const { return current_temp_; }
@@ -14,8 +23,22 @@ public:
     // Get peak temperature recorded
     double getPeakTemperature() const { return peak_temp_; }
     
+    // Get ambient temperature
+    double getAmbientTemperature() const { return ambient_temp_; }
+    
+    // Lumped-model coefficients
+    double getHeatingCoefficient() const { return heating_coeff_; }
+    double getCoolingCoefficient() const { return cooling_coeff_; }
+    
     // Reset thermal state
-    void reset();
+    virtual void reset();
+    
+    // Model identifier stored in snapshots
+    virtual std::string getName() const { return "lumped"; }
+    
+    // Snapshot support
+    virtual void saveState(BinaryWriter& writer) const;
+    virtual void loadState(BinaryReader& reader);
     
     // Thermal throttling check
     bool shouldThrottle(double threshold_temp = 85.0) const;
@@ -23,10 +46,12 @@ public:
     // Set thermal parameters
     void setParameters(double ambient_temp, double heating_coeff, double cooling_coeff);
     
-private:
+protected:
     double current_temp_;      // Current temperature (°C)
     double peak_temp_;         // Peak temperature reached (°C)
     double ambient_temp_;      // Ambient temperature (°C)
+    
+private:
     double heating_coeff_;     // Heating coefficient
     double cooling_coeff_;     // Cooling coefficient
 };
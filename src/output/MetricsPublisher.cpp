@@ -0,0 +1,95 @@
+#include "MetricsPublisher.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+void writeMetric(std::ostringstream& out, const char* name, const char* type, const char* help, double value) {
+    out << "# HELP " << name << " " << help << "\n"
+        << "# TYPE " << name << " " << type << "\n"
+        << name << " " << value << "\n";
+}
+
+} // namespace
+
+MetricsPublisher::MetricsPublisher(const LiveMetrics& metrics, const std::string& destination, int interval_ms)
+    : metrics_(metrics), destination_(destination), interval_(interval_ms), stopping_(false),
+      last_(metrics.sample()), last_time_(std::chrono::steady_clock::now()) {
+    if (destination_ != "-") {
+        std::ofstream probe(destination_ + ".tmp");
+        if (!probe.is_open()) {
+            throw std::runtime_error("cannot write metrics to " + destination_);
+        }
+        probe.close();
+        std::remove((destination_ + ".tmp").c_str());
+    }
+    thread_ = std::thread([this] { run(); });
+}
+
+MetricsPublisher::~MetricsPublisher() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+    publish();
+}
+
+void MetricsPublisher::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!wake_.wait_for(lock, interval_, [this] { return stopping_; })) {
+        lock.unlock();
+        publish();
+        lock.lock();
+    }
+}
+
+void MetricsPublisher::publish() {
+    LiveMetrics::Sample sample = metrics_.sample();
+    auto now = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(now - last_time_).count();
+    // A new run restarts the simulated clock
+    int64_t advanced = sample.simulated_ticks - (sample.runs == last_.runs ? last_.simulated_ticks : 0);
+    double ticks_per_second = (seconds > 0.0) ? advanced / seconds : 0.0;
+    last_ = sample;
+    last_time_ = now;
+    
+    std::string text = format(sample, ticks_per_second);
+    if (destination_ == "-") {
+        std::fwrite(text.data(), 1, text.size(), stderr);
+        std::fflush(stderr);
+        return;
+    }
+    // Failures are skipped: the next interval tries again
+    std::string temp_file = destination_ + ".tmp";
+    {
+        std::ofstream file(temp_file);
+        if (!file.is_open() || !(file << text)) {
+            return;
+        }
+    }
+    std::rename(temp_file.c_str(), destination_.c_str());
+}
+
+std::string MetricsPublisher::format(const LiveMetrics::Sample& sample, double ticks_per_second) const {
+    std::ostringstream out;
+    out.precision(12);
+    writeMetric(out, "powerprofile_runs_started_total", "counter", "Simulation runs started",
+                static_cast<double>(sample.runs));
+    writeMetric(out, "powerprofile_simulated_ticks", "gauge", "Simulated time of the current run (ticks)",
+                static_cast<double>(sample.simulated_ticks));
+    writeMetric(out, "powerprofile_tasks_completed", "gauge", "Tasks completed in the current run",
+                static_cast<double>(sample.tasks_completed));
+    writeMetric(out, "powerprofile_energy_joules", "gauge", "Energy consumed in the current run (J)",
+                sample.energy_joules);
+    writeMetric(out, "powerprofile_temperature_celsius", "gauge", "Current package temperature (C)",
+                sample.temperature_celsius);
+    writeMetric(out, "powerprofile_ticks_per_second", "gauge", "Simulated ticks per wall-clock second",
+                ticks_per_second);
+    writeMetric(out, "powerprofile_cancel_requested", "gauge", "1 once cancellation has been requested",
+                sample.cancel_requested ? 1.0 : 0.0);
+    return out.str();
+}
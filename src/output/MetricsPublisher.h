@@ -0,0 +1,41 @@
+#ifndef METRICS_PUBLISHER_H
+#define METRICS_PUBLISHER_H
+
+#include "core/LiveMetrics.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Side thread publishing LiveMetrics in the Prometheus text exposition format
+// every interval: to a file, replaced atomically through a temporary so that
+// a textfile collector never reads half of it, or to stderr ("-"). Ticks per
+// second are derived from the simulated time advanced between two samples.
+// The destructor stops the thread and publishes the final values.
+class MetricsPublisher {
+public:
+    // Throws std::runtime_error when the file cannot be written
+    MetricsPublisher(const LiveMetrics& metrics, const std::string& destination, int interval_ms = 1000);
+    ~MetricsPublisher();
+    
+    MetricsPublisher(const MetricsPublisher&) = delete;
+    MetricsPublisher& operator=(const MetricsPublisher&) = delete;
+    
+private:
+    const LiveMetrics& metrics_;
+    std::string destination_;
+    std::chrono::milliseconds interval_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stopping_;
+    LiveMetrics::Sample last_;
+    std::chrono::steady_clock::time_point last_time_;
+    std::thread thread_;   // Last member: started once the rest is initialized
+    
+    void run();
+    void publish();
+    std::string format(const LiveMetrics::Sample& sample, double ticks_per_second) const;
+};
+
+#endif // METRICS_PUBLISHER_H
@@ -4,35 +4,95 @@
 #include <sstream>
 #include <algorithm>
 
+namespace {
+
+// Indexed by TaskType, as Task::getTypeString spells them
+const char* const kTaskTypeNames[] = {"CPU_BOUND", "IO_BOUND", "MEMORY_HEAVY"};
+const size_t kTaskTypes = sizeof(kTaskTypeNames) / sizeof(kTaskTypeNames[0]);
+
+} // namespace
+
 void ReportGenerator::printConsoleReport(const SimulationStats& stats) {
     std::cout << "\n" << std::string(50, '=') << std::endl;
     std::cout << "         SIMULATION RESULTS" << std::endl;
     std::cout << std::string(50, '=') << std::endl;
     
     std::cout << "Scheduler: " << stats.scheduler_name << std::endl;
+    if (stats.cancelled) {
+        std::cout << "Cancelled: partial results up to tick " << stats.total_execution_time << std::endl;
+    }
     std::cout << "Total Tasks: " << stats.total_tasks << std::endl;
     std::cout << "Completed Tasks: " << stats.completed_tasks.size() << std::endl;
     std::cout << "Total Execution Time: " << formatDuration(stats.total_execution_time) << std::endl;
     std::cout << "Total Energy Consumption: " << formatEnergy(stats.total_energy_joules) << std::endl;
     std::cout << "Average Power: " << formatPower(stats.average_power_watts) << std::endl;
     std::cout << "Peak Temperature: " << formatTemperature(stats.peak_temperature_celsius) << std::endl;
-    
-    if (!stats.completed_tasks.empty()) {
-        // Calculate average turnaround time
-        double total_turnaround = 0.0;
-        int completed_count = 0;
-        
-        for (const auto& task : stats.completed_tasks) {
-            if (task.getStartTime() >= 0 && task.getEndTime() >= 0) {
-                total_turnaround += (task.getEndTime() - task.getStartTime());
-                completed_count++;
+    std::cout << "Throttled Time: " << formatDuration(stats.throttled_time_ticks)
+              << " (" << stats.throttle_events << " events)" << std::endl;
+    std::cout << "Throughput Lost to Throttling: " << std::fixed << std::setprecision(2)
+              << stats.throughput_loss_percent << "%" << std::endl;
+    if (stats.power_capped_ticks > 0) {
+        std::cout << "Power Capped: " << formatDuration(stats.power_capped_ticks) << " ("
+                  << std::fixed << std::setprecision(2) << stats.power_cap_loss_percent << "% throughput lost)"
+                  << std::endl;
+    }
+    if (stats.contended_ticks > 0) {
+        std::cout << "Memory Contention: " << formatDuration(stats.contended_ticks) << " ("
+                  << std::fixed << std::setprecision(2) << stats.contention_loss_percent << "% throughput lost)"
+                  << std::endl;
+    }
+    std::cout << "Leakage Energy: " << formatEnergy(stats.leakage_energy_joules) << std::endl;
+    std::cout << "Idle Energy: " << formatEnergy(stats.idle_energy_joules)
+              << " (" << stats.wakeups << " wake-ups)" << std::endl;
+    if (!stats.cstate_residency.empty()) {
+        std::cout << "C-State Residency:";
+        for (const auto& entry : stats.cstate_residency) {
+            std::cout << " " << entry.first << "=" << entry.second;
+        }
+        std::cout << " ticks" << std::endl;
+    }
+    for (size_t i = 0; i < stats.cores.size(); ++i) {
+        const CoreStats& core = stats.cores[i];
+        std::cout << "Core " << i << " (" << core.type << "): " << formatDuration(core.busy_ticks) << " busy, "
+                  << core.tasks_dispatched << " dispatches, " << std::fixed << std::setprecision(2)
+                  << core.average_frequency_ghz << " GHz avg, " << formatEnergy(core.energy_joules) << std::endl;
+    }
+    if (!stats.power_curve.empty()) {
+        int cores = static_cast<int>(stats.power_curve.size()) - 1;
+        std::cout << "Power vs Utilization:";
+        for (const UtilizationBin& bin : stats.power_curve) {
+            if (bin.ticks > 0) {
+                std::cout << " " << (100 * bin.busy_cores / cores) << "%=" << std::fixed << std::setprecision(3)
+                          << bin.getAveragePower() << "W";
             }
         }
-        
-        if (completed_count > 0) {
-            double avg_turnaround = total_turnaround / completed_count;
-            std::cout << "Average Turnaround Time: " << formatDuration(static_cast<int>(avg_turnaround)) << std::endl;
+        std::cout << std::endl;
+    }
+    if (std::any_of(stats.energy_by_type.begin(), stats.energy_by_type.end(),
+                    [](const TypeEnergy& type) { return type.tasks_run > 0; })) {
+        std::cout << "Energy by Task Type:";
+        for (size_t i = 0; i < stats.energy_by_type.size(); ++i) {
+            const TypeEnergy& type = stats.energy_by_type[i];
+            if (type.tasks_run > 0) {
+                std::cout << " " << kTaskTypeNames[i] << "=" << formatEnergy(type.getEnergy()) << " ("
+                          << type.tasks_run << " run, " << type.tasks_completed << " completed)";
+            }
         }
+        std::cout << std::endl;
+    }
+    
+    if (stats.latency.turnaround.getCount() > 0) {
+        std::cout << "Average Turnaround Time: "
+                  << formatDuration(static_cast<int>(stats.latency.turnaround.getMean())) << std::endl;
+        std::cout << "Turnaround: " << formatPercentiles(stats.latency.turnaround) << std::endl;
+        std::cout << "Waiting:    " << formatPercentiles(stats.latency.waiting) << std::endl;
+        std::cout << "Response:   " << formatPercentiles(stats.latency.response) << std::endl;
+    }
+    std::cout << "Context Switches: " << stats.context_switches
+              << " (" << stats.preemptions << " preemptions)" << std::endl;
+    if (stats.switch_overhead_ticks > 0 || stats.switch_energy_joules > 0.0) {
+        std::cout << "Switch Overhead: " << stats.switch_overhead_ticks << " ticks, "
+                  << formatEnergy(stats.switch_energy_joules) << std::endl;
     }
     
     std::cout << std::string(50, '=') << std::endl;
@@ -44,17 +104,74 @@ bool ReportGenerator::generateCSVReport(const SimulationStats& stats, const std:
         return false;
     }
     
-    file << "scheduler,total_tasks,completed_tasks,execution_time_ticks,total_energy_J,average_power_W,peak_temp_C\n";
+    writeSummaryHeader(file);
+    writeSummaryRow(file, stats);
+    
+    file.close();
+    return true;
+}
+
+bool ReportGenerator::generateComparisonCSV(const std::vector<SimulationStats>& results, const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    writeSummaryHeader(file);
+    for (const auto& stats : results) {
+        writeSummaryRow(file, stats);
+    }
+    
+    file.close();
+    return true;
+}
+
+void ReportGenerator::writeSummaryHeader(std::ofstream& file) {
+    file << "scheduler,total_tasks,completed_tasks,execution_time_ticks,total_energy_J,average_power_W,peak_temp_C,"
+         << "throttled_ticks,throttle_events,throughput_loss_pct,leakage_energy_J,idle_energy_J,wakeups,"
+         << "context_switches,preemptions,switch_overhead_ticks,switch_energy_J,"
+         << "power_capped_ticks,power_cap_loss_pct,contended_ticks,contention_loss_pct,cancelled";
+    for (const char* metric : {"turnaround", "waiting", "response"}) {
+        file << "," << metric << "_p50," << metric << "_p90," << metric << "_p99," << metric << "_p999";
+    }
+    file << ",cpu_bound_energy_J,io_bound_energy_J,memory_heavy_energy_J";
+    file << "\n";
+}
+
+void ReportGenerator::writeSummaryRow(std::ofstream& file, const SimulationStats& stats) {
     file << stats.scheduler_name << ","
          << stats.total_tasks << ","
          << stats.completed_tasks.size() << ","
          << stats.total_execution_time << ","
          << std::fixed << std::setprecision(6) << stats.total_energy_joules << ","
          << std::fixed << std::setprecision(3) << stats.average_power_watts << ","
-         << std::fixed << std::setprecision(2) << stats.peak_temperature_celsius << "\n";
-    
-    file.close();
-    return true;
+         << std::fixed << std::setprecision(2) << stats.peak_temperature_celsius << ","
+         << stats.throttled_time_ticks << ","
+         << stats.throttle_events << ","
+         << std::fixed << std::setprecision(2) << stats.throughput_loss_percent << ","
+         << std::fixed << std::setprecision(6) << stats.leakage_energy_joules << ","
+         << std::fixed << std::setprecision(6) << stats.idle_energy_joules << ","
+         << stats.wakeups << ","
+         << stats.context_switches << ","
+         << stats.preemptions << ","
+         << stats.switch_overhead_ticks << ","
+         << std::fixed << std::setprecision(6) << stats.switch_energy_joules << ","
+         << stats.power_capped_ticks << ","
+         << std::fixed << std::setprecision(2) << stats.power_cap_loss_percent << ","
+         << stats.contended_ticks << ","
+         << std::fixed << std::setprecision(2) << stats.contention_loss_percent << ","
+         << (stats.cancelled ? 1 : 0);
+    for (const LatencyHistogram* histogram : {&stats.latency.turnaround, &stats.latency.waiting,
+                                              &stats.latency.response}) {
+        for (double p : {0.50, 0.90, 0.99, 0.999}) {
+            file << "," << histogram->percentile(p);
+        }
+    }
+    for (size_t i = 0; i < kTaskTypes; ++i) {
+        double energy = (i < stats.energy_by_type.size()) ? stats.energy_by_type[i].getEnergy() : 0.0;
+        file << "," << std::fixed << std::setprecision(6) << energy;
+    }
+    file << "\n";
 }
 
 bool ReportGenerator::generateTaskCSV(const SimulationStats& stats, const std::string& filename) {
@@ -63,19 +180,32 @@ bool ReportGenerator::generateTaskCSV(const SimulationStats& stats, const std::s
         return false;
     }
     
-    file << "task_id,start_time,end_time,duration,type,scheduler,turnaround_time\n";
+    file << "task_id,arrival_time,start_time,end_time,duration,type,scheduler,turnaround_time,"
+         << "response_time,wait_time,preemptions,context_switches,energy_J,active_energy_J,idle_energy_share_J,"
+         << "peak_temp_C\n";
     
-    for (const auto& task : stats.completed_tasks) {
-        int turnaround_time = (task.getStartTime() >= 0 && task.getEndTime() >= 0) ?
-                             task.getEndTime() - task.getStartTime() : -1;
+    for (size_t i = 0; i < stats.completed_tasks.size(); ++i) {
+        const Task& task = stats.completed_tasks[i];
+        TaskEnergy energy = (i < stats.task_energy.size()) ? stats.task_energy[i] : TaskEnergy{0.0, 0.0, 0.0};
+        int turnaround_time = (task.getEndTime() >= 0) ? task.getEndTime() - task.getArrivalTime() : -1;
+        int response_time = (task.getFirstRunTime() >= 0) ? task.getFirstRunTime() - task.getArrivalTime() : -1;
         
         file << task.getId() << ","
+             << task.getArrivalTime() << ","
              << task.getStartTime() << ","
              << task.getEndTime() << ","
              << task.getDuration() << ","
              << task.getTypeString() << ","
              << stats.scheduler_name << ","
-             << turnaround_time << "\n";
+             << turnaround_time << ","
+             << response_time << ","
+             << task.getWaitTime() << ","
+             << task.getPreemptions() << ","
+             << task.getContextSwitches() << ","
+             << std::fixed << std::setprecision(6) << energy.getEnergy() << ","
+             << std::fixed << std::setprecision(6) << energy.active_energy_joules << ","
+             << std::fixed << std::setprecision(6) << energy.idle_energy_joules << ","
+             << std::fixed << std::setprecision(2) << energy.peak_temperature_celsius << "\n";
     }
     
     file.close();
@@ -85,17 +215,22 @@ bool ReportGenerator::generateTaskCSV(const SimulationStats& stats, const std::s
 void ReportGenerator::compareResults(const std::vector<SimulationStats>& results) {
     if (results.empty()) return;
     
-    std::cout << "\n" << std::string(80, '=') << std::endl;
+    std::cout << "\n" << std::string(128, '=') << std::endl;
     std::cout << "                    SCHEDULER COMPARISON" << std::endl;
-    std::cout << std::string(80, '=') << std::endl;
+    std::cout << std::string(128, '=') << std::endl;
     
     std::cout << std::left << std::setw(15) << "Scheduler"
               << std::setw(12) << "Tasks"
               << std::setw(12) << "Time (ticks)"
               << std::setw(15) << "Energy (J)"
               << std::setw(12) << "Avg Power (W)"
-              << std::setw(12) << "Peak Temp (°C)" << std::endl;
-    std::cout << std::string(80, '-') << std::endl;
+              << std::setw(15) << "Peak Temp (°C)"
+              << std::setw(12) << "Throttled"
+              << std::setw(12) << "Turn p50"
+              << std::setw(12) << "Turn p99"
+              << std::setw(12) << "Turn p99.9"
+              << std::setw(12) << "Resp p99" << std::endl;
+    std::cout << std::string(128, '-') << std::endl;
     
     for (const auto& stat : results) {
         std::cout << std::left << std::setw(15) << stat.scheduler_name
@@ -103,9 +238,219 @@ void ReportGenerator::compareResults(const std::vector<SimulationStats>& results
                   << std::setw(12) << stat.total_execution_time
                   << std::setw(15) << std::fixed << std::setprecision(6) << stat.total_energy_joules
                   << std::setw(12) << std::fixed << std::setprecision(3) << stat.average_power_watts
-                  << std::setw(12) << std::fixed << std::setprecision(2) << stat.peak_temperature_celsius << std::endl;
+                  << std::setw(15) << std::fixed << std::setprecision(2) << stat.peak_temperature_celsius
+                  << std::setw(12) << stat.throttled_time_ticks
+                  << std::setw(12) << stat.latency.turnaround.percentile(0.50)
+                  << std::setw(12) << stat.latency.turnaround.percentile(0.99)
+                  << std::setw(12) << stat.latency.turnaround.percentile(0.999)
+                  << std::setw(12) << stat.latency.response.percentile(0.99) << std::endl;
     }
+    std::cout << std::string(128, '=') << std::endl;
+    for (const auto& stat : results) {
+        if (stat.cancelled) {
+            std::cout << stat.scheduler_name << " was cancelled at tick " << stat.total_execution_time
+                      << ": its figures are partial" << std::endl;
+        }
+    }
+    printPowerCurves(results);
+    printTypeEnergy(results);
+}
+
+void ReportGenerator::printPowerCurves(const std::vector<SimulationStats>& results) {
+    size_t bins = 0;
+    for (const auto& stat : results) {
+        bins = std::max(bins, stat.power_curve.size());
+    }
+    if (bins < 2) {
+        return;
+    }
+    // Busy core counts are merged into at most ten utilization steps
+    int cores = static_cast<int>(bins) - 1;
+    int steps = std::min(cores, 10);
+    size_t width = 18 + 9 * (steps + 1) + 12;
+    
+    std::cout << "\n" << std::string(width, '=') << std::endl;
+    std::cout << "                    ENERGY PROPORTIONALITY (average W by utilization)" << std::endl;
+    std::cout << std::string(width, '=') << std::endl;
+    std::cout << std::left << std::setw(18) << "Scheduler";
+    for (int step = 0; step <= steps; ++step) {
+        std::cout << std::setw(9) << (std::to_string(100 * step / steps) + "%");
+    }
+    std::cout << std::setw(12) << "Idle/Peak" << std::endl;
+    std::cout << std::string(width, '-') << std::endl;
+    
+    for (const auto& stat : results) {
+        if (stat.power_curve.size() != bins) {
+            continue;
+        }
+        std::vector<UtilizationBin> merged(steps + 1, UtilizationBin{0, 0, 0.0});
+        for (const UtilizationBin& bin : stat.power_curve) {
+            UtilizationBin& step = merged[(bin.busy_cores * steps + cores / 2) / cores];
+            step.ticks += bin.ticks;
+            step.energy_joules += bin.energy_joules;
+        }
+        std::cout << std::left << std::setw(18) << stat.scheduler_name;
+        for (const UtilizationBin& step : merged) {
+            std::ostringstream cell;
+            if (step.ticks > 0) {
+                cell << std::fixed << std::setprecision(3) << step.getAveragePower();
+            } else {
+                cell << "-";
+            }
+            std::cout << std::setw(9) << cell.str();
+        }
+        // Lower is more proportional: the share of peak power drawn doing nothing
+        const UtilizationBin& idle = merged.front();
+        const UtilizationBin& peak = merged.back();
+        if (idle.ticks > 0 && peak.ticks > 0) {
+            std::cout << std::fixed << std::setprecision(3) << idle.getAveragePower() / peak.getAveragePower();
+        } else {
+            std::cout << "-";
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::string(width, '=') << std::endl;
+}
+
+void ReportGenerator::printTypeEnergy(const std::vector<SimulationStats>& results) {
+    if (std::none_of(results.begin(), results.end(),
+                     [](const SimulationStats& stat) { return !stat.energy_by_type.empty(); })) {
+        return;
+    }
+    // Batch lanes carry their seed in the name, so the column fits the longest
+    size_t name_width = 24;
+    for (const auto& stat : results) {
+        name_width = std::max(name_width, stat.scheduler_name.size() + 2);
+    }
+    size_t width = name_width + 24 * kTaskTypes;
+    
+    std::cout << "\n" << std::string(width, '=') << std::endl;
+    std::cout << "                    ENERGY BY TASK TYPE (mJ per completed task, share of total)" << std::endl;
+    std::cout << std::string(width, '=') << std::endl;
+    std::cout << std::left << std::setw(name_width) << "Scheduler";
+    for (size_t i = 0; i < kTaskTypes; ++i) {
+        std::cout << std::setw(24) << kTaskTypeNames[i];
+    }
+    std::cout << std::endl;
+    std::cout << std::string(width, '-') << std::endl;
+    
+    for (const auto& stat : results) {
+        std::cout << std::left << std::setw(name_width) << stat.scheduler_name;
+        for (size_t i = 0; i < kTaskTypes; ++i) {
+            std::ostringstream cell;
+            if (i < stat.energy_by_type.size() && stat.energy_by_type[i].tasks_completed > 0) {
+                const TypeEnergy& type = stat.energy_by_type[i];
+                double share = (stat.total_energy_joules > 0.0) ? type.getEnergy() / stat.total_energy_joules : 0.0;
+                cell << std::fixed << std::setprecision(3) << 1000.0 * type.getEnergy() / type.tasks_completed << " ("
+                     << std::setprecision(1) << 100.0 * share << "%)";
+            } else {
+                cell << "-";
+            }
+            std::cout << std::setw(24) << cell.str();
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::string(width, '=') << std::endl;
+}
+
+bool ReportGenerator::generatePowerCurveCSV(const std::vector<SimulationStats>& results, const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    file << "scheduler,busy_cores,utilization,ticks,energy_J,average_power_W\n";
+    for (const auto& stats : results) {
+        int cores = static_cast<int>(stats.power_curve.size()) - 1;
+        for (const UtilizationBin& bin : stats.power_curve) {
+            file << stats.scheduler_name << ","
+                 << bin.busy_cores << ","
+                 << std::fixed << std::setprecision(4) << static_cast<double>(bin.busy_cores) / cores << ","
+                 << bin.ticks << ","
+                 << std::fixed << std::setprecision(6) << bin.energy_joules << ","
+                 << std::fixed << std::setprecision(3) << bin.getAveragePower() << "\n";
+        }
+    }
+    
+    file.close();
+    return true;
+}
+
+void ReportGenerator::printQuantumTuning(const std::vector<QuantumTuner::Trial>& trials, int best_quantum) {
+    std::cout << "\n" << std::string(80, '=') << std::endl;
+    std::cout << "                    ROUND-ROBIN QUANTUM TUNING" << std::endl;
     std::cout << std::string(80, '=') << std::endl;
+    
+    std::cout << std::left << std::setw(10) << "Quantum"
+              << std::setw(10) << "Tasks"
+              << std::setw(14) << "Energy (J)"
+              << std::setw(14) << "mJ / task"
+              << std::setw(12) << "Switches"
+              << std::setw(12) << "Overhead"
+              << std::setw(10) << "Turn p99" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+    
+    for (const auto& trial : trials) {
+        const SimulationStats& stat = trial.stats;
+        std::cout << std::left << std::setw(10) << (std::to_string(trial.quantum) + (trial.quantum == best_quantum ? " *" : ""))
+                  << std::setw(10) << stat.total_tasks
+                  << std::setw(14) << std::fixed << std::setprecision(6) << stat.total_energy_joules
+                  << std::setw(14) << std::fixed << std::setprecision(3) << trial.energy_per_task * 1000.0
+                  << std::setw(12) << stat.context_switches
+                  << std::setw(12) << stat.switch_overhead_ticks
+                  << std::setw(10) << stat.latency.turnaround.percentile(0.99) << std::endl;
+    }
+    std::cout << std::string(80, '=') << std::endl;
+    std::cout << "Best quantum: " << best_quantum << " ticks (" << trials.size() << " quanta simulated)" << std::endl;
+}
+
+void ReportGenerator::printParetoFront(const std::vector<TunerDimension>& space,
+                                       const std::vector<AutoTuner::Candidate>& front) {
+    size_t width = 36 + 16 * space.size();
+    std::cout << "\n" << std::string(width, '=') << std::endl;
+    std::cout << "                    ENERGY / LATENCY PARETO FRONT" << std::endl;
+    std::cout << std::string(width, '=') << std::endl;
+    
+    std::cout << std::left;
+    for (const auto& dim : space) {
+        std::cout << std::setw(16) << dim.name;
+    }
+    std::cout << std::setw(12) << "mJ / task" << std::setw(12) << "Turn p99" << std::setw(12) << "Tasks" << std::endl;
+    std::cout << std::string(width, '-') << std::endl;
+    
+    for (const auto& candidate : front) {
+        for (size_t i = 0; i < space.size(); ++i) {
+            std::cout << std::setw(16) << space[i].format(candidate.params[i]);
+        }
+        std::cout << std::setw(12) << std::fixed << std::setprecision(3) << candidate.energy_per_task * 1000.0
+                  << std::setw(12) << static_cast<long long>(candidate.latency)
+                  << std::setw(12) << candidate.completed << std::endl;
+    }
+    std::cout << std::string(width, '=') << std::endl;
+}
+
+bool ReportGenerator::generateParetoCSV(const std::vector<TunerDimension>& space,
+                                        const std::vector<AutoTuner::Candidate>& front, const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    for (const auto& dim : space) {
+        file << dim.name << ",";
+    }
+    file << "energy_per_task_J,turnaround_p99,completed_tasks\n";
+    for (const auto& candidate : front) {
+        for (size_t i = 0; i < space.size(); ++i) {
+            file << space[i].format(candidate.params[i]) << ",";
+        }
+        file << std::fixed << std::setprecision(6) << candidate.energy_per_task << ","
+             << static_cast<long long>(candidate.latency) << ","
+             << candidate.completed << "\n";
+    }
+    
+    file.close();
+    return true;
 }
 
 std::string ReportGenerator::formatDuration(int ticks) {
@@ -143,3 +488,12 @@ std::string ReportGenerator::formatTemperature(double celsius) {
     oss << std::fixed << std::setprecision(2) << celsius << " °C";
     return oss.str();
 }
+
+std::string ReportGenerator::formatPercentiles(const LatencyHistogram& histogram) {
+    std::ostringstream oss;
+    oss << "p50 " << histogram.percentile(0.50)
+        << ", p90 " << histogram.percentile(0.90)
+        << ", p99 " << histogram.percentile(0.99)
+        << ", p99.9 " << histogram.percentile(0.999) << " ticks";
+    return oss.str();
+}
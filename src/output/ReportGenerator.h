@@ -2,6 +2,8 @@
 #define REPORT_GENERATOR_H
 
 #include "core/SimulationEngine.h"
+#include "core/QuantumTuner.h"
+#include "core/AutoTuner.h"
 #include <string>
 #include <fstream>
 
@@ -13,17 +15,39 @@ public:
     // Generate CSV report
     static bool generateCSVReport(const SimulationStats& stats, const std::string& filename);
     
+    // Generate CSV with one row per simulation result
+    static bool generateComparisonCSV(const std::vector<SimulationStats>& results, const std::string& filename);
+    
     // Generate detailed task CSV
     static bool generateTaskCSV(const SimulationStats& stats, const std::string& filename);
     
     // Compare multiple simulation results
     static void compareResults(const std::vector<SimulationStats>& results);
     
+    // Average power against utilization for multi-core runs, one row per bin
+    static bool generatePowerCurveCSV(const std::vector<SimulationStats>& results, const std::string& filename);
+    
+    // Print every quantum evaluated by a tuning run, marking the best
+    static void printQuantumTuning(const std::vector<QuantumTuner::Trial>& trials, int best_quantum);
+    
+    // Energy-vs-latency Pareto front of a parameter search
+    static void printParetoFront(const std::vector<TunerDimension>& space,
+                                 const std::vector<AutoTuner::Candidate>& front);
+    static bool generateParetoCSV(const std::vector<TunerDimension>& space,
+                                  const std::vector<AutoTuner::Candidate>& front, const std::string& filename);
+    
 private:
     static std::string formatDuration(int ticks);
     static std::string formatEnergy(double joules);
     static std::string formatPower(double watts);
     static std::string formatTemperature(double celsius);
+    static std::string formatPercentiles(const LatencyHistogram& histogram);
+    
+    static void printPowerCurves(const std::vector<SimulationStats>& results);
+    static void printTypeEnergy(const std::vector<SimulationStats>& results);
+    
+    static void writeSummaryHeader(std::ofstream& file);
+    static void writeSummaryRow(std::ofstream& file, const SimulationStats& stats);
 };
 
 #endif // REPORT_GENERATOR_H
@@ -0,0 +1,245 @@
+#include "ResultCache.h"
+#include "core/Serialization.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <functional>
+#include <thread>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char kEntryMagic[] = "PPRC";
+const uint64_t kEntryVersion = 1;
+
+uint64_t fnv1a(const uint8_t* data, size_t size, uint64_t hash) {
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+// Finalizer from splitmix64, used to derive the second half of the key
+uint64_t mix(uint64_t value) {
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+} // namespace
+
+void ResultCache::writeStats(BinaryWriter& writer, const SimulationStats& stats) {
+    writer.writeInt(stats.total_tasks);
+    writer.writeInt(stats.total_execution_time);
+    writer.writeDouble(stats.total_energy_joules);
+    writer.writeDouble(stats.average_power_watts);
+    writer.writeDouble(stats.peak_temperature_celsius);
+    writer.writeInt(stats.throttled_time_ticks);
+    writer.writeInt(stats.throttle_events);
+    writer.writeDouble(stats.throughput_loss_percent);
+    writer.writeInt(stats.power_capped_ticks);
+    writer.writeDouble(stats.power_cap_loss_percent);
+    writer.writeInt(stats.contended_ticks);
+    writer.writeDouble(stats.contention_loss_percent);
+    writer.writeDouble(stats.leakage_energy_joules);
+    writer.writeDouble(stats.idle_energy_joules);
+    writer.writeInt(stats.wakeups);
+    writer.writeInt(stats.context_switches);
+    writer.writeInt(stats.preemptions);
+    writer.writeInt(stats.switch_overhead_ticks);
+    writer.writeDouble(stats.switch_energy_joules);
+    writer.writeBool(stats.cancelled);
+    writer.writeUInt(stats.cstate_residency.size());
+    for (const auto& entry : stats.cstate_residency) {
+        writer.writeString(entry.first);
+        writer.writeInt(entry.second);
+    }
+    writer.writeUInt(stats.cores.size());
+    for (const auto& core : stats.cores) {
+        writer.writeString(core.type);
+        writer.writeInt(core.busy_ticks);
+        writer.writeInt(core.tasks_dispatched);
+        writer.writeDouble(core.energy_joules);
+        writer.writeDouble(core.average_frequency_ghz);
+    }
+    writer.writeUInt(stats.power_curve.size());
+    for (const auto& bin : stats.power_curve) {
+        writer.writeInt(bin.busy_cores);
+        writer.writeInt(bin.ticks);
+        writer.writeDouble(bin.energy_joules);
+    }
+    writer.writeUInt(stats.energy_by_type.size());
+    for (const auto& type : stats.energy_by_type) {
+        writer.writeInt(type.tasks_run);
+        writer.writeInt(type.tasks_completed);
+        writer.writeDouble(type.active_energy_joules);
+        writer.writeDouble(type.idle_energy_joules);
+        writer.writeDouble(type.peak_temperature_celsius);
+    }
+    stats.latency.save(writer);
+    writer.writeString(stats.scheduler_name);
+    writer.writeUInt(stats.completed_tasks.size());
+    for (const auto& task : stats.completed_tasks) {
+        task.save(writer);
+    }
+    writer.writeUInt(stats.task_energy.size());
+    for (const auto& energy : stats.task_energy) {
+        writer.writeDouble(energy.active_energy_joules);
+        writer.writeDouble(energy.idle_energy_joules);
+        writer.writeDouble(energy.peak_temperature_celsius);
+    }
+}
+
+SimulationStats ResultCache::readStats(BinaryReader& reader) {
+    SimulationStats stats;
+    stats.total_tasks = static_cast<int>(reader.readInt());
+    stats.total_execution_time = static_cast<int>(reader.readInt());
+    stats.total_energy_joules = reader.readDouble();
+    stats.average_power_watts = reader.readDouble();
+    stats.peak_temperature_celsius = reader.readDouble();
+    stats.throttled_time_ticks = static_cast<int>(reader.readInt());
+    stats.throttle_events = static_cast<int>(reader.readInt());
+    stats.throughput_loss_percent = reader.readDouble();
+    stats.power_capped_ticks = static_cast<int>(reader.readInt());
+    stats.power_cap_loss_percent = reader.readDouble();
+    stats.contended_ticks = static_cast<int>(reader.readInt());
+    stats.contention_loss_percent = reader.readDouble();
+    stats.leakage_energy_joules = reader.readDouble();
+    stats.idle_energy_joules = reader.readDouble();
+    stats.wakeups = static_cast<int>(reader.readInt());
+    stats.context_switches = static_cast<int>(reader.readInt());
+    stats.preemptions = static_cast<int>(reader.readInt());
+    stats.switch_overhead_ticks = static_cast<int>(reader.readInt());
+    stats.switch_energy_joules = reader.readDouble();
+    stats.cancelled = reader.readBool();
+    stats.cstate_residency.resize(reader.readUInt());
+    for (auto& entry : stats.cstate_residency) {
+        entry.first = reader.readString();
+        entry.second = static_cast<int>(reader.readInt());
+    }
+    stats.cores.resize(reader.readUInt());
+    for (auto& core : stats.cores) {
+        core.type = reader.readString();
+        core.busy_ticks = static_cast<int>(reader.readInt());
+        core.tasks_dispatched = static_cast<int>(reader.readInt());
+        core.energy_joules = reader.readDouble();
+        core.average_frequency_ghz = reader.readDouble();
+    }
+    stats.power_curve.resize(reader.readUInt());
+    for (auto& bin : stats.power_curve) {
+        bin.busy_cores = static_cast<int>(reader.readInt());
+        bin.ticks = static_cast<int>(reader.readInt());
+        bin.energy_joules = reader.readDouble();
+    }
+    stats.energy_by_type.resize(reader.readUInt());
+    for (auto& type : stats.energy_by_type) {
+        type.tasks_run = static_cast<int>(reader.readInt());
+        type.tasks_completed = static_cast<int>(reader.readInt());
+        type.active_energy_joules = reader.readDouble();
+        type.idle_energy_joules = reader.readDouble();
+        type.peak_temperature_celsius = reader.readDouble();
+    }
+    stats.latency.load(reader);
+    stats.scheduler_name = reader.readString();
+    stats.completed_tasks.resize(reader.readUInt());
+    for (auto& task : stats.completed_tasks) {
+        task = Task::load(reader);
+    }
+    stats.task_energy.resize(reader.readUInt());
+    for (auto& energy : stats.task_energy) {
+        energy.active_energy_joules = reader.readDouble();
+        energy.idle_energy_joules = reader.readDouble();
+        energy.peak_temperature_celsius = reader.readDouble();
+    }
+    return stats;
+}
+
+ResultCache::ResultCache(const std::string& directory)
+    : directory_(directory), hits_(0), misses_(0) {
+    mkdir(directory_.c_str(), 0755);
+}
+
+std::string ResultCache::makeKey(const std::vector<uint8_t>& configuration) {
+    uint64_t version = getBinaryVersion();
+    uint64_t high = fnv1a(reinterpret_cast<const uint8_t*>(&version), sizeof(version), 0xcbf29ce484222325ULL);
+    high = fnv1a(configuration.data(), configuration.size(), high);
+    uint64_t low = mix(high ^ fnv1a(configuration.data(), configuration.size(), mix(version)));
+    
+    char key[33];
+    std::snprintf(key, sizeof(key), "%016llx%016llx",
+                  static_cast<unsigned long long>(high), static_cast<unsigned long long>(low));
+    return key;
+}
+
+bool ResultCache::lookup(const std::string& key, SimulationStats& stats) {
+    std::ifstream file(pathForKey(key), std::ios::binary);
+    if (!file.is_open()) {
+        misses_++;
+        return false;
+    }
+    std::vector<uint8_t> entry((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    try {
+        BinaryReader reader(entry);
+        if (reader.readString() != kEntryMagic || reader.readUInt() != kEntryVersion) {
+            misses_++;
+            return false;
+        }
+        stats = readStats(reader);
+    } catch (const std::runtime_error&) {
+        // Truncated or corrupt entry: treat as a miss, it will be rewritten
+        misses_++;
+        return false;
+    }
+    hits_++;
+    return true;
+}
+
+bool ResultCache::store(const std::string& key, const SimulationStats& stats) {
+    BinaryWriter writer;
+    writer.writeString(kEntryMagic);
+    writer.writeUInt(kEntryVersion);
+    writeStats(writer, stats);
+    
+    // Write to a temporary file and rename so concurrent sweeps never see partial
+    // entries; the name is unique per process and thread, as server workers may
+    // store the same key at once
+    std::string path = pathForKey(key);
+    std::string temporary = path + "." + std::to_string(getpid()) + "." +
+                            std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary);
+        if (!file.is_open()) {
+            return false;
+        }
+        const std::vector<uint8_t>& buffer = writer.getBuffer();
+        file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+        if (!file) {
+            return false;
+        }
+    }
+    return std::rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+uint64_t ResultCache::getBinaryVersion() {
+    static const uint64_t version = [] {
+        std::ifstream image("/proc/self/exe", std::ios::binary);
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        if (image.is_open()) {
+            std::vector<char> chunk(1 << 16);
+            while (image.read(chunk.data(), chunk.size()) || image.gcount() > 0) {
+                hash = fnv1a(reinterpret_cast<const uint8_t*>(chunk.data()), image.gcount(), hash);
+            }
+            return hash;
+        }
+        const char stamp[] = __DATE__ " " __TIME__;
+        return fnv1a(reinterpret_cast<const uint8_t*>(stamp), sizeof(stamp), hash);
+    }();
+    return version;
+}
+
+std::string ResultCache::pathForKey(const std::string& key) const {
+    return directory_ + "/" + key + ".ppr";
+}
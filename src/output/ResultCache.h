@@ -0,0 +1,43 @@
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include "core/SimulationEngine.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class BinaryWriter;
+class BinaryReader;
+
+// Content-addressed on-disk store of simulation results. Keys are 128-bit
+// hashes of a canonical encoding of everything that determines a run plus the
+// version of the running binary, so rebuilding invalidates every entry.
+class ResultCache {
+public:
+    explicit ResultCache(const std::string& directory);
+    
+    // Hex key for the given canonical configuration bytes
+    static std::string makeKey(const std::vector<uint8_t>& configuration);
+    
+    bool lookup(const std::string& key, SimulationStats& stats);
+    bool store(const std::string& key, const SimulationStats& stats);
+    
+    int getHits() const { return hits_; }
+    int getMisses() const { return misses_; }
+    
+    // Hash of the executable image (falls back to the build date when unreadable)
+    static uint64_t getBinaryVersion();
+    
+    // Encoding of a result, shared with the simulation server's responses
+    static void writeStats(BinaryWriter& writer, const SimulationStats& stats);
+    static SimulationStats readStats(BinaryReader& reader);
+    
+private:
+    std::string directory_;
+    int hits_;
+    int misses_;
+    
+    std::string pathForKey(const std::string& key) const;
+};
+
+#endif // RESULT_CACHE_H
@@ -0,0 +1,103 @@
+#include "GovernedScheduler.h"
+#include <stdexcept>
+
+GovernedScheduler::GovernedScheduler(std::unique_ptr<Scheduler> inner, std::shared_ptr<PluginLibrary> library,
+                                     const std::string& options)
+    : inner_(std::move(inner)), library_(std::move(library)), governor_(library_->getGovernorPlugin()),
+      options_(options), state_(nullptr), running_(nullptr) {
+    if (governor_ == nullptr) {
+        throw std::runtime_error("plugin " + library_->getPath() + " does not export a governor");
+    }
+    state_ = governor_->create != nullptr ? governor_->create(options_.c_str()) : nullptr;
+    power_policy_ = inner_->getPowerPolicy();
+    pullCounters();
+}
+
+GovernedScheduler::~GovernedScheduler() {
+    if (governor_->destroy != nullptr) {
+        governor_->destroy(state_);
+    }
+}
+
+void GovernedScheduler::pushSettings() {
+    inner_->setThermalHeadroom(thermal_headroom_);
+    inner_->setPowerPolicy(power_policy_);
+}
+
+void GovernedScheduler::pullCounters() {
+    current_tick_ = inner_->getCurrentTick();
+    context_switches_ = inner_->getContextSwitches();
+    preemptions_ = inner_->getPreemptions();
+}
+
+void GovernedScheduler::addTask(const Task& task) {
+    pushSettings();
+    inner_->addTask(task);
+    pullCounters();
+}
+
+Task* GovernedScheduler::getNextTask() {
+    pushSettings();
+    running_ = inner_->getNextTask();
+    pullCounters();
+    return running_;
+}
+
+void GovernedScheduler::taskCompleted(int task_id) {
+    inner_->taskCompleted(task_id);
+    running_ = nullptr;
+    pullCounters();
+}
+
+void GovernedScheduler::taskBlocked(int task_id) {
+    inner_->taskBlocked(task_id);
+    running_ = nullptr;
+    pullCounters();
+}
+
+void GovernedScheduler::tick() {
+    pushSettings();
+    inner_->tick();
+    pullCounters();
+}
+
+void GovernedScheduler::stallTick() {
+    pushSettings();
+    inner_->stallTick();
+    pullCounters();
+}
+
+void GovernedScheduler::advanceTicks(int ticks) {
+    pushSettings();
+    inner_->advanceTicks(ticks);
+    pullCounters();
+}
+
+double GovernedScheduler::getCurrentFrequency() const {
+    pp_context ctx = PluginLibrary::context(*this, running_ != nullptr);
+    pp_task view;
+    if (running_ != nullptr) {
+        view = PluginLibrary::describe(*running_);
+    }
+    int32_t queued = inner_->getActiveTasksCount() - (running_ != nullptr ? 1 : 0);
+    return governor_->select_frequency(state_, &ctx, running_ != nullptr ? &view : nullptr, queued,
+                                       inner_->getCurrentFrequency());
+}
+
+void GovernedScheduler::reset() {
+    inner_->reset();
+    running_ = nullptr;
+    pullCounters();
+    if (governor_->destroy != nullptr) {
+        governor_->destroy(state_);
+    }
+    state_ = governor_->create != nullptr ? governor_->create(options_.c_str()) : nullptr;
+}
+
+void GovernedScheduler::restoreState(const std::vector<Task>& tasks, BinaryReader& reader) {
+    reset();
+    inner_->restoreState(tasks, reader);
+    thermal_headroom_ = inner_->getThermalHeadroom();
+    power_policy_ = inner_->getPowerPolicy();
+    pullCounters();
+}
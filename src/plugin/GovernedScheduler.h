@@ -0,0 +1,49 @@
+#ifndef GOVERNED_SCHEDULER_H
+#define GOVERNED_SCHEDULER_H
+
+#include "scheduler/Scheduler.h"
+#include "plugin/PluginLibrary.h"
+#include <memory>
+
+// Wraps any scheduler and lets a governor plugin pick the frequency: task
+// selection stays with the wrapped policy, whose frequency becomes the
+// governor's "requested" input
+class GovernedScheduler : public Scheduler {
+public:
+    GovernedScheduler(std::unique_ptr<Scheduler> inner, std::shared_ptr<PluginLibrary> library,
+                      const std::string& options = "");
+    ~GovernedScheduler() override;
+    
+    void addTask(const Task& task) override;
+    Task* getNextTask() override;
+    void taskCompleted(int task_id) override;
+    void taskBlocked(int task_id) override;
+    void tick() override;
+    void advanceTicks(int ticks) override;
+    void stallTick() override;
+    std::string getName() const override { return inner_->getName() + " + " + governor_->name; }
+    void reset() override;
+    
+    bool hasTasks() const override { return inner_->hasTasks(); }
+    int getActiveTasksCount() const override { return inner_->getActiveTasksCount(); }
+    double getCurrentFrequency() const override;
+    
+    std::vector<Task> getPendingTasks() const override { return inner_->getPendingTasks(); }
+    void saveState(BinaryWriter& writer) const override { inner_->saveState(writer); }
+    void restoreState(const std::vector<Task>& tasks, BinaryReader& reader) override;
+    
+private:
+    std::unique_ptr<Scheduler> inner_;
+    std::shared_ptr<PluginLibrary> library_;
+    const pp_governor_plugin* governor_;
+    std::string options_;
+    void* state_;
+    Task* running_;     // Wrapped scheduler's last pick
+    
+    // The engine talks to this object: hand its settings down to the wrapped
+    // scheduler before forwarding, and mirror its clock and counters after
+    void pushSettings();
+    void pullCounters();
+};
+
+#endif // GOVERNED_SCHEDULER_H
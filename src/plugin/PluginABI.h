@@ -0,0 +1,89 @@
+/*
+ * Stable C ABI for runtime-loadable scheduling policies.
+ *
+ * A plugin is a shared object exporting pp_scheduler_plugin_v1() and/or
+ * pp_governor_plugin_v1(), each returning a static descriptor. The simulator
+ * consults a scheduler plugin once per scheduling decision with the whole
+ * runnable batch, and the decision holds for a plugin-chosen number of ticks
+ * unless a task arrives, wakes, completes or blocks first. Plugin state is
+ * created per scheduler instance and is not part of snapshots.
+ */
+#ifndef POWERPROFILE_PLUGIN_ABI_H
+#define POWERPROFILE_PLUGIN_ABI_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Bumped whenever a structure below changes layout or meaning */
+#define PP_PLUGIN_ABI_VERSION 1
+
+/* Values of pp_task.type */
+enum { PP_TASK_CPU_BOUND = 0, PP_TASK_IO_BOUND = 1, PP_TASK_MEMORY_HEAVY = 2 };
+
+/* Values of pp_context.power_policy */
+enum { PP_POLICY_BALANCED = 0, PP_POLICY_RACE_TO_IDLE = 1, PP_POLICY_STRETCH = 2 };
+
+/* Read-only view of a runnable task */
+typedef struct pp_task {
+    int32_t id;
+    int32_t type;           /* Type of the work currently executing */
+    int32_t priority;
+    int32_t arrival_time;
+    int32_t remaining;      /* Compute ticks left at the 1 GHz reference */
+    int32_t first_run;      /* -1 before the first dispatch */
+    int32_t wait_time;      /* Ticks spent runnable but not running so far */
+    int32_t preemptions;
+} pp_task;
+
+typedef struct pp_context {
+    int32_t now;
+    int32_t running;           /* 1 when tasks[0] is the task currently on the CPU */
+    int32_t power_policy;
+    double thermal_headroom;   /* Degrees below the throttle trip point */
+} pp_context;
+
+typedef struct pp_scheduler_plugin {
+    uint32_t abi_version;      /* PP_PLUGIN_ABI_VERSION */
+    const char* name;
+    
+    /* Per-instance state; options is the --plugin-options string (never NULL) */
+    void* (*create)(const char* options);
+    void (*destroy)(void* state);
+    
+    /* Pick the task to run from tasks[0..count) and return its index, or -1 to
+       leave the CPU idle (preempting the running task, if any). Set *hold to
+       the number of ticks (>= 1) the choice stands. */
+    int32_t (*pick_next)(void* state, const pp_context* ctx, const pp_task* tasks, int32_t count, int32_t* hold);
+    
+    /* Optional: frequency in GHz for the picked task (NULL when idle); queued
+       counts the runnable tasks not on the CPU. Defaults to 1 GHz when absent. */
+    double (*select_frequency)(void* state, const pp_context* ctx, const pp_task* task, int32_t queued);
+} pp_scheduler_plugin;
+
+typedef struct pp_governor_plugin {
+    uint32_t abi_version;      /* PP_PLUGIN_ABI_VERSION */
+    const char* name;
+    
+    void* (*create)(const char* options);
+    void (*destroy)(void* state);
+    
+    /* Frequency in GHz, given the wrapped scheduler's request, the running task
+       (NULL when idle) and the number of queued tasks; called once per tick */
+    double (*select_frequency)(void* state, const pp_context* ctx, const pp_task* task, int32_t queued,
+                               double requested);
+} pp_governor_plugin;
+
+#define PP_SCHEDULER_PLUGIN_SYMBOL "pp_scheduler_plugin_v1"
+#define PP_GOVERNOR_PLUGIN_SYMBOL "pp_governor_plugin_v1"
+
+typedef const pp_scheduler_plugin* (*pp_scheduler_plugin_entry)(void);
+typedef const pp_governor_plugin* (*pp_governor_plugin_entry)(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* POWERPROFILE_PLUGIN_ABI_H */
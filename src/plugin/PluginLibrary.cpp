@@ -0,0 +1,62 @@
+#include "PluginLibrary.h"
+#include "scheduler/Scheduler.h"
+#include <dlfcn.h>
+#include <stdexcept>
+
+std::shared_ptr<PluginLibrary> PluginLibrary::open(const std::string& path) {
+    // RTLD_LOCAL keeps the symbols of different plugins apart
+    void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (handle == nullptr) {
+        throw std::runtime_error("cannot load plugin " + path + ": " + dlerror());
+    }
+    std::shared_ptr<PluginLibrary> library(new PluginLibrary(path, handle));
+    if (library->scheduler_ == nullptr && library->governor_ == nullptr) {
+        throw std::runtime_error("plugin " + path + " exports no scheduler or governor for ABI version " +
+                                 std::to_string(PP_PLUGIN_ABI_VERSION));
+    }
+    return library;
+}
+
+PluginLibrary::PluginLibrary(const std::string& path, void* handle)
+    : path_(path), handle_(handle), scheduler_(nullptr), governor_(nullptr) {
+    auto scheduler_entry = reinterpret_cast<pp_scheduler_plugin_entry>(dlsym(handle_, PP_SCHEDULER_PLUGIN_SYMBOL));
+    if (scheduler_entry != nullptr) {
+        const pp_scheduler_plugin* plugin = scheduler_entry();
+        if (plugin != nullptr && plugin->abi_version == PP_PLUGIN_ABI_VERSION && plugin->pick_next != nullptr) {
+            scheduler_ = plugin;
+        }
+    }
+    auto governor_entry = reinterpret_cast<pp_governor_plugin_entry>(dlsym(handle_, PP_GOVERNOR_PLUGIN_SYMBOL));
+    if (governor_entry != nullptr) {
+        const pp_governor_plugin* plugin = governor_entry();
+        if (plugin != nullptr && plugin->abi_version == PP_PLUGIN_ABI_VERSION && plugin->select_frequency != nullptr) {
+            governor_ = plugin;
+        }
+    }
+}
+
+PluginLibrary::~PluginLibrary() {
+    dlclose(handle_);
+}
+
+pp_task PluginLibrary::describe(const Task& task) {
+    pp_task view;
+    view.id = task.getId();
+    view.type = static_cast<int32_t>(task.getExecutionType());
+    view.priority = task.getPriority();
+    view.arrival_time = task.getArrivalTime();
+    view.remaining = task.getRemainingTime();
+    view.first_run = task.getFirstRunTime();
+    view.wait_time = task.getWaitTime();
+    view.preemptions = task.getPreemptions();
+    return view;
+}
+
+pp_context PluginLibrary::context(const Scheduler& scheduler, bool running) {
+    pp_context ctx;
+    ctx.now = scheduler.getCurrentTick();
+    ctx.running = running ? 1 : 0;
+    ctx.power_policy = static_cast<int32_t>(scheduler.getPowerPolicy());
+    ctx.thermal_headroom = scheduler.getThermalHeadroom();
+    return ctx;
+}
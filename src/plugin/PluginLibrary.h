@@ -0,0 +1,41 @@
+#ifndef PLUGIN_LIBRARY_H
+#define PLUGIN_LIBRARY_H
+
+#include "plugin/PluginABI.h"
+#include "tasks/Task.h"
+#include <memory>
+#include <string>
+
+class Scheduler;
+
+// A dlopen'ed plugin. Schedulers built from it share ownership, so the library
+// stays loaded for as long as any of them exists.
+class PluginLibrary {
+public:
+    // Throws std::runtime_error when the library cannot be loaded or exports
+    // neither entry point with a matching ABI version
+    static std::shared_ptr<PluginLibrary> open(const std::string& path);
+    ~PluginLibrary();
+    
+    PluginLibrary(const PluginLibrary&) = delete;
+    PluginLibrary& operator=(const PluginLibrary&) = delete;
+    
+    // Null when the library does not export that kind of plugin
+    const pp_scheduler_plugin* getSchedulerPlugin() const { return scheduler_; }
+    const pp_governor_plugin* getGovernorPlugin() const { return governor_; }
+    const std::string& getPath() const { return path_; }
+    
+    // Fill the ABI view of a task
+    static pp_task describe(const Task& task);
+    static pp_context context(const Scheduler& scheduler, bool running);
+
+private:
+    explicit PluginLibrary(const std::string& path, void* handle);
+    
+    std::string path_;
+    void* handle_;
+    const pp_scheduler_plugin* scheduler_;
+    const pp_governor_plugin* governor_;
+};
+
+#endif // PLUGIN_LIBRARY_H
@@ -0,0 +1,158 @@
+#include "PluginScheduler.h"
+#include "core/Serialization.h"
+#include <algorithm>
+#include <stdexcept>
+
+PluginScheduler::PluginScheduler(std::shared_ptr<PluginLibrary> library, const std::string& options)
+    : library_(std::move(library)), plugin_(library_->getSchedulerPlugin()), options_(options), state_(nullptr),
+      has_running_(false), hold_(0), changed_(false), frequency_(1.0) {
+    if (plugin_ == nullptr) {
+        throw std::runtime_error("plugin " + library_->getPath() + " does not export a scheduler");
+    }
+    state_ = plugin_->create != nullptr ? plugin_->create(options_.c_str()) : nullptr;
+}
+
+PluginScheduler::~PluginScheduler() {
+    if (plugin_->destroy != nullptr) {
+        plugin_->destroy(state_);
+    }
+}
+
+void PluginScheduler::addTask(const Task& task) {
+    ready_.push_back(task);
+    noteReady(ready_.back());
+    changed_ = true;
+}
+
+Task* PluginScheduler::getNextTask() {
+    if (has_running_ && running_.isCompleted()) {
+        has_running_ = false;
+    }
+    if (hold_ <= 0 || changed_) {
+        consult();
+    }
+    return has_running_ ? &running_ : nullptr;
+}
+
+void PluginScheduler::consult() {
+    // Batch layout: the running task (if any) first, then the ready tasks in queue order
+    batch_.clear();
+    if (has_running_) {
+        batch_.push_back(PluginLibrary::describe(running_));
+    }
+    for (const Task& task : ready_) {
+        batch_.push_back(PluginLibrary::describe(task));
+    }
+    pp_context ctx = PluginLibrary::context(*this, has_running_);
+    int32_t hold = 1;
+    int32_t choice = batch_.empty() ? -1
+                                    : plugin_->pick_next(state_, &ctx, batch_.data(),
+                                                         static_cast<int32_t>(batch_.size()), &hold);
+    if (choice >= static_cast<int32_t>(batch_.size())) {
+        choice = -1;
+    }
+    hold_ = std::max(1, hold);
+    changed_ = false;
+    
+    int offset = has_running_ ? 1 : 0;
+    if (!(has_running_ && choice == 0)) {
+        if (has_running_) {
+            notePreemption(running_);
+            ready_.push_back(running_);
+            has_running_ = false;
+        }
+        if (choice >= offset) {
+            running_ = ready_[choice - offset];
+            ready_.erase(ready_.begin() + (choice - offset));
+            has_running_ = true;
+            noteDispatch(running_);
+        }
+    }
+    
+    frequency_ = 1.0;
+    if (plugin_->select_frequency != nullptr) {
+        ctx.running = has_running_ ? 1 : 0;
+        pp_task view;
+        if (has_running_) {
+            view = PluginLibrary::describe(running_);
+        }
+        frequency_ = plugin_->select_frequency(state_, &ctx, has_running_ ? &view : nullptr,
+                                               static_cast<int32_t>(ready_.size()));
+    }
+}
+
+void PluginScheduler::taskCompleted(int task_id) {
+    if (has_running_ && running_.getId() == task_id) {
+        has_running_ = false;
+    }
+    changed_ = true;
+}
+
+void PluginScheduler::taskBlocked(int task_id) {
+    if (has_running_ && running_.getId() == task_id) {
+        has_running_ = false;
+    }
+    changed_ = true;
+}
+
+void PluginScheduler::tick() {
+    current_tick_++;
+    hold_--;
+}
+
+void PluginScheduler::stallTick() {
+    current_tick_++;
+}
+
+void PluginScheduler::advanceTicks(int ticks) {
+    current_tick_ += ticks;
+    hold_ -= ticks;
+}
+
+void PluginScheduler::reset() {
+    ready_.clear();
+    has_running_ = false;
+    hold_ = 0;
+    changed_ = false;
+    frequency_ = 1.0;
+    current_tick_ = 0;
+    resetCounters();
+    // Fresh plugin state, as for a newly constructed scheduler
+    if (plugin_->destroy != nullptr) {
+        plugin_->destroy(state_);
+    }
+    state_ = plugin_->create != nullptr ? plugin_->create(options_.c_str()) : nullptr;
+}
+
+std::vector<Task> PluginScheduler::getPendingTasks() const {
+    std::vector<Task> tasks;
+    if (has_running_ && !running_.isCompleted()) {
+        tasks.push_back(running_);
+    }
+    tasks.insert(tasks.end(), ready_.begin(), ready_.end());
+    return tasks;
+}
+
+void PluginScheduler::saveState(BinaryWriter& writer) const {
+    Scheduler::saveState(writer);
+    writer.writeBool(has_running_ && !running_.isCompleted());
+    writer.writeInt(hold_);
+    writer.writeBool(changed_);
+    writer.writeDouble(frequency_);
+}
+
+void PluginScheduler::restoreState(const std::vector<Task>& tasks, BinaryReader& reader) {
+    reset();
+    Scheduler::restoreState(tasks, reader);
+    bool has_current = reader.readBool();
+    hold_ = static_cast<int>(reader.readInt());
+    changed_ = reader.readBool();
+    frequency_ = reader.readDouble();
+    size_t first_queued = 0;
+    if (has_current && !tasks.empty()) {
+        running_ = tasks[0];
+        has_running_ = true;
+        first_queued = 1;
+    }
+    ready_.assign(tasks.begin() + first_queued, tasks.end());
+}
@@ -0,0 +1,52 @@
+#ifndef PLUGIN_SCHEDULER_H
+#define PLUGIN_SCHEDULER_H
+
+#include "scheduler/Scheduler.h"
+#include "plugin/PluginLibrary.h"
+#include <memory>
+#include <vector>
+
+// Scheduling policy implemented by a plugin's pick_next callback. The plugin is
+// consulted with the full runnable batch only when its last decision expires or
+// the batch changes, so the per-tick cost is the same as a built-in policy.
+class PluginScheduler : public Scheduler {
+public:
+    PluginScheduler(std::shared_ptr<PluginLibrary> library, const std::string& options = "");
+    ~PluginScheduler() override;
+    
+    void addTask(const Task& task) override;
+    Task* getNextTask() override;
+    void taskCompleted(int task_id) override;
+    void taskBlocked(int task_id) override;
+    void tick() override;
+    void advanceTicks(int ticks) override;
+    void stallTick() override;
+    std::string getName() const override { return plugin_->name; }
+    void reset() override;
+    
+    bool hasTasks() const override { return has_running_ || !ready_.empty(); }
+    int getActiveTasksCount() const override { return static_cast<int>(ready_.size()) + (has_running_ ? 1 : 0); }
+    double getCurrentFrequency() const override { return frequency_; }
+    
+    std::vector<Task> getPendingTasks() const override;
+    void saveState(BinaryWriter& writer) const override;
+    void restoreState(const std::vector<Task>& tasks, BinaryReader& reader) override;
+    
+private:
+    std::shared_ptr<PluginLibrary> library_;
+    const pp_scheduler_plugin* plugin_;
+    std::string options_;
+    void* state_;
+    
+    std::vector<Task> ready_;
+    Task running_;
+    bool has_running_;
+    int hold_;                     // Ticks the last decision still stands
+    bool changed_;                 // The runnable batch changed since the last decision
+    double frequency_;
+    std::vector<pp_task> batch_;   // Reused across consultations
+    
+    void consult();
+};
+
+#endif // PLUGIN_SCHEDULER_H
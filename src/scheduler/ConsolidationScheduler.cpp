@@ -0,0 +1,128 @@
+#include "ConsolidationScheduler.h"
+#include "core/Serialization.h"
+#include "models/EnergyModel.h"
+#include <algorithm>
+#include <cmath>
+
+ConsolidationScheduler::ConsolidationScheduler(double thermal_margin, double target_utilization)
+    : EnergyAwareScheduler(thermal_margin), target_utilization_(target_utilization), active_(0), load_(0.0),
+      service_ticks_(0.0), last_update_(0) {
+}
+
+void ConsolidationScheduler::updateParking(const Platform& platform, const std::vector<int>& idle_cores,
+                                           const CState& deep_state) {
+    if (order_.size() != static_cast<size_t>(platform.getCoreCount())) {
+        buildOrder(platform);
+    }
+    int cores = platform.getCoreCount();
+    idle_.assign(cores, 0);
+    for (int core : idle_cores) {
+        idle_[core] = 1;
+    }
+    int free_active = 0;
+    for (int i = 0; i < active_; ++i) {
+        int core = order_[i];
+        if (idle_[core]) {
+            free_active++;
+            if (idle_since_[core] < 0) {
+                idle_since_[core] = current_tick_;
+            }
+        } else {
+            idle_since_[core] = -1;
+        }
+    }
+    
+    // Load average over the time since the last call
+    int running = cores - static_cast<int>(idle_cores.size());
+    double sample = running + getQueuedCount();
+    int elapsed = current_tick_ - last_update_;
+    if (elapsed > 0) {
+        double weight = 1.0 - std::exp(-static_cast<double>(elapsed) / kLoadWindow);
+        load_ += weight * (sample - load_);
+        last_update_ = current_tick_;
+    }
+    
+    // Wake the next cores while the tasks beyond the free ones would queue
+    // for longer than a wake-up takes
+    int excess = getQueuedCount() - free_active;
+    if (excess > 0) {
+        double service = (service_ticks_ > 0.0) ? service_ticks_ : ready_queue_.front().getRemainingTime();
+        while (excess > 0 && active_ < cores &&
+               static_cast<double>(excess) / active_ * service > deep_state.exit_latency) {
+            int core = order_[active_++];
+            parked_[core] = 0;
+            idle_since_[core] = current_tick_;
+            excess--;
+        }
+    }
+    
+    // Park from the least efficient end while the load fits on fewer cores
+    int needed = std::max(1, static_cast<int>(std::ceil(load_ / target_utilization_)));
+    while (active_ > needed && getQueuedCount() == 0) {
+        int core = order_[active_ - 1];
+        if (!idle_[core] || current_tick_ - idle_since_[core] < deep_state.target_residency) {
+            break;
+        }
+        parked_[core] = 1;
+        active_--;
+    }
+}
+
+void ConsolidationScheduler::place(const Platform& platform, const std::vector<int>& idle_cores,
+                                   std::vector<Placement>& placements) {
+    // Most efficient cores first, so that the work stays packed
+    free_cores_ = idle_cores;
+    std::sort(free_cores_.begin(), free_cores_.end(), [this](int a, int b) { return rank_[a] < rank_[b]; });
+    
+    for (int core : free_cores_) {
+        if (ready_queue_.empty()) {
+            break;
+        }
+        const Task& task = ready_queue_.front();
+        TaskType type = task.getExecutionType();
+        int urgency = getUrgency(active_);
+        double work = task.getRemainingTime();
+        service_ticks_ = (service_ticks_ > 0.0) ? service_ticks_ + 0.125 * (work - service_ticks_) : work;
+        dispatchFront(core, platform.typeOf(core).getBestLevel(type, urgency), placements);
+    }
+}
+
+void ConsolidationScheduler::reset() {
+    EnergyAwareScheduler::reset();
+    order_.clear();
+    rank_.clear();
+    idle_since_.clear();
+    active_ = 0;
+    load_ = 0.0;
+    service_ticks_ = 0.0;
+    last_update_ = 0;
+}
+
+void ConsolidationScheduler::buildOrder(const Platform& platform) {
+    int cores = platform.getCoreCount();
+    order_.resize(cores);
+    for (int i = 0; i < cores; ++i) {
+        order_[i] = i;
+    }
+    std::stable_sort(order_.begin(), order_.end(), [&platform](int a, int b) {
+        return platform.typeOf(a).getPlacementCost(TaskType::CPU_BOUND, 0) <
+               platform.typeOf(b).getPlacementCost(TaskType::CPU_BOUND, 0);
+    });
+    rank_.resize(cores);
+    for (int i = 0; i < cores; ++i) {
+        rank_[order_[i]] = i;
+    }
+    
+    // Start with only the most efficient core awake
+    active_ = std::min(1, cores);
+    parked_.assign(cores, 1);
+    for (int i = 0; i < active_; ++i) {
+        parked_[order_[i]] = 0;
+    }
+    idle_since_.assign(cores, -1);
+}
+
+void ConsolidationScheduler::saveParameters(BinaryWriter& writer) const {
+    EnergyAwareScheduler::saveParameters(writer);
+    writer.writeDouble(target_utilization_);
+}
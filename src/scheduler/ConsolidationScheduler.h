@@ -0,0 +1,48 @@
+#ifndef CONSOLIDATION_SCHEDULER_H
+#define CONSOLIDATION_SCHEDULER_H
+
+#include "EnergyAwareScheduler.h"
+#include <vector>
+
+// Consolidating placement for energy proportionality: work is packed onto as
+// few cores as possible, taken in order of their energy per unit of work, and
+// the rest are parked in the deepest C-state. A parked core is woken only
+// when the queued tasks would otherwise wait longer than its exit latency,
+// and an unparked core goes back to sleep once it has idled for the deep
+// state's target residency while the recent load fits on fewer cores. Levels
+// are chosen as by the energy-aware policy, with the backlog measured against
+// the cores in use rather than all of them.
+class ConsolidationScheduler : public EnergyAwareScheduler {
+public:
+    explicit ConsolidationScheduler(double thermal_margin = 10.0, double target_utilization = 0.8);
+    
+    void updateParking(const Platform& platform, const std::vector<int>& idle_cores,
+                       const CState& deep_state) override;
+    void place(const Platform& platform, const std::vector<int>& idle_cores,
+               std::vector<Placement>& placements) override;
+    std::string getName() const override { return "Consolidation"; }
+    
+    int getActiveCores() const { return active_; }
+    
+    void reset() override;
+    void saveParameters(BinaryWriter& writer) const override;
+    
+private:
+    // Time constant (ticks) of the load average
+    static const int kLoadWindow = 50;
+    
+    double target_utilization_;
+    std::vector<int> order_;        // Cores from the most to the least efficient
+    std::vector<int> rank_;         // Position of each core in order_
+    std::vector<int> idle_since_;   // By core: tick it was first seen idle, -1 while busy
+    std::vector<char> idle_;        // Scratch
+    std::vector<int> free_cores_;   // Scratch
+    int active_;                    // Unparked cores: order_[0, active_)
+    double load_;                   // Average of running plus queued tasks
+    double service_ticks_;          // Average work of a dispatched task (reference ticks)
+    int last_update_;
+    
+    void buildOrder(const Platform& platform);
+};
+
+#endif // CONSOLIDATION_SCHEDULER_H
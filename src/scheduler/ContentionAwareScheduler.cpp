@@ -0,0 +1,58 @@
+#include "ContentionAwareScheduler.h"
+#include "core/Serialization.h"
+#include <algorithm>
+
+ContentionAwareScheduler::ContentionAwareScheduler(const MemoryBandwidthModel& memory, double thermal_margin)
+    : EnergyAwareScheduler(thermal_margin), memory_(memory), bypassed_(0) {
+}
+
+void ContentionAwareScheduler::place(const Platform& platform, const std::vector<int>& idle_cores,
+                                     std::vector<Placement>& placements) {
+    sortIdleCores(platform, idle_cores);
+    double headroom = bandwidth_headroom_;
+    size_t remaining = idle_cores.size();
+    while (!ready_queue_.empty() && remaining > 0) {
+        int urgency = getUrgency(platform.getCoreCount());
+        
+        // The head's energy-aware choice, unless it oversubscribes the bandwidth
+        // and a task behind it fits
+        size_t index = 0;
+        TaskType type = ready_queue_.front().getExecutionType();
+        int core_type = chooseCoreType(platform, type, urgency);
+        int level = platform.types[core_type].getBestLevel(type, urgency);
+        if (getDemand(platform.types[core_type], type, level) > headroom && bypassed_ < kMaxBypass) {
+            size_t window = std::min(ready_queue_.size(), static_cast<size_t>(kLookahead));
+            for (size_t i = 1; i < window; ++i) {
+                TaskType candidate = ready_queue_[i].getExecutionType();
+                int candidate_type = chooseCoreType(platform, candidate, urgency);
+                int candidate_level = platform.types[candidate_type].getBestLevel(candidate, urgency);
+                if (getDemand(platform.types[candidate_type], candidate, candidate_level) <= headroom) {
+                    index = i;
+                    type = candidate;
+                    core_type = candidate_type;
+                    level = candidate_level;
+                    break;
+                }
+            }
+        }
+        
+        const CoreType& chosen = platform.types[core_type];
+        while (level > 0 && getDemand(chosen, type, level) > headroom) {
+            level--;
+        }
+        headroom -= getDemand(chosen, type, level);
+        bypassed_ = (index > 0) ? bypassed_ + 1 : 0;
+        dispatchAt(index, takeIdleCore(core_type), level, placements);
+        remaining--;
+    }
+}
+
+void ContentionAwareScheduler::reset() {
+    EnergyAwareScheduler::reset();
+    bypassed_ = 0;
+}
+
+void ContentionAwareScheduler::saveParameters(BinaryWriter& writer) const {
+    EnergyAwareScheduler::saveParameters(writer);
+    writer.writeDouble(memory_.getBudget());
+}
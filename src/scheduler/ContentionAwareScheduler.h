@@ -0,0 +1,38 @@
+#ifndef CONTENTION_AWARE_SCHEDULER_H
+#define CONTENTION_AWARE_SCHEDULER_H
+
+#include "EnergyAwareScheduler.h"
+#include "models/MemoryBandwidthModel.h"
+
+// Energy-aware placement that also budgets memory bandwidth. When the task at
+// the head of the queue would oversubscribe the bandwidth left by the running
+// tasks, the first task within a short lookahead window that fits is
+// co-scheduled ahead of it instead, so compute-bound work fills the cores
+// while memory-bound work shares the bandwidth. When nothing fits the head is
+// placed anyway, at the highest level up to its energy-aware choice whose
+// demand fits, as faster levels would only stall on memory. The head is
+// passed over a bounded number of times in a row.
+class ContentionAwareScheduler : public EnergyAwareScheduler {
+public:
+    static const int kLookahead = 8;
+    static const int kMaxBypass = 16;
+    
+    explicit ContentionAwareScheduler(const MemoryBandwidthModel& memory, double thermal_margin = 10.0);
+    
+    void place(const Platform& platform, const std::vector<int>& idle_cores,
+               std::vector<Placement>& placements) override;
+    std::string getName() const override { return "Contention-Aware"; }
+    
+    void reset() override;
+    void saveParameters(BinaryWriter& writer) const override;
+    
+private:
+    MemoryBandwidthModel memory_;
+    int bypassed_;   // Consecutive placements that passed over the head
+    
+    double getDemand(const CoreType& core_type, TaskType type, int level) const {
+        return memory_.getDemand(type, core_type.getSpeed(type, level));
+    }
+};
+
+#endif // CONTENTION_AWARE_SCHEDULER_H
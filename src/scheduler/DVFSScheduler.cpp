@@ -1,12 +1,17 @@
 #include "DVFSScheduler.h"
+#include "core/Serialization.h"
+#include <algorithm>
 
-DVFSScheduler::DVFSScheduler() : current_task_(nullptr), current_frequency_(1.0) {
+DVFSScheduler::DVFSScheduler(int high_load, int max_load, double thermal_margin)
+    : current_task_(nullptr), current_frequency_(1.0), high_load_(high_load),
+      max_load_(std::max(high_load, max_load)), thermal_margin_(thermal_margin) {
     // Available frequency levels (GHz)
     available_frequencies_ = {0.5, 0.8, 1.0, 1.2, 1.5, 2.0};
 }
 
 void DVFSScheduler::addTask(const Task& task) {
     ready_queue_.push(task);
+    noteReady(ready_queue_.back());
     adjustFrequencyBasedOnLoad();
 }
 
@@ -22,12 +27,10 @@ Task* DVFSScheduler::getNextTask() {
         active_tasks_[task.getId()] = task;
         current_task_ = &active_tasks_[task.getId()];
         
-        if (current_task_->getStartTime() == -1) {
-            current_task_->setStartTime(current_tick_);
-        }
+        noteDispatch(*current_task_);
         
         // Adjust frequency based on task type and system load
-        current_frequency_ = selectOptimalFrequency(current_task_);
+        current_frequency_ = limitForThermalHeadroom(selectOptimalFrequency(current_task_));
         
         return current_task_;
     }
@@ -48,8 +51,17 @@ void DVFSScheduler::taskCompleted(int task_id) {
     adjustFrequencyBasedOnLoad();
 }
 
+void DVFSScheduler::taskBlocked(int task_id) {
+    active_tasks_.erase(task_id);
+    current_task_ = nullptr;
+    adjustFrequencyBasedOnLoad();
+}
+
 void DVFSScheduler::tick() {
     current_tick_++;
+    if (current_task_ != nullptr) {
+        current_frequency_ = limitForThermalHeadroom(selectOptimalFrequency(current_task_));
+    }
 }
 
 void DVFSScheduler::reset() {
@@ -59,6 +71,7 @@ void DVFSScheduler::reset() {
     active_tasks_.clear();
     current_task_ = nullptr;
     current_tick_ = 0;
+    resetCounters();
     current_frequency_ = 1.0;
 }
 
@@ -75,8 +88,15 @@ double DVFSScheduler::selectOptimalFrequency(const Task* task) const {
         return available_frequencies_[0]; // Minimum frequency
     }
     
+    // Race-to-idle finishes at the top level; stretch runs at the bottom one
+    if (power_policy_ == PowerPolicy::RACE_TO_IDLE) {
+        return available_frequencies_.back();
+    } else if (power_policy_ == PowerPolicy::STRETCH) {
+        return available_frequencies_[0];
+    }
+    
     // Select frequency based on task type and urgency
-    switch (task->getType()) {
+    switch (task->getExecutionType()) {
         case TaskType::CPU_BOUND:
             // CPU-bound tasks benefit from higher frequency
             return available_frequencies_[4]; // 1.5 GHz
@@ -99,11 +119,63 @@ void DVFSScheduler::adjustFrequencyBasedOnLoad() {
     
     if (total_tasks == 0) {
         current_frequency_ = available_frequencies_[0]; // Minimum
-    } else if (total_tasks < 5) {
+    } else if (total_tasks < high_load_) {
         current_frequency_ = available_frequencies_[2]; // Medium
-    } else if (total_tasks < 10) {
+    } else if (total_tasks < max_load_) {
         current_frequency_ = available_frequencies_[4]; // High
     } else {
         current_frequency_ = available_frequencies_[5]; // Maximum
     }
+    current_frequency_ = limitForThermalHeadroom(current_frequency_);
+}
+
+double DVFSScheduler::limitForThermalHeadroom(double frequency) const {
+    if (thermal_headroom_ >= thermal_margin_) {
+        return frequency;
+    }
+    // Close to the trip point: step down to the medium level, and to the
+    // lowest level once the trip point has been crossed
+    double cap = (thermal_headroom_ > 0.0) ? available_frequencies_[2] : available_frequencies_[0];
+    return std::min(frequency, cap);
+}
+
+std::vector<Task> DVFSScheduler::getPendingTasks() const {
+    std::vector<Task> tasks;
+    if (current_task_ != nullptr && !current_task_->isCompleted()) {
+        tasks.push_back(*current_task_);
+    }
+    std::queue<Task> queue = ready_queue_;
+    while (!queue.empty()) {
+        tasks.push_back(queue.front());
+        queue.pop();
+    }
+    return tasks;
+}
+
+void DVFSScheduler::saveState(BinaryWriter& writer) const {
+    Scheduler::saveState(writer);
+    writer.writeBool(current_task_ != nullptr && !current_task_->isCompleted());
+    writer.writeDouble(current_frequency_);
+    writer.writeInt(high_load_);
+    writer.writeInt(max_load_);
+    writer.writeDouble(thermal_margin_);
+}
+
+void DVFSScheduler::restoreState(const std::vector<Task>& tasks, BinaryReader& reader) {
+    reset();
+    Scheduler::restoreState(tasks, reader);
+    bool has_current = reader.readBool();
+    current_frequency_ = reader.readDouble();
+    high_load_ = static_cast<int>(reader.readInt());
+    max_load_ = static_cast<int>(reader.readInt());
+    thermal_margin_ = reader.readDouble();
+    size_t first_queued = 0;
+    if (has_current && !tasks.empty()) {
+        active_tasks_[tasks[0].getId()] = tasks[0];
+        current_task_ = &active_tasks_[tasks[0].getId()];
+        first_queued = 1;
+    }
+    for (size_t i = first_queued; i < tasks.size(); ++i) {
+        ready_queue_.push(tasks[i]);
+    }
 }
@@ -8,17 +8,26 @@
 
 class DVFSScheduler : public Scheduler {
 public:
-    DVFSScheduler();
+    // Load levels: below high_load queued tasks run at the medium level, below
+    // max_load at the high level, otherwise at the maximum. Frequency backs off
+    // once the thermal headroom falls below thermal_margin degrees.
+    explicit DVFSScheduler(int high_load = 5, int max_load = 10, double thermal_margin = 10.0);
     
     void addTask(const Task& task) override;
     Task* getNextTask() override;
     void taskCompleted(int task_id) override;
+    void taskBlocked(int task_id) override;
     void tick() override;
+    void advanceTicks(int ticks) override { current_tick_ += ticks; }
     std::string getName() const override { return "DVFS-Aware"; }
     void reset() override;
     
     bool hasTasks() const override;
     int getActiveTasksCount() const override;
+    
+    std::vector<Task> getPendingTasks() const override;
+    void saveState(BinaryWriter& writer) const override;
+    void restoreState(const std::vector<Task>& tasks, BinaryReader& reader) override;
     double getCurrentFrequency() const override { return current_frequency_; }
     
 private:
@@ -28,9 +37,13 @@ private:
     
     double current_frequency_;
     std::vector<double> available_frequencies_;
+    int high_load_;
+    int max_load_;
+    double thermal_margin_;
     
     double selectOptimalFrequency(const Task* task) const;
     void adjustFrequencyBasedOnLoad();
+    double limitForThermalHeadroom(double frequency) const;
 };
 
 #endif // DVFS_SCHEDULER_H
@@ -0,0 +1,69 @@
+#include "EnergyAwareScheduler.h"
+#include "core/Serialization.h"
+#include <algorithm>
+
+EnergyAwareScheduler::EnergyAwareScheduler(double thermal_margin)
+    : thermal_margin_(thermal_margin) {
+}
+
+void EnergyAwareScheduler::place(const Platform& platform, const std::vector<int>& idle_cores,
+                                 std::vector<Placement>& placements) {
+    sortIdleCores(platform, idle_cores);
+    size_t remaining = idle_cores.size();
+    while (!ready_queue_.empty() && remaining > 0) {
+        int urgency = getUrgency(platform.getCoreCount());
+        TaskType type = ready_queue_.front().getExecutionType();
+        int best_type = chooseCoreType(platform, type, urgency);
+        dispatchFront(takeIdleCore(best_type), platform.types[best_type].getBestLevel(type, urgency), placements);
+        remaining--;
+    }
+}
+
+void EnergyAwareScheduler::sortIdleCores(const Platform& platform, const std::vector<int>& idle_cores) {
+    idle_by_type_.resize(platform.types.size());
+    for (auto& cores : idle_by_type_) {
+        cores.clear();
+    }
+    next_idle_.assign(platform.types.size(), 0);
+    for (int core : idle_cores) {
+        idle_by_type_[platform.cores[core]].push_back(core);
+    }
+}
+
+int EnergyAwareScheduler::chooseCoreType(const Platform& platform, TaskType type, int urgency) const {
+    // Joint choice of core type and level: each type's best level is tabulated
+    int best_type = -1;
+    double best_cost = 0.0;
+    for (size_t t = 0; t < platform.types.size(); ++t) {
+        if (next_idle_[t] >= idle_by_type_[t].size()) {
+            continue;
+        }
+        double cost = platform.types[t].getPlacementCost(type, urgency);
+        if (best_type < 0 || cost < best_cost) {
+            best_type = static_cast<int>(t);
+            best_cost = cost;
+        }
+    }
+    return best_type;
+}
+
+int EnergyAwareScheduler::getUrgency(int cores) const {
+    if (thermal_headroom_ < thermal_margin_) {
+        return 0;
+    }
+    int urgency = 1;
+    if (power_policy_ == PowerPolicy::STRETCH) {
+        urgency = 0;
+    } else if (power_policy_ == PowerPolicy::RACE_TO_IDLE) {
+        urgency = 2;
+    }
+    if (getQueuedCount() > cores) {
+        urgency++;
+    }
+    return std::min(urgency, CoreType::kUrgencyLevels - 1);
+}
+
+void EnergyAwareScheduler::saveParameters(BinaryWriter& writer) const {
+    PlacementScheduler::saveParameters(writer);
+    writer.writeDouble(thermal_margin_);
+}
@@ -0,0 +1,37 @@
+#ifndef ENERGY_AWARE_SCHEDULER_H
+#define ENERGY_AWARE_SCHEDULER_H
+
+#include "PlacementScheduler.h"
+#include <vector>
+
+// Energy-aware placement: every queued task goes to the core type and level
+// with the lowest energy * delay^urgency per unit of its work, read from the
+// core types' precomputed tables. Urgency follows the power policy (stretch
+// minimises energy, balanced the energy-delay product, race weighs delay
+// more), rises by one while the backlog exceeds the core count, and drops to
+// pure energy once the thermal headroom falls below the margin.
+class EnergyAwareScheduler : public PlacementScheduler {
+public:
+    explicit EnergyAwareScheduler(double thermal_margin = 10.0);
+    
+    void place(const Platform& platform, const std::vector<int>& idle_cores,
+               std::vector<Placement>& placements) override;
+    std::string getName() const override { return "Energy-Aware"; }
+    
+    void saveParameters(BinaryWriter& writer) const override;
+    
+protected:
+    double thermal_margin_;
+    std::vector<std::vector<int>> idle_by_type_;   // Scratch, reused across calls
+    std::vector<size_t> next_idle_;
+    
+    // Rises by one while the backlog exceeds the cores available to it
+    int getUrgency(int cores) const;
+    // Group the idle cores by core type
+    void sortIdleCores(const Platform& platform, const std::vector<int>& idle_cores);
+    // Core type with an idle core left and the lowest cost for the task type
+    int chooseCoreType(const Platform& platform, TaskType type, int urgency) const;
+    int takeIdleCore(int core_type) { return idle_by_type_[core_type][next_idle_[core_type]++]; }
+};
+
+#endif // ENERGY_AWARE_SCHEDULER_H
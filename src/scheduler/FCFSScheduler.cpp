@@ -1,10 +1,12 @@
 #include "FCFSScheduler.h"
+#include "core/Serialization.h"
 
 FCFSScheduler::FCFSScheduler() : current_task_(nullptr) {
 }
 
 void FCFSScheduler::addTask(const Task& task) {
     ready_queue_.push(task);
+    noteReady(ready_queue_.back());
 }
 
 Task* FCFSScheduler::getNextTask() {
@@ -19,9 +21,7 @@ Task* FCFSScheduler::getNextTask() {
         active_tasks_[task.getId()] = task;
         current_task_ = &active_tasks_[task.getId()];
         
-        if (current_task_->getStartTime() == -1) {
-            current_task_->setStartTime(current_tick_);
-        }
+        noteDispatch(*current_task_);
         
         return current_task_;
     }
@@ -39,6 +39,11 @@ void FCFSScheduler::taskCompleted(int task_id) {
     current_task_ = nullptr;
 }
 
+void FCFSScheduler::taskBlocked(int task_id) {
+    active_tasks_.erase(task_id);
+    current_task_ = nullptr;
+}
+
 void FCFSScheduler::tick() {
     current_tick_++;
 }
@@ -50,6 +55,7 @@ void FCFSScheduler::reset() {
     active_tasks_.clear();
     current_task_ = nullptr;
     current_tick_ = 0;
+    resetCounters();
 }
 
 bool FCFSScheduler::hasTasks() const {
@@ -59,3 +65,36 @@ bool FCFSScheduler::hasTasks() const {
 int FCFSScheduler::getActiveTasksCount() const {
     return ready_queue_.size() + active_tasks_.size();
 }
+
+std::vector<Task> FCFSScheduler::getPendingTasks() const {
+    std::vector<Task> tasks;
+    if (current_task_ != nullptr && !current_task_->isCompleted()) {
+        tasks.push_back(*current_task_);
+    }
+    std::queue<Task> queue = ready_queue_;
+    while (!queue.empty()) {
+        tasks.push_back(queue.front());
+        queue.pop();
+    }
+    return tasks;
+}
+
+void FCFSScheduler::saveState(BinaryWriter& writer) const {
+    Scheduler::saveState(writer);
+    writer.writeBool(current_task_ != nullptr && !current_task_->isCompleted());
+}
+
+void FCFSScheduler::restoreState(const std::vector<Task>& tasks, BinaryReader& reader) {
+    reset();
+    Scheduler::restoreState(tasks, reader);
+    bool has_current = reader.readBool();
+    size_t first_queued = 0;
+    if (has_current && !tasks.empty()) {
+        active_tasks_[tasks[0].getId()] = tasks[0];
+        current_task_ = &active_tasks_[tasks[0].getId()];
+        first_queued = 1;
+    }
+    for (size_t i = first_queued; i < tasks.size(); ++i) {
+        ready_queue_.push(tasks[i]);
+    }
+}
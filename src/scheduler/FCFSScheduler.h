@@ -12,13 +12,19 @@ public:
     void addTask(const Task& task) override;
     Task* getNextTask() override;
     void taskCompleted(int task_id) override;
+    void taskBlocked(int task_id) override;
     void tick() override;
+    void advanceTicks(int ticks) override { current_tick_ += ticks; }
     std::string getName() const override { return "First-Come-First-Serve"; }
     void reset() override;
     
     bool hasTasks() const override;
     int getActiveTasksCount() const override;
     
+    std::vector<Task> getPendingTasks() const override;
+    void saveState(BinaryWriter& writer) const override;
+    void restoreState(const std::vector<Task>& tasks, BinaryReader& reader) override;
+    
 private:
     std::queue<Task> ready_queue_;
     std::unordered_map<int, Task> active_tasks_;
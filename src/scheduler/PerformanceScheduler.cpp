@@ -0,0 +1,22 @@
+#include "PerformanceScheduler.h"
+
+void PerformanceScheduler::place(const Platform& platform, const std::vector<int>& idle_cores,
+                                 std::vector<Placement>& placements) {
+    free_cores_ = idle_cores;
+    while (!ready_queue_.empty() && !free_cores_.empty()) {
+        TaskType type = ready_queue_.front().getExecutionType();
+        size_t best = 0;
+        double best_speed = 0.0;
+        for (size_t i = 0; i < free_cores_.size(); ++i) {
+            const CoreType& core_type = platform.typeOf(free_cores_[i]);
+            double speed = core_type.getSpeed(type, core_type.getLevelCount() - 1);
+            if (speed > best_speed) {
+                best = i;
+                best_speed = speed;
+            }
+        }
+        int core = free_cores_[best];
+        free_cores_.erase(free_cores_.begin() + best);
+        dispatchFront(core, platform.typeOf(core).getLevelCount() - 1, placements);
+    }
+}
@@ -0,0 +1,19 @@
+#ifndef PERFORMANCE_SCHEDULER_H
+#define PERFORMANCE_SCHEDULER_H
+
+#include "PlacementScheduler.h"
+#include <vector>
+
+// Baseline placement: every queued task takes the idle core that runs its
+// work fastest, at that core type's top level
+class PerformanceScheduler : public PlacementScheduler {
+public:
+    void place(const Platform& platform, const std::vector<int>& idle_cores,
+               std::vector<Placement>& placements) override;
+    std::string getName() const override { return "Performance"; }
+    
+private:
+    std::vector<int> free_cores_;   // Scratch, reused across calls
+};
+
+#endif // PERFORMANCE_SCHEDULER_H
@@ -0,0 +1,33 @@
+#include "PlacementScheduler.h"
+#include "core/Serialization.h"
+
+void PlacementScheduler::addTask(const Task& task) {
+    ready_queue_.push_back(task);
+    ready_queue_.back().markReady(current_tick_);
+}
+
+void PlacementScheduler::reset() {
+    ready_queue_.clear();
+    current_tick_ = 0;
+    thermal_headroom_ = 1e9;
+    bandwidth_headroom_ = 1e9;
+    context_switches_ = 0;
+    parked_.clear();
+}
+
+void PlacementScheduler::saveParameters(BinaryWriter& writer) const {
+    writer.writeString(getName());
+    writer.writeInt(static_cast<int>(power_policy_));
+}
+
+void PlacementScheduler::dispatchAt(size_t index, int core, int level, std::vector<Placement>& placements) {
+    Task task = ready_queue_[index];
+    ready_queue_.erase(ready_queue_.begin() + index);
+    dispatch(task, core, level, placements);
+}
+
+void PlacementScheduler::dispatch(Task task, int core, int level, std::vector<Placement>& placements) {
+    task.markDispatched(current_tick_);
+    context_switches_++;
+    placements.push_back({task, core, level});
+}
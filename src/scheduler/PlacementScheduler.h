@@ -0,0 +1,92 @@
+#ifndef PLACEMENT_SCHEDULER_H
+#define PLACEMENT_SCHEDULER_H
+
+#include "Scheduler.h"
+#include "models/CoreType.h"
+#include "tasks/Task.h"
+#include "tasks/TaskGraph.h"
+#include <deque>
+#include <string>
+#include <vector>
+
+struct CState;
+class BinaryWriter;
+
+// A queued task handed to a core, with the operating point it runs at
+struct Placement {
+    Task task;
+    int core;
+    int level;
+};
+
+// Scheduler for heterogeneous multi-core systems: runnable tasks wait in one
+// shared FIFO queue (policies may keep their own ready set instead), and
+// whenever cores are free the policy decides which tasks go where and at
+// which level. Placed tasks run until they complete or block.
+class PlacementScheduler {
+public:
+    virtual ~PlacementScheduler() = default;
+    
+    virtual void addTask(const Task& task);
+    
+    // Called once a run's workload is known, before any task is added; graph
+    // is null for independent tasks
+    virtual void prepare(const Platform& /*platform*/, const std::vector<Task>& /*tasks*/,
+                         const TaskGraph* /*graph*/) {}
+    
+    // Place queued tasks on the given idle cores, appending one entry per
+    // placed task (which leaves the queue)
+    virtual void place(const Platform& platform, const std::vector<int>& idle_cores,
+                       std::vector<Placement>& placements) = 0;
+    virtual std::string getName() const = 0;
+    
+    // Core parking: the engine calls this before every placement round with
+    // the idle cores, parked ones included; deep_state is the C-state parked
+    // cores sleep in. A parked core is offered no work until unparked.
+    virtual void updateParking(const Platform& /*platform*/, const std::vector<int>& /*idle_cores*/,
+                               const CState& /*deep_state*/) {}
+    bool isParked(int core) const { return static_cast<size_t>(core) < parked_.size() && parked_[core]; }
+    
+    virtual bool hasTasks() const { return !ready_queue_.empty(); }
+    virtual int getQueuedCount() const { return static_cast<int>(ready_queue_.size()); }
+    
+    void tick() { current_tick_++; }
+    void advanceTicks(int ticks) { current_tick_ += ticks; }
+    int getCurrentTick() const { return current_tick_; }
+    int getContextSwitches() const { return context_switches_; }
+    
+    void setThermalHeadroom(double headroom) { thermal_headroom_ = headroom; }
+    // Memory bandwidth (GB/s) left unused by the running tasks
+    void setBandwidthHeadroom(double headroom) { bandwidth_headroom_ = headroom; }
+    void setPowerPolicy(PowerPolicy policy) { power_policy_ = policy; }
+    PowerPolicy getPowerPolicy() const { return power_policy_; }
+    
+    virtual void reset();
+    
+    // Everything the policy was configured with, for result-cache keys;
+    // subclasses append their own parameters
+    virtual void saveParameters(BinaryWriter& writer) const;
+    
+protected:
+    PlacementScheduler() : current_tick_(0), thermal_headroom_(1e9), bandwidth_headroom_(1e9),
+                           power_policy_(PowerPolicy::BALANCED), context_switches_(0) {}
+    
+    std::deque<Task> ready_queue_;
+    int current_tick_;
+    double thermal_headroom_;
+    double bandwidth_headroom_;
+    PowerPolicy power_policy_;
+    int context_switches_;
+    std::vector<char> parked_;   // By core; empty when the policy never parks
+    
+    // Move the head of the queue onto a core
+    void dispatchFront(int core, int level, std::vector<Placement>& placements) {
+        dispatchAt(0, core, level, placements);
+    }
+    // Move a queued task past the ones ahead of it onto a core
+    void dispatchAt(size_t index, int core, int level, std::vector<Placement>& placements);
+    // Hand a task taken from the policy's own ready set to a core
+    void dispatch(Task task, int core, int level, std::vector<Placement>& placements);
+};
+
+#endif // PLACEMENT_SCHEDULER_H
@@ -1,17 +1,20 @@
 #include "PriorityScheduler.h"
+#include "core/Serialization.h"
+#include <algorithm>
 
 PriorityScheduler::PriorityScheduler(bool preemptive) 
     : preemptive_(preemptive), current_task_(nullptr) {
 }
 
 void PriorityScheduler::addTask(const Task& task) {
-    ready_queue_.push(task);
+    pushReady(task);
     
     // If preemptive and we have a current task, check if new task has higher priority
     if (preemptive_ && current_task_ != nullptr) {
         if (task.getPriority() > current_task_->getPriority()) {
             // Preempt current task
-            ready_queue_.push(*current_task_);
+            notePreemption(*current_task_);
+            pushReady(*current_task_);
             current_task_ = nullptr;
         }
     }
@@ -23,15 +26,14 @@ Task* PriorityScheduler::getNextTask() {
     }
     
     if (!ready_queue_.empty()) {
-        Task task = ready_queue_.top();
-        ready_queue_.pop();
+        std::pop_heap(ready_queue_.begin(), ready_queue_.end(), TaskPriorityComparator());
+        Task task = ready_queue_.back();
+        ready_queue_.pop_back();
         
         active_tasks_[task.getId()] = task;
         current_task_ = &active_tasks_[task.getId()];
         
-        if (current_task_->getStartTime() == -1) {
-            current_task_->setStartTime(current_tick_);
-        }
+        noteDispatch(*current_task_);
         
         return current_task_;
     }
@@ -49,18 +51,22 @@ void PriorityScheduler::taskCompleted(int task_id) {
     current_task_ = nullptr;
 }
 
+void PriorityScheduler::taskBlocked(int task_id) {
+    active_tasks_.erase(task_id);
+    current_task_ = nullptr;
+}
+
 void PriorityScheduler::tick() {
     current_tick_++;
 }
 
 void PriorityScheduler::reset() {
     // Clear priority queue
-    while (!ready_queue_.empty()) {
-        ready_queue_.pop();
-    }
+    ready_queue_.clear();
     active_tasks_.clear();
     current_task_ = nullptr;
     current_tick_ = 0;
+    resetCounters();
 }
 
 bool PriorityScheduler::hasTasks() const {
@@ -70,3 +76,37 @@ bool PriorityScheduler::hasTasks() const {
 int PriorityScheduler::getActiveTasksCount() const {
     return ready_queue_.size() + active_tasks_.size();
 }
+
+std::vector<Task> PriorityScheduler::getPendingTasks() const {
+    std::vector<Task> tasks;
+    if (current_task_ != nullptr && !current_task_->isCompleted()) {
+        tasks.push_back(*current_task_);
+    }
+    tasks.insert(tasks.end(), ready_queue_.begin(), ready_queue_.end());
+    return tasks;
+}
+
+void PriorityScheduler::saveState(BinaryWriter& writer) const {
+    Scheduler::saveState(writer);
+    writer.writeBool(current_task_ != nullptr && !current_task_->isCompleted());
+}
+
+void PriorityScheduler::restoreState(const std::vector<Task>& tasks, BinaryReader& reader) {
+    reset();
+    Scheduler::restoreState(tasks, reader);
+    bool has_current = reader.readBool();
+    size_t first_queued = 0;
+    if (has_current && !tasks.empty()) {
+        active_tasks_[tasks[0].getId()] = tasks[0];
+        current_task_ = &active_tasks_[tasks[0].getId()];
+        first_queued = 1;
+    }
+    // The saved heap layout is restored verbatim so ties break the same way
+    ready_queue_.assign(tasks.begin() + first_queued, tasks.end());
+}
+
+void PriorityScheduler::pushReady(const Task& task) {
+    ready_queue_.push_back(task);
+    noteReady(ready_queue_.back());
+    std::push_heap(ready_queue_.begin(), ready_queue_.end(), TaskPriorityComparator());
+}
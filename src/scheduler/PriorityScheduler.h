@@ -2,8 +2,8 @@
 #define PRIORITY_SCHEDULER_H
 
 #include "Scheduler.h"
-#include <queue>
 #include <unordered_map>
+#include <vector>
 
 struct TaskPriorityComparator {
     bool operator()(const Task& a, const Task& b) const {
@@ -19,18 +19,26 @@ public:
     void addTask(const Task& task) override;
     Task* getNextTask() override;
     void taskCompleted(int task_id) override;
+    void taskBlocked(int task_id) override;
     void tick() override;
+    void advanceTicks(int ticks) override { current_tick_ += ticks; }
     std::string getName() const override { return "Priority-Based"; }
     void reset() override;
     
     bool hasTasks() const override;
     int getActiveTasksCount() const override;
     
+    std::vector<Task> getPendingTasks() const override;
+    void saveState(BinaryWriter& writer) const override;
+    void restoreState(const std::vector<Task>& tasks, BinaryReader& reader) override;
+    
 private:
-    std::priority_queue<Task, std::vector<Task>, TaskPriorityComparator> ready_queue_;
+    std::vector<Task> ready_queue_;  // Binary max-heap ordered by TaskPriorityComparator
     std::unordered_map<int, Task> active_tasks_;
     Task* current_task_;
     bool preemptive_;
+    
+    void pushReady(const Task& task);
 };
 
 #endif // PRIORITY_SCHEDULER_H
@@ -1,4 +1,6 @@
 #include "RoundRobinScheduler.h"
+#include "core/Serialization.h"
+#include <algorithm>
 
 RoundRobinScheduler::RoundRobinScheduler(int time_quantum) 
     : time_quantum_(time_quantum), remaining_quantum_(time_quantum), current_task_(nullptr) {
@@ -6,6 +8,7 @@ RoundRobinScheduler::RoundRobinScheduler(int time_quantum)
 
 void RoundRobinScheduler::addTask(const Task& task) {
     ready_queue_.push(task);
+    noteReady(ready_queue_.back());
 }
 
 Task* RoundRobinScheduler::getNextTask() {
@@ -14,8 +17,14 @@ Task* RoundRobinScheduler::getNextTask() {
     }
     
     // Time quantum expired or task completed, get next task
+    if (current_task_ != nullptr && !current_task_->isCompleted() && ready_queue_.empty()) {
+        // Nobody else is waiting: the task keeps the CPU for another quantum
+        remaining_quantum_ = time_quantum_;
+        return current_task_;
+    }
     if (current_task_ != nullptr && !current_task_->isCompleted()) {
         // Put back in ready queue if not completed
+        notePreemption(*current_task_);
         ready_queue_.push(*current_task_);
         current_task_ = nullptr;
     }
@@ -28,9 +37,7 @@ Task* RoundRobinScheduler::getNextTask() {
         current_task_ = &active_tasks_[task.getId()];
         remaining_quantum_ = time_quantum_;
         
-        if (current_task_->getStartTime() == -1) {
-            current_task_->setStartTime(current_tick_);
-        }
+        noteDispatch(*current_task_);
         
         return current_task_;
     }
@@ -48,6 +55,11 @@ void RoundRobinScheduler::taskCompleted(int task_id) {
     current_task_ = nullptr;
 }
 
+void RoundRobinScheduler::taskBlocked(int task_id) {
+    active_tasks_.erase(task_id);
+    current_task_ = nullptr;
+}
+
 void RoundRobinScheduler::tick() {
     current_tick_++;
     if (remaining_quantum_ > 0) {
@@ -55,6 +67,15 @@ void RoundRobinScheduler::tick() {
     }
 }
 
+void RoundRobinScheduler::stallTick() {
+    current_tick_++;
+}
+
+void RoundRobinScheduler::advanceTicks(int ticks) {
+    current_tick_ += ticks;
+    remaining_quantum_ = std::max(0, remaining_quantum_ - ticks);
+}
+
 void RoundRobinScheduler::reset() {
     while (!ready_queue_.empty()) {
         ready_queue_.pop();
@@ -62,6 +83,7 @@ void RoundRobinScheduler::reset() {
     active_tasks_.clear();
     current_task_ = nullptr;
     current_tick_ = 0;
+    resetCounters();
     remaining_quantum_ = time_quantum_;
 }
 
@@ -72,3 +94,40 @@ bool RoundRobinScheduler::hasTasks() const {
 int RoundRobinScheduler::getActiveTasksCount() const {
     return ready_queue_.size() + active_tasks_.size();
 }
+
+std::vector<Task> RoundRobinScheduler::getPendingTasks() const {
+    std::vector<Task> tasks;
+    if (current_task_ != nullptr && !current_task_->isCompleted()) {
+        tasks.push_back(*current_task_);
+    }
+    std::queue<Task> queue = ready_queue_;
+    while (!queue.empty()) {
+        tasks.push_back(queue.front());
+        queue.pop();
+    }
+    return tasks;
+}
+
+void RoundRobinScheduler::saveState(BinaryWriter& writer) const {
+    Scheduler::saveState(writer);
+    writer.writeBool(current_task_ != nullptr && !current_task_->isCompleted());
+    writer.writeInt(time_quantum_);
+    writer.writeInt(remaining_quantum_);
+}
+
+void RoundRobinScheduler::restoreState(const std::vector<Task>& tasks, BinaryReader& reader) {
+    reset();
+    Scheduler::restoreState(tasks, reader);
+    bool has_current = reader.readBool();
+    time_quantum_ = static_cast<int>(reader.readInt());
+    remaining_quantum_ = static_cast<int>(reader.readInt());
+    size_t first_queued = 0;
+    if (has_current && !tasks.empty()) {
+        active_tasks_[tasks[0].getId()] = tasks[0];
+        current_task_ = &active_tasks_[tasks[0].getId()];
+        first_queued = 1;
+    }
+    for (size_t i = first_queued; i < tasks.size(); ++i) {
+        ready_queue_.push(tasks[i]);
+    }
+}
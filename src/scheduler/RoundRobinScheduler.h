@@ -12,12 +12,20 @@ public:
     void addTask(const Task& task) override;
     Task* getNextTask() override;
     void taskCompleted(int task_id) override;
+    void taskBlocked(int task_id) override;
     void tick() override;
+    void advanceTicks(int ticks) override;
+    void stallTick() override;
     std::string getName() const override { return "Round-Robin"; }
     void reset() override;
     
     bool hasTasks() const override;
     int getActiveTasksCount() const override;
+    int getTimeQuantum() const { return time_quantum_; }
+    
+    std::vector<Task> getPendingTasks() const override;
+    void saveState(BinaryWriter& writer) const override;
+    void restoreState(const std::vector<Task>& tasks, BinaryReader& reader) override;
     
 private:
     std::queue<Task> ready_queue_;
@@ -0,0 +1,19 @@
+#include "Scheduler.h"
+#include "core/Serialization.h"
+
+void Scheduler::saveState(BinaryWriter& writer) const {
+    writer.writeInt(current_tick_);
+    writer.writeDouble(thermal_headroom_);
+    writer.writeUInt(static_cast<uint64_t>(power_policy_));
+    writer.writeInt(context_switches_);
+    writer.writeInt(preemptions_);
+}
+
+void Scheduler::restoreState(const std::vector<Task>& tasks, BinaryReader& reader) {
+    (void)tasks;
+    current_tick_ = static_cast<int>(reader.readInt());
+    thermal_headroom_ = reader.readDouble();
+    power_policy_ = static_cast<PowerPolicy>(reader.readUInt());
+    context_switches_ = static_cast<int>(reader.readInt());
+    preemptions_ = static_cast<int>(reader.readInt());
+}
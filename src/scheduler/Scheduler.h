@@ -6,6 +6,17 @@
 #include <queue>
 #include <string>
 
+class BinaryWriter;
+class BinaryReader;
+
+// How frequency and idle states trade off: finish fast and sleep deeply,
+// or run slowly and keep idle gaps short
+enum class PowerPolicy {
+    BALANCED,
+    RACE_TO_IDLE,
+    STRETCH
+};
+
 class Scheduler {
 public:
     virtual ~Scheduler() = default;
@@ -14,7 +25,13 @@ public:
     virtual void addTask(const Task& task) = 0;
     virtual Task* getNextTask() = 0;
     virtual void taskCompleted(int task_id) = 0;
+    // The task left the CPU to wait (I/O phase); it is re-added with addTask() on wake-up
+    virtual void taskBlocked(int task_id) = 0;
     virtual void tick() = 0;
+    virtual void advanceTicks(int ticks) { for (int i = 0; i < ticks; ++i) tick(); }
+    // A tick the dispatched task spent switching in or refilling caches: time
+    // passes, but a time slice only starts counting once the task runs
+    virtual void stallTick() { tick(); }
     virtual std::string getName() const = 0;
     virtual void reset() = 0;
     
@@ -23,12 +40,51 @@ public:
     virtual int getActiveTasksCount() const = 0;
     virtual double getCurrentFrequency() const { return 1.0; } // Default 1.0 GHz
     
+    // Snapshot support: queued and running tasks in dispatch order, running task first
+    virtual std::vector<Task> getPendingTasks() const = 0;
+    
+    // Scheduler state beyond the pending tasks; restoreState() rebuilds a scheduler
+    // of the same type from getPendingTasks() and what saveState() wrote
+    virtual void saveState(BinaryWriter& writer) const;
+    virtual void restoreState(const std::vector<Task>& tasks, BinaryReader& reader);
+    
 protected:
     int current_tick_;
+    double thermal_headroom_;  // Degrees below the throttle trip point
+    PowerPolicy power_policy_;
+    int context_switches_;
+    int preemptions_;
+    
+    // Per-task accounting shared by the policies; call on the queued or running copy
+    void noteReady(Task& task) { task.markReady(current_tick_); }
+    void noteDispatch(Task& task) {
+        task.markDispatched(current_tick_);
+        context_switches_++;
+    }
+    void notePreemption(Task& task) {
+        task.markPreempted(current_tick_);
+        preemptions_++;
+    }
+    void resetCounters() {
+        context_switches_ = 0;
+        preemptions_ = 0;
+    }
     
 public:
-    Scheduler() : current_tick_(0) {}
+    Scheduler() : current_tick_(0), thermal_headroom_(1e9), power_policy_(PowerPolicy::BALANCED),
+                  context_switches_(0), preemptions_(0) {}
     int getCurrentTick() const { return current_tick_; }
+    int getContextSwitches() const { return context_switches_; }
+    int getPreemptions() const { return preemptions_; }
+    
+    // Thermal headroom published by the engine for thermal-aware policies
+    void setThermalHeadroom(double headroom) { thermal_headroom_ = headroom; }
+    double getThermalHeadroom() const { return thermal_headroom_; }
+    
+    // Power policy; frequency-scaling schedulers pick their levels from it and
+    // the engine uses it to choose idle states
+    void setPowerPolicy(PowerPolicy policy) { power_policy_ = policy; }
+    PowerPolicy getPowerPolicy() const { return power_policy_; }
 };
 
 #endif // SCHEDULER_H
@@ -0,0 +1,142 @@
+#include "SlackScheduler.h"
+#include "core/Serialization.h"
+#include <algorithm>
+
+SlackScheduler::SlackScheduler(double stretch)
+    : stretch_(stretch), deadline_(0.0), capacity_(0.0), fastest_{0.0, 0.0, 0.0}, unstarted_work_(0.0) {
+}
+
+void SlackScheduler::prepare(const Platform& platform, const std::vector<Task>& tasks, const TaskGraph* graph) {
+    for (int t = 0; t < CoreType::kTaskTypes; ++t) {
+        fastest_[t] = 0.0;
+        for (const CoreType& type : platform.types) {
+            fastest_[t] = std::max(fastest_[t], type.getSpeed(static_cast<TaskType>(t), type.getLevelCount() - 1));
+        }
+    }
+    capacity_ = 0.0;
+    for (int core = 0; core < platform.getCoreCount(); ++core) {
+        const CoreType& type = platform.typeOf(core);
+        capacity_ += type.getSpeed(TaskType::CPU_BOUND, type.getLevelCount() - 1);
+    }
+    
+    int nodes = graph ? graph->getNodeCount() : 0;
+    int earliest_arrival = tasks.empty() ? 0 : tasks.front().getArrivalTime();
+    unstarted_work_ = 0.0;
+    for (const Task& task : tasks) {
+        nodes = std::max(nodes, task.getId() + 1);
+        earliest_arrival = std::min(earliest_arrival, task.getArrivalTime());
+        unstarted_work_ += task.getDuration();
+    }
+    std::vector<double> min_time(nodes, 0.0);
+    for (const Task& task : tasks) {
+        // Each compute phase runs at the speed of its own type; I/O phases
+        // are off the CPU
+        if (task.getPhaseCount() == 0) {
+            min_time[task.getId()] = task.getDuration() / fastest_[static_cast<int>(task.getExecutionType())];
+        }
+        for (int i = 0; i < task.getPhaseCount(); ++i) {
+            TaskPhase phase = task.getPhase(i);
+            if (phase.type != TaskType::IO_BOUND) {
+                min_time[task.getId()] += phase.work / fastest_[static_cast<int>(phase.type)];
+            }
+        }
+    }
+    
+    // Tasks beyond the graph have no dependencies
+    bottom_level_ = graph ? graph->computeBottomLevels(min_time) : min_time;
+    bottom_level_.resize(nodes);
+    for (int node = graph ? graph->getNodeCount() : 0; node < nodes; ++node) {
+        bottom_level_[node] = min_time[node];
+    }
+    double critical_path = bottom_level_.empty() ? 0.0 : *std::max_element(bottom_level_.begin(), bottom_level_.end());
+    double work_bound = (capacity_ > 0.0) ? unstarted_work_ / capacity_ : 0.0;
+    deadline_ = earliest_arrival + stretch_ * std::max(critical_path, work_bound);
+}
+
+void SlackScheduler::addTask(const Task& task) {
+    int slot;
+    if (free_slots_.empty()) {
+        slot = static_cast<int>(slots_.size());
+        slots_.push_back(task);
+    } else {
+        slot = free_slots_.back();
+        free_slots_.pop_back();
+        slots_[slot] = task;
+    }
+    slots_[slot].markReady(current_tick_);
+    
+    int id = task.getId();
+    ready_.push_back({deadline_ - getBottomLevel(id), id, slot});
+    std::push_heap(ready_.begin(), ready_.end(), startsLater);
+}
+
+void SlackScheduler::place(const Platform& platform, const std::vector<int>& idle_cores,
+                           std::vector<Placement>& placements) {
+    free_cores_ = idle_cores;
+    while (!ready_.empty() && !free_cores_.empty()) {
+        std::pop_heap(ready_.begin(), ready_.end(), startsLater);
+        Entry entry = ready_.back();
+        ready_.pop_back();
+        free_slots_.push_back(entry.slot);
+        const Task& task = slots_[entry.slot];
+        
+        // Fraction of the fastest speed that stretches the task's chain, and
+        // the outstanding work of the package, exactly to the deadline
+        TaskType type = task.getExecutionType();
+        double time_left = deadline_ - current_tick_;
+        double ratio = 1.0;
+        if (time_left > 0.0) {
+            ratio = std::max(getBottomLevel(entry.id), unstarted_work_ / capacity_) / time_left;
+        }
+        double required = ratio * fastest_[static_cast<int>(type)];
+        if (task.getStartTime() < 0) {
+            unstarted_work_ -= task.getDuration();
+        }
+        
+        // Cheapest (core, level) reaching the required speed; the fastest idle
+        // core at its top level when none does
+        size_t best = 0;
+        int best_level = -1;
+        double best_energy = 0.0;
+        size_t fastest = 0;
+        double fastest_speed = 0.0;
+        for (size_t i = 0; i < free_cores_.size(); ++i) {
+            const CoreType& core_type = platform.typeOf(free_cores_[i]);
+            int top = core_type.getLevelCount() - 1;
+            if (core_type.getSpeed(type, top) > fastest_speed) {
+                fastest = i;
+                fastest_speed = core_type.getSpeed(type, top);
+            }
+            for (int level = 0; level <= top; ++level) {
+                if (core_type.getSpeed(type, level) >= required) {
+                    double energy = core_type.getEnergyPerWork(type, level);
+                    if (best_level < 0 || energy < best_energy) {
+                        best = i;
+                        best_level = level;
+                        best_energy = energy;
+                    }
+                }
+            }
+        }
+        if (best_level < 0) {
+            best = fastest;
+            best_level = platform.typeOf(free_cores_[fastest]).getLevelCount() - 1;
+        }
+        
+        int core = free_cores_[best];
+        free_cores_.erase(free_cores_.begin() + best);
+        dispatch(task, core, best_level, placements);
+    }
+}
+
+void SlackScheduler::reset() {
+    PlacementScheduler::reset();
+    ready_.clear();
+    slots_.clear();
+    free_slots_.clear();
+}
+
+void SlackScheduler::saveParameters(BinaryWriter& writer) const {
+    PlacementScheduler::saveParameters(writer);
+    writer.writeDouble(stretch_);
+}
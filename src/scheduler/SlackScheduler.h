@@ -0,0 +1,71 @@
+#ifndef SLACK_SCHEDULER_H
+#define SLACK_SCHEDULER_H
+
+#include "PlacementScheduler.h"
+#include <vector>
+
+// Critical-path-aware DVFS for DAG workloads. When a run starts, every task
+// gets its bottom level: the longest chain of minimum execution times (each
+// at the fastest core type's top level) from it to the end of the DAG. The
+// deadline is the stretch factor times the larger of the critical path and
+// the total work over the cores' combined top speed, so with a factor of 1
+// only work off the critical path is slowed.
+//
+// Ready tasks are kept in a heap by latest start (deadline minus bottom
+// level), most critical first. A task placed at time t may run its chain
+// slower by the ratio of the time left, deadline - t, to its bottom level,
+// which shares the chain's slack among its tasks instead of letting the first
+// one use it all; the work not yet started bounds that ratio for the package
+// as a whole. Both inputs are kept up to date in O(1), so a completion costs
+// only the heap insertions of the children it releases. Each task goes to the
+// idle core and level that reach the required speed for the least energy, or
+// to the fastest idle core at its top level when none can.
+class SlackScheduler : public PlacementScheduler {
+public:
+    explicit SlackScheduler(double stretch = 1.0);
+    
+    void prepare(const Platform& platform, const std::vector<Task>& tasks, const TaskGraph* graph) override;
+    void addTask(const Task& task) override;
+    bool hasTasks() const override { return !ready_.empty(); }
+    int getQueuedCount() const override { return static_cast<int>(ready_.size()); }
+    
+    void place(const Platform& platform, const std::vector<int>& idle_cores,
+               std::vector<Placement>& placements) override;
+    std::string getName() const override { return "Slack-Aware"; }
+    
+    double getDeadline() const { return deadline_; }
+    
+    void reset() override;
+    void saveParameters(BinaryWriter& writer) const override;
+    
+private:
+    struct Entry {
+        double latest_start;
+        int id;
+        int slot;
+    };
+    
+    // Heap order: earliest latest start on top, ties by task id
+    static bool startsLater(const Entry& a, const Entry& b) {
+        return a.latest_start > b.latest_start || (a.latest_start == b.latest_start && a.id > b.id);
+    }
+    
+    double stretch_;
+    double deadline_;
+    double capacity_;                     // Combined top speed of all cores
+    double fastest_[CoreType::kTaskTypes];  // Top speed of the fastest core type per task type
+    std::vector<double> bottom_level_;    // By task id (ticks)
+    double unstarted_work_;               // Work of the tasks not dispatched yet
+    
+    // Ready set: tasks parked in reusable slots, ordered by a binary heap
+    std::vector<Entry> ready_;
+    std::vector<Task> slots_;
+    std::vector<int> free_slots_;
+    std::vector<int> free_cores_;         // Scratch
+    
+    double getBottomLevel(int id) const {
+        return (id >= 0 && static_cast<size_t>(id) < bottom_level_.size()) ? bottom_level_[id] : 0.0;
+    }
+};
+
+#endif // SLACK_SCHEDULER_H
@@ -0,0 +1,97 @@
+#include "Protocol.h"
+#include "core/Serialization.h"
+#include "output/ResultCache.h"
+#include <cerrno>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+bool writeAll(int fd, const uint8_t* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = send(fd, data, size, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+bool readAll(int fd, uint8_t* data, size_t size) {
+    while (size > 0) {
+        ssize_t received = recv(fd, data, size, 0);
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            return false;
+        }
+        data += received;
+        size -= static_cast<size_t>(received);
+    }
+    return true;
+}
+
+} // namespace
+
+bool Protocol::sendMessage(int fd, const std::vector<uint8_t>& payload) {
+    uint32_t size = static_cast<uint32_t>(payload.size());
+    uint8_t header[4] = {static_cast<uint8_t>(size), static_cast<uint8_t>(size >> 8),
+                         static_cast<uint8_t>(size >> 16), static_cast<uint8_t>(size >> 24)};
+    return writeAll(fd, header, sizeof(header)) && writeAll(fd, payload.data(), payload.size());
+}
+
+bool Protocol::receiveMessage(int fd, std::vector<uint8_t>& payload) {
+    uint8_t header[4];
+    if (!readAll(fd, header, sizeof(header))) {
+        return false;
+    }
+    size_t size = header[0] | (header[1] << 8) | (header[2] << 16) | (static_cast<size_t>(header[3]) << 24);
+    if (size > kMaxMessage) {
+        return false;
+    }
+    payload.resize(size);
+    return readAll(fd, payload.data(), size);
+}
+
+std::vector<uint8_t> Protocol::encodeRequest(const std::vector<std::string>& args) {
+    BinaryWriter writer;
+    writer.writeUInt(args.size());
+    for (const auto& arg : args) {
+        writer.writeString(arg);
+    }
+    return writer.release();
+}
+
+std::vector<std::string> Protocol::decodeRequest(const std::vector<uint8_t>& payload) {
+    BinaryReader reader(payload);
+    uint64_t count = reader.readUInt();
+    if (count > payload.size()) {
+        throw std::runtime_error("malformed request");
+    }
+    std::vector<std::string> args(count);
+    for (auto& arg : args) {
+        arg = reader.readString();
+    }
+    return args;
+}
+
+std::vector<uint8_t> Protocol::encodeStats(const SimulationStats& stats) {
+    BinaryWriter writer;
+    writer.writeUInt(static_cast<uint64_t>(FrameType::STATS));
+    ResultCache::writeStats(writer, stats);
+    return writer.release();
+}
+
+std::vector<uint8_t> Protocol::encodeText(FrameType type, const std::string& text) {
+    BinaryWriter writer;
+    writer.writeUInt(static_cast<uint64_t>(type));
+    writer.writeString(text);
+    return writer.release();
+}
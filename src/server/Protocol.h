@@ -0,0 +1,38 @@
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include "core/SimulationEngine.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Wire format of the simulation server. Every message is a 4-byte
+// little-endian payload length followed by a BinaryWriter payload. A request
+// is the job's command-line arguments; the reply is a stream of frames, each
+// starting with its FrameType, ended by DONE or ERROR.
+class Protocol {
+public:
+    enum class FrameType : uint8_t {
+        STATS = 0,   // One finished run, in the result cache's encoding
+        TEXT = 1,    // A line of progress output
+        ERROR = 2,   // The job failed; carries the message
+        DONE = 3     // The job finished normally
+    };
+    
+    // Larger messages are rejected as corrupt
+    static const size_t kMaxMessage = 256u << 20;
+    
+    // Blocking; false when the peer is gone (never raises SIGPIPE)
+    static bool sendMessage(int fd, const std::vector<uint8_t>& payload);
+    // False on end of stream, timeout, error or an oversized length
+    static bool receiveMessage(int fd, std::vector<uint8_t>& payload);
+    
+    static std::vector<uint8_t> encodeRequest(const std::vector<std::string>& args);
+    static std::vector<std::string> decodeRequest(const std::vector<uint8_t>& payload);
+    
+    static std::vector<uint8_t> encodeStats(const SimulationStats& stats);
+    static std::vector<uint8_t> encodeText(FrameType type, const std::string& text);
+};
+
+#endif // PROTOCOL_H
@@ -0,0 +1,56 @@
+#include "SimulationClient.h"
+#include "server/Protocol.h"
+#include "core/Serialization.h"
+#include "output/ResultCache.h"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+SimulationClient::SimulationClient(const std::string& socket_path) : fd_(-1) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("socket path too long: " + socket_path);
+    }
+    std::strcpy(address.sun_path, socket_path.c_str());
+    
+    fd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd_ < 0 || connect(fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        std::string reason = std::strerror(errno);
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+        throw std::runtime_error("cannot connect to " + socket_path + ": " + reason);
+    }
+}
+
+SimulationClient::~SimulationClient() {
+    close(fd_);
+}
+
+void SimulationClient::run(const std::vector<std::string>& args, const StatsCallback& on_stats,
+                           const TextCallback& on_text) {
+    // A server that rejects the job may close before reading the request, so
+    // a failed send is reported from the reply if there is one
+    bool sent = Protocol::sendMessage(fd_, Protocol::encodeRequest(args));
+    
+    std::vector<uint8_t> frame;
+    while (Protocol::receiveMessage(fd_, frame)) {
+        BinaryReader reader(frame);
+        auto type = static_cast<Protocol::FrameType>(reader.readUInt());
+        if (type == Protocol::FrameType::STATS) {
+            on_stats(ResultCache::readStats(reader));
+        } else if (type == Protocol::FrameType::TEXT) {
+            on_text(reader.readString());
+        } else if (type == Protocol::FrameType::ERROR) {
+            throw std::runtime_error(reader.readString());
+        } else if (type == Protocol::FrameType::DONE) {
+            return;
+        }
+    }
+    throw std::runtime_error(sent ? "connection to server lost" : "cannot send request to server");
+}
@@ -0,0 +1,31 @@
+#ifndef SIMULATION_CLIENT_H
+#define SIMULATION_CLIENT_H
+
+#include "core/SimulationEngine.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+// Submits one job to a SimulationServer and receives its streamed replies
+class SimulationClient {
+public:
+    typedef std::function<void(const SimulationStats& stats)> StatsCallback;
+    typedef std::function<void(const std::string& text)> TextCallback;
+    
+    // Throws std::runtime_error when the server cannot be reached
+    explicit SimulationClient(const std::string& socket_path);
+    ~SimulationClient();
+    
+    SimulationClient(const SimulationClient&) = delete;
+    SimulationClient& operator=(const SimulationClient&) = delete;
+    
+    // Send the job's arguments and hand every frame to the callbacks until the
+    // job is done; throws std::runtime_error with the server's message when the
+    // job fails or the connection drops
+    void run(const std::vector<std::string>& args, const StatsCallback& on_stats, const TextCallback& on_text);
+    
+private:
+    int fd_;
+};
+
+#endif // SIMULATION_CLIENT_H
@@ -0,0 +1,152 @@
+#include "SimulationServer.h"
+#include "server/Protocol.h"
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+// How long an admitted connection may take to deliver its request
+const int kRequestTimeoutSeconds = 10;
+
+volatile sig_atomic_t stop_requested = 0;
+
+void requestStop(int) {
+    stop_requested = 1;
+}
+
+} // namespace
+
+void SimulationServer::JobStream::sendStats(const SimulationStats& stats) {
+    send(Protocol::encodeStats(stats));
+}
+
+void SimulationServer::JobStream::sendText(const std::string& text) {
+    send(Protocol::encodeText(Protocol::FrameType::TEXT, text));
+}
+
+void SimulationServer::JobStream::sendError(const std::string& message) {
+    send(Protocol::encodeText(Protocol::FrameType::ERROR, message));
+}
+
+void SimulationServer::JobStream::finish() {
+    send(Protocol::encodeText(Protocol::FrameType::DONE, ""));
+}
+
+void SimulationServer::JobStream::send(const std::vector<uint8_t>& frame) {
+    if (open_ && !Protocol::sendMessage(fd_, frame)) {
+        open_ = false;
+    }
+}
+
+SimulationServer::SimulationServer(const std::string& socket_path, const Handler& handler, size_t workers,
+                                   size_t max_queue)
+    : socket_path_(socket_path), handler_(handler), listen_fd_(-1), in_flight_(0), jobs_served_(0),
+      jobs_rejected_(0), pool_(workers) {
+    max_in_flight_ = pool_.size() + max_queue;
+    
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("socket path too long: " + socket_path);
+    }
+    std::strcpy(address.sun_path, socket_path.c_str());
+    
+    // A stale socket file from an earlier server would make bind fail; anything
+    // else at the path is left alone
+    struct stat existing;
+    if (lstat(socket_path.c_str(), &existing) == 0) {
+        if (!S_ISSOCK(existing.st_mode)) {
+            throw std::runtime_error("cannot listen on " + socket_path + ": path exists and is not a socket");
+        }
+        unlink(socket_path.c_str());
+    }
+    
+    listen_fd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listen_fd_ < 0) {
+        throw std::runtime_error(std::string("cannot create socket: ") + std::strerror(errno));
+    }
+    if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        listen(listen_fd_, SOMAXCONN) < 0) {
+        std::string reason = std::strerror(errno);
+        close(listen_fd_);
+        throw std::runtime_error("cannot listen on " + socket_path + ": " + reason);
+    }
+}
+
+SimulationServer::~SimulationServer() {
+    if (listen_fd_ >= 0) {
+        close(listen_fd_);
+        unlink(socket_path_.c_str());
+    }
+}
+
+void SimulationServer::run() {
+    struct sigaction action, previous_int, previous_term;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = requestStop;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, &previous_int);
+    sigaction(SIGTERM, &action, &previous_term);
+    stop_requested = 0;
+    
+    while (!stop_requested) {
+        pollfd listener = {listen_fd_, POLLIN, 0};
+        if (poll(&listener, 1, -1) <= 0) {
+            continue;  // Interrupted, possibly by a stop signal
+        }
+        int fd = accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd >= 0) {
+            admit(fd);
+        }
+    }
+    
+    // Stop accepting; the pool drains the admitted jobs
+    close(listen_fd_);
+    unlink(socket_path_.c_str());
+    listen_fd_ = -1;
+    while (in_flight_ > 0) {
+        usleep(10000);
+    }
+    sigaction(SIGINT, &previous_int, nullptr);
+    sigaction(SIGTERM, &previous_term, nullptr);
+}
+
+void SimulationServer::admit(int fd) {
+    if (in_flight_ >= max_in_flight_) {
+        jobs_rejected_++;
+        JobStream stream(fd);
+        stream.sendError("server busy: " + std::to_string(max_in_flight_) + " jobs in flight");
+        close(fd);
+        return;
+    }
+    in_flight_++;
+    pool_.submit([this, fd] { serve(fd); });
+}
+
+void SimulationServer::serve(int fd) {
+    timeval timeout = {kRequestTimeoutSeconds, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    
+    JobStream stream(fd);
+    std::vector<uint8_t> request;
+    if (Protocol::receiveMessage(fd, request)) {
+        try {
+            handler_(Protocol::decodeRequest(request), stream);
+            stream.finish();
+        } catch (const std::exception& e) {
+            stream.sendError(e.what());
+        }
+        jobs_served_++;
+    }
+    close(fd);
+    in_flight_--;
+}
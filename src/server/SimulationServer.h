@@ -0,0 +1,71 @@
+#ifndef SIMULATION_SERVER_H
+#define SIMULATION_SERVER_H
+
+#include "core/SimulationEngine.h"
+#include "core/ThreadPool.h"
+#include <atomic>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Long-running daemon serving simulation jobs on a Unix stream socket, one job
+// per connection. The accepting thread only does admission control: at most
+// workers + max_queue jobs are in flight, further connections get a "server
+// busy" error at once. Admitted jobs read their request and run on the worker
+// pool, streaming each result back as soon as it is ready.
+class SimulationServer {
+public:
+    // Reply channel of one job
+    class JobStream {
+    public:
+        explicit JobStream(int fd) : fd_(fd), open_(true) {}
+        
+        void sendStats(const SimulationStats& stats);
+        void sendText(const std::string& text);
+        void sendError(const std::string& message);
+        void finish();
+        
+        // False once the client has gone away; handlers stop early
+        bool isOpen() const { return open_; }
+    
+    private:
+        int fd_;
+        bool open_;
+        
+        void send(const std::vector<uint8_t>& frame);
+    };
+    
+    // Runs one job; exceptions are reported to the client as an error frame
+    typedef std::function<void(const std::vector<std::string>& args, JobStream& stream)> Handler;
+    
+    // workers = 0 uses one per hardware thread; throws std::runtime_error when
+    // the socket cannot be bound
+    SimulationServer(const std::string& socket_path, const Handler& handler, size_t workers = 0,
+                     size_t max_queue = 16);
+    ~SimulationServer();
+    
+    SimulationServer(const SimulationServer&) = delete;
+    SimulationServer& operator=(const SimulationServer&) = delete;
+    
+    // Serve until SIGINT or SIGTERM; queued and running jobs finish before return
+    void run();
+    
+    size_t getWorkerCount() const { return pool_.size(); }
+    long getJobsServed() const { return jobs_served_; }
+    long getJobsRejected() const { return jobs_rejected_; }
+    
+private:
+    std::string socket_path_;
+    Handler handler_;
+    size_t max_in_flight_;
+    int listen_fd_;
+    std::atomic<size_t> in_flight_;
+    std::atomic<long> jobs_served_;
+    long jobs_rejected_;
+    ThreadPool pool_;   // Last member: joined first on destruction
+    
+    void admit(int fd);
+    void serve(int fd);
+};
+
+#endif // SIMULATION_SERVER_H
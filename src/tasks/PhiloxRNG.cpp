@@ -0,0 +1,50 @@
+#include "PhiloxRNG.h"
+
+namespace {
+const uint32_t kMultiplier0 = 0xD2511F53u;
+const uint32_t kMultiplier1 = 0xCD9E8D57u;
+const uint32_t kWeyl0 = 0x9E3779B9u;
+const uint32_t kWeyl1 = 0xBB67AE85u;
+const int kRounds = 10;
+}
+
+PhiloxRNG::PhiloxRNG(uint64_t seed) {
+    key_[0] = static_cast<uint32_t>(seed);
+    key_[1] = static_cast<uint32_t>(seed >> 32);
+}
+
+PhiloxRNG::Block PhiloxRNG::generate(uint64_t counter, uint64_t stream) const {
+    uint32_t x0 = static_cast<uint32_t>(counter);
+    uint32_t x1 = static_cast<uint32_t>(counter >> 32);
+    uint32_t x2 = static_cast<uint32_t>(stream);
+    uint32_t x3 = static_cast<uint32_t>(stream >> 32);
+    uint32_t k0 = key_[0];
+    uint32_t k1 = key_[1];
+    
+    for (int round = 0; round < kRounds; ++round) {
+        uint64_t product0 = static_cast<uint64_t>(kMultiplier0) * x0;
+        uint64_t product1 = static_cast<uint64_t>(kMultiplier1) * x2;
+        uint32_t y0 = static_cast<uint32_t>(product1 >> 32) ^ x1 ^ k0;
+        uint32_t y1 = static_cast<uint32_t>(product1);
+        uint32_t y2 = static_cast<uint32_t>(product0 >> 32) ^ x3 ^ k1;
+        uint32_t y3 = static_cast<uint32_t>(product0);
+        x0 = y0;
+        x1 = y1;
+        x2 = y2;
+        x3 = y3;
+        k0 += kWeyl0;
+        k1 += kWeyl1;
+    }
+    return {x0, x1, x2, x3};
+}
+
+double PhiloxRNG::toUnit(uint32_t value) {
+    // Midpoint of one of 2^32 equal bins, never exactly 0 or 1
+    return (value + 0.5) * (1.0 / 4294967296.0);
+}
+
+int PhiloxRNG::toRange(uint32_t value, int min, int max) {
+    // Multiply-shift reduction; the bias is below 2^-32 per value
+    uint64_t span = static_cast<uint64_t>(static_cast<int64_t>(max) - min + 1);
+    return min + static_cast<int>((static_cast<uint64_t>(value) * span) >> 32);
+}
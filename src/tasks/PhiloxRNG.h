@@ -0,0 +1,26 @@
+#ifndef PHILOX_RNG_H
+#define PHILOX_RNG_H
+
+#include <array>
+#include <cstdint>
+
+// Counter-based Philox-4x32-10 generator: every output block is a pure function
+// of (key, counter), so draws can be made in any order and on any thread
+class PhiloxRNG {
+public:
+    typedef std::array<uint32_t, 4> Block;
+
+    PhiloxRNG(uint64_t seed = 0);
+
+    // Four independent 32-bit values for the given counter
+    Block generate(uint64_t counter, uint64_t stream = 0) const;
+
+    // Map a 32-bit draw to (0, 1) and to an integer in [min, max]
+    static double toUnit(uint32_t value);
+    static int toRange(uint32_t value, int min, int max);
+
+private:
+    uint32_t key_[2];
+};
+
+#endif // PHILOX_RNG_H
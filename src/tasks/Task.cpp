@@ -1,12 +1,23 @@
 #include "Task.h"
+#include "core/Serialization.h"
+#include <algorithm>
 
-Task::Task(int id, int duration, TaskType type, int priority)
+Task::Task(int id, int duration, TaskType type, int priority, int arrival_time)
     : id_(id), duration_(duration), remaining_time_(duration), 
-      type_(type), priority_(priority), start_time_(-1), end_time_(-1) {
+      type_(type), priority_(priority), arrival_time_(arrival_time), start_time_(-1), end_time_(-1),
+      ready_since_(-1), wait_time_(0), preemptions_(0), context_switches_(0), phase_count_(0), current_phase_(0),
+      slot_(-1), phase_remaining_(0) {
 }
 
-void Task::execute(int time_slice) {
-    remaining_time_ -= time_slice;
+void Task::execute(int time_slice, double speed) {
+    double work = time_slice * speed;
+    remaining_time_ -= work;
+    if (phase_count_ > 0) {
+        phase_remaining_ -= work;
+        if (phase_remaining_ <= 0) {
+            enterPhase(current_phase_ + 1);
+        }
+    }
     if (remaining_time_ < 0) {
         remaining_time_ = 0;
     }
@@ -16,6 +27,48 @@ void Task::reset() {
     remaining_time_ = duration_;
     start_time_ = -1;
     end_time_ = -1;
+    ready_since_ = -1;
+    wait_time_ = 0;
+    preemptions_ = 0;
+    context_switches_ = 0;
+    slot_ = -1;
+    if (phase_count_ > 0) {
+        enterPhase(0);
+    }
+}
+
+void Task::setPhases(const std::vector<TaskPhase>& phases) {
+    phase_count_ = static_cast<uint8_t>(std::min<size_t>(phases.size(), kMaxPhases));
+    duration_ = 0;
+    for (int i = 0; i < phase_count_; ++i) {
+        phases_[i] = (static_cast<uint32_t>(phases[i].work) << kTypeBits) | static_cast<uint32_t>(phases[i].type);
+        if (phases[i].type != TaskType::IO_BOUND) {
+            duration_ += phases[i].work;
+        }
+    }
+    if (phase_count_ > 0) {
+        enterPhase(0);
+    }
+}
+
+void Task::completeBlockingPhase() {
+    if (isBlocked()) {
+        enterPhase(current_phase_ + 1);
+    }
+}
+
+void Task::enterPhase(int index) {
+    // Phase changes are the only place the phase table is walked: remaining work
+    // is the compute left in this and all later phases
+    current_phase_ = static_cast<uint8_t>(index);
+    remaining_time_ = 0;
+    for (int i = index; i < phase_count_; ++i) {
+        TaskPhase phase = unpackPhase(phases_[i]);
+        if (phase.type != TaskType::IO_BOUND) {
+            remaining_time_ += phase.work;
+        }
+    }
+    phase_remaining_ = (index < phase_count_ && !isBlocked()) ? unpackPhase(phases_[index]).work : 0;
 }
 
 std::string Task::getTypeString() const {
@@ -26,3 +79,49 @@ std::string Task::getTypeString() const {
         default: return "UNKNOWN";
     }
 }
+
+void Task::save(BinaryWriter& writer) const {
+    writer.writeInt(id_);
+    writer.writeInt(duration_);
+    writer.writeDouble(remaining_time_);
+    writer.writeUInt(static_cast<uint64_t>(type_));
+    writer.writeInt(priority_);
+    writer.writeInt(arrival_time_);
+    writer.writeInt(start_time_);
+    writer.writeInt(end_time_);
+    writer.writeInt(ready_since_);
+    writer.writeInt(wait_time_);
+    writer.writeInt(preemptions_);
+    writer.writeInt(context_switches_);
+    writer.writeUInt(phase_count_);
+    for (int i = 0; i < phase_count_; ++i) {
+        writer.writeUInt(phases_[i]);
+    }
+    writer.writeUInt(current_phase_);
+    writer.writeDouble(phase_remaining_);
+    writer.writeInt(slot_);
+}
+
+Task Task::load(BinaryReader& reader) {
+    Task task;
+    task.id_ = static_cast<int>(reader.readInt());
+    task.duration_ = static_cast<int>(reader.readInt());
+    task.remaining_time_ = reader.readDouble();
+    task.type_ = static_cast<TaskType>(reader.readUInt());
+    task.priority_ = static_cast<int>(reader.readInt());
+    task.arrival_time_ = static_cast<int>(reader.readInt());
+    task.start_time_ = static_cast<int>(reader.readInt());
+    task.end_time_ = static_cast<int>(reader.readInt());
+    task.ready_since_ = static_cast<int>(reader.readInt());
+    task.wait_time_ = static_cast<int>(reader.readInt());
+    task.preemptions_ = static_cast<int>(reader.readInt());
+    task.context_switches_ = static_cast<int>(reader.readInt());
+    task.phase_count_ = static_cast<uint8_t>(std::min<uint64_t>(reader.readUInt(), kMaxPhases));
+    for (int i = 0; i < task.phase_count_; ++i) {
+        task.phases_[i] = static_cast<uint32_t>(reader.readUInt());
+    }
+    task.current_phase_ = static_cast<uint8_t>(reader.readUInt());
+    task.phase_remaining_ = reader.readDouble();
+    task.slot_ = static_cast<int>(reader.readInt());
+    return task;
+}
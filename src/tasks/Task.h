@@ -2,6 +2,12 @@
 #define TASK_H
 
 #include <string>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+class BinaryWriter;
+class BinaryReader;
 
 enum class TaskType {
     CPU_BOUND,
@@ -9,39 +15,118 @@ enum class TaskType {
     MEMORY_HEAVY
 };
 
+// One segment of a phased task: compute work in reference ticks, or for
+// IO_BOUND phases a blocking wait of that many ticks off the CPU
+struct TaskPhase {
+    TaskType type;
+    int work;
+};
+
 class Task {
 public:
-    Task() : id_(0), duration_(0), remaining_time_(0), type_(TaskType::CPU_BOUND), priority_(0), start_time_(-1), end_time_(-1) {}
-    Task(int id, int duration, TaskType type, int priority = 0);
+    static const int kMaxPhases = 8;
+    
+    Task() : id_(0), duration_(0), remaining_time_(0), type_(TaskType::CPU_BOUND), priority_(0),
+             arrival_time_(0), start_time_(-1), end_time_(-1), ready_since_(-1), wait_time_(0),
+             preemptions_(0), context_switches_(0), phase_count_(0), current_phase_(0),
+             slot_(-1), phase_remaining_(0) {}
+    Task(int id, int duration, TaskType type, int priority = 0, int arrival_time = 0);
     
     // Getters
     int getId() const { return id_; }
     int getDuration() const { return duration_; }
-    int getRemainingTime() const { return remaining_time_; }
+    int getRemainingTime() const { return static_cast<int>(std::ceil(remaining_time_)); }
     TaskType getType() const { return type_; }
     int getPriority() const { return priority_; }
-    bool isCompleted() const { return remaining_time_ <= 0; }
+    bool isCompleted() const { return remaining_time_ <= 0 && current_phase_ >= phase_count_; }
     
-    // Task execution
-    void execute(int time_slice);
+    // Task execution; speed scales progress relative to the 1 GHz reference
+    void execute(int time_slice, double speed = 1.0);
     void reset();
     
+    // Phase sequence (at most kMaxPhases); the duration becomes the total compute work
+    void setPhases(const std::vector<TaskPhase>& phases);
+    int getPhaseCount() const { return phase_count_; }
+    TaskPhase getPhase(int index) const { return unpackPhase(phases_[index]); }
+    int getCurrentPhase() const { return current_phase_; }
+    
+    // Type of the work currently executing, which sets the power drawn
+    TaskType getExecutionType() const {
+        return phase_count_ > 0 && current_phase_ < phase_count_ ? static_cast<TaskType>(phases_[current_phase_] & kTypeMask)
+                                                                  : type_;
+    }
+    
+    // The task is at an I/O phase and must leave the CPU for getBlockingTicks()
+    bool isBlocked() const {
+        return current_phase_ < phase_count_ &&
+               static_cast<TaskType>(phases_[current_phase_] & kTypeMask) == TaskType::IO_BOUND;
+    }
+    int getBlockingTicks() const { return isBlocked() ? static_cast<int>(phases_[current_phase_] >> kTypeBits) : 0; }
+    void completeBlockingPhase();
+    
     // Statistics
+    int getArrivalTime() const { return arrival_time_; }
     int getStartTime() const { return start_time_; }
     int getEndTime() const { return end_time_; }
     void setStartTime(int time) { start_time_ = time; }
     void setEndTime(int time) { end_time_ = time; }
+    int getFirstRunTime() const { return start_time_; }
+    int getWaitTime() const { return wait_time_; }          // Total ticks spent runnable but not running
+    int getPreemptions() const { return preemptions_; }
+    int getContextSwitches() const { return context_switches_; }
+    
+    // Dense index the engine assigns on arrival for its per-task accounting
+    int getSlot() const { return slot_; }
+    void setSlot(int slot) { slot_ = slot; }
+    
+    // Scheduler bookkeeping: the task became runnable (a task already waiting keeps
+    // its original ready time), was switched onto the CPU, or was forced off it
+    void markReady(int time) {
+        if (ready_since_ < 0) ready_since_ = time;
+    }
+    void markDispatched(int time) {
+        if (ready_since_ >= 0) wait_time_ += time - ready_since_;
+        ready_since_ = -1;
+        if (start_time_ < 0) start_time_ = time;
+        context_switches_++;
+    }
+    void markPreempted(int time) {
+        preemptions_++;
+        markReady(time);
+    }
     
     std::string getTypeString() const;
     
+    // Snapshot support
+    void save(BinaryWriter& writer) const;
+    static Task load(BinaryReader& reader);
+    
 private:
+    // Phases are packed as (work << kTypeBits) | type
+    static const int kTypeBits = 2;
+    static const uint32_t kTypeMask = (1u << kTypeBits) - 1;
+    static TaskPhase unpackPhase(uint32_t packed) {
+        return {static_cast<TaskType>(packed & kTypeMask), static_cast<int>(packed >> kTypeBits)};
+    }
+    void enterPhase(int index);
+    
     int id_;
     int duration_;
-    int remaining_time_;
+    double remaining_time_;    // Remaining work in reference ticks
     TaskType type_;
     int priority_;
+    int arrival_time_;
     int start_time_;
     int end_time_;
+    int ready_since_;          // -1 unless waiting in a ready queue
+    int wait_time_;
+    int preemptions_;
+    int context_switches_;
+    uint32_t phases_[kMaxPhases];
+    uint8_t phase_count_;
+    uint8_t current_phase_;
+    int slot_;                 // -1 until the task arrives
+    double phase_remaining_;   // Compute work left in the current phase
 };
 
 #endif // TASK_H
@@ -1,30 +1,160 @@
 #include "TaskGenerator.h"
 #include <algorithm>
+#include <cmath>
+#include <functional>
+#include <thread>
 
-TaskGenerator::TaskGenerator(unsigned int seed) 
-    : rng_(seed), cpu_bound_prob_(0.4), io_bound_prob_(0.3), 
-      memory_heavy_prob_(0.3), min_priority_(1), max_priority_(10) {
+namespace {
+// Inter-arrival gaps are summed in fixed point so that chunked prefix sums are
+// exact and independent of how the work is split
+const int kArrivalFractionBits = 16;
+const double kArrivalScale = 1 << kArrivalFractionBits;
+
+// Philox streams: task attributes and inter-arrival gaps
+const uint64_t kTaskStream = 0;
+const uint64_t kArrivalStream = 1;
+const uint64_t kPhaseStream = 2;
+const uint64_t kDependencyStream = 3;
+
+// Compute phases alternate with I/O phases within Task::kMaxPhases
+const int kMaxComputePhases = (Task::kMaxPhases + 1) / 2;
+}
+
+TaskGenerator::TaskGenerator(unsigned int seed, RandomEngine engine) 
+    : rng_(seed), philox_(seed), engine_(engine), unit_dist_(0.0, 1.0), priority_dist_(1, 10),
+      cpu_bound_prob_(0.4), io_bound_prob_(0.3), 
+      memory_heavy_prob_(0.3), min_priority_(1), max_priority_(10), mean_interarrival_(0.0),
+      max_compute_phases_(1), min_io_ticks_(5), max_io_ticks_(50) {
 }
 
 std::vector<Task> TaskGenerator::generateTasks(int num_tasks, 
                                              int min_duration, 
-                                             int max_duration) {
+                                             int max_duration,
+                                             int num_threads) {
+    if (engine_ == RandomEngine::COUNTER) {
+        return generateCounterTasks(num_tasks, min_duration, max_duration, num_threads);
+    }
+    
     std::vector<Task> tasks;
     tasks.reserve(num_tasks);
     
     std::uniform_int_distribution<> duration_dist(min_duration, max_duration);
+    std::exponential_distribution<> interarrival_dist(mean_interarrival_ > 0.0 ? 1.0 / mean_interarrival_ : 1.0);
+    double arrival = 0.0;
     
     for (int i = 0; i < num_tasks; ++i) {
         int duration = duration_dist(rng_);
         TaskType type = selectRandomTaskType();
         int priority = generateRandomPriority();
+        if (mean_interarrival_ > 0.0 && i > 0) {
+            arrival += interarrival_dist(rng_);
+        }
         
-        tasks.emplace_back(i, duration, type, priority);
+        tasks.emplace_back(i, duration, type, priority, static_cast<int>(arrival));
+        if (max_compute_phases_ > 1) {
+            uint32_t draws[kMaxComputePhases];
+            for (auto& draw : draws) {
+                draw = static_cast<uint32_t>(rng_());
+            }
+            applyPhases(tasks.back(), draws[0], draws + 1);
+        }
     }
     
     return tasks;
 }
 
+Task TaskGenerator::counterTask(int index, int min_duration, int max_duration, int arrival_time) const {
+    PhiloxRNG::Block draw = philox_.generate(static_cast<uint64_t>(index), kTaskStream);
+    int duration = PhiloxRNG::toRange(draw[0], min_duration, max_duration);
+    TaskType type = taskTypeFor(PhiloxRNG::toUnit(draw[1]));
+    int priority = PhiloxRNG::toRange(draw[2], min_priority_, max_priority_);
+    Task task(index, duration, type, priority, arrival_time);
+    if (max_compute_phases_ > 1) {
+        PhiloxRNG::Block phase_draw = philox_.generate(static_cast<uint64_t>(index), kPhaseStream);
+        applyPhases(task, phase_draw[0], phase_draw.data() + 1);
+    }
+    return task;
+}
+
+void TaskGenerator::applyPhases(Task& task, uint32_t phase_draw, const uint32_t* io_draws) const {
+    int max_phases = std::min(max_compute_phases_, kMaxComputePhases);
+    int compute_phases = (task.getType() == TaskType::IO_BOUND) ? max_phases
+                                                                 : PhiloxRNG::toRange(phase_draw, 1, max_phases);
+    compute_phases = std::max(1, std::min(compute_phases, task.getDuration()));
+    TaskType compute_type = (task.getType() == TaskType::IO_BOUND) ? TaskType::CPU_BOUND : task.getType();
+    
+    std::vector<TaskPhase> phases;
+    int work = task.getDuration() / compute_phases;
+    for (int i = 0; i < compute_phases; ++i) {
+        if (i > 0) {
+            phases.push_back({TaskType::IO_BOUND, PhiloxRNG::toRange(io_draws[i - 1], min_io_ticks_, max_io_ticks_)});
+        }
+        int phase_work = (i == compute_phases - 1) ? task.getDuration() - work * i : work;
+        phases.push_back({compute_type, phase_work});
+    }
+    task.setPhases(phases);
+}
+
+uint64_t TaskGenerator::counterGap(int index) const {
+    if (mean_interarrival_ <= 0.0 || index == 0) {
+        return 0;
+    }
+    double unit = PhiloxRNG::toUnit(philox_.generate(static_cast<uint64_t>(index), kArrivalStream)[0]);
+    return static_cast<uint64_t>(std::llround(-std::log(unit) * mean_interarrival_ * kArrivalScale));
+}
+
+std::vector<Task> TaskGenerator::generateCounterTasks(int num_tasks, int min_duration, int max_duration,
+                                                      int num_threads) const {
+    num_tasks = std::max(num_tasks, 0);
+    std::vector<Task> tasks(num_tasks);
+    int chunks = std::max(1, std::min(num_threads, num_tasks));
+    int chunk_size = (num_tasks + chunks - 1) / chunks;
+    
+    auto run_chunks = [chunks](const std::function<void(int)>& body) {
+        std::vector<std::thread> workers;
+        for (int chunk = 1; chunk < chunks; ++chunk) {
+            workers.emplace_back(body, chunk);
+        }
+        body(0);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    };
+    
+    // Gap sums per chunk, turned into each chunk's starting arrival time
+    std::vector<uint64_t> chunk_start(chunks, 0);
+    if (mean_interarrival_ > 0.0 && chunks > 1) {
+        run_chunks([&](int chunk) {
+            int end = std::min(num_tasks, (chunk + 1) * chunk_size);
+            uint64_t sum = 0;
+            for (int i = chunk * chunk_size; i < end; ++i) {
+                sum += counterGap(i);
+            }
+            chunk_start[chunk] = sum;
+        });
+        uint64_t offset = 0;
+        for (int chunk = 0; chunk < chunks; ++chunk) {
+            uint64_t sum = chunk_start[chunk];
+            chunk_start[chunk] = offset;
+            offset += sum;
+        }
+    }
+    
+    run_chunks([&](int chunk) {
+        int end = std::min(num_tasks, (chunk + 1) * chunk_size);
+        uint64_t arrival = chunk_start[chunk];
+        for (int i = chunk * chunk_size; i < end; ++i) {
+            arrival += counterGap(i);
+            tasks[i] = counterTask(i, min_duration, max_duration, static_cast<int>(arrival >> kArrivalFractionBits));
+        }
+    });
+    return tasks;
+}
+
+Task TaskGenerator::generateTask(int index, int min_duration, int max_duration) const {
+    return counterTask(index, min_duration, max_duration, 0);
+}
+
 void TaskGenerator::setTaskTypeDistribution(double cpu_bound_prob, 
                                           double io_bound_prob, 
                                           double memory_heavy_prob) {
@@ -38,12 +168,24 @@ void TaskGenerator::setTaskTypeDistribution(double cpu_bound_prob,
 void TaskGenerator::setPriorityRange(int min_priority, int max_priority) {
     min_priority_ = min_priority;
     max_priority_ = max_priority;
+    priority_dist_ = std::uniform_int_distribution<>(min_priority, max_priority);
+}
+
+void TaskGenerator::setPhaseProfile(int max_compute_phases, int min_io_ticks, int max_io_ticks) {
+    max_compute_phases_ = max_compute_phases;
+    min_io_ticks_ = std::max(1, min_io_ticks);
+    max_io_ticks_ = std::max(min_io_ticks_, max_io_ticks);
+}
+
+void TaskGenerator::setArrivalInterval(double mean_interarrival) {
+    mean_interarrival_ = mean_interarrival;
 }
 
 TaskType TaskGenerator::selectRandomTaskType() {
-    std::uniform_real_distribution<> dist(0.0, 1.0);
-    double rand_val = dist(rng_);
-    
+    return taskTypeFor(unit_dist_(rng_));
+}
+
+TaskType TaskGenerator::taskTypeFor(double rand_val) const {
     if (rand_val < cpu_bound_prob_) {
         return TaskType::CPU_BOUND;
     } else if (rand_val < cpu_bound_prob_ + io_bound_prob_) {
@@ -54,6 +196,32 @@ TaskType TaskGenerator::selectRandomTaskType() {
 }
 
 int TaskGenerator::generateRandomPriority() {
-    std::uniform_int_distribution<> priority_dist(min_priority_, max_priority_);
-    return priority_dist(rng_);
+    return priority_dist_(rng_);
+}
+
+TaskGraph TaskGenerator::generateDependencies(int num_tasks, int max_parents, int window) const {
+    max_parents = std::max(0, std::min(max_parents, static_cast<int>(kMaxParents)));
+    window = std::max(1, window);
+    std::vector<std::pair<int, int>> edges;
+    edges.reserve(static_cast<size_t>(num_tasks) * max_parents / 2);
+    int parents[kMaxParents];
+    for (int task = 1; task < num_tasks; ++task) {
+        // Draw 0 picks the parent count, draws 1.. the parents, four per block
+        PhiloxRNG::Block draws[(kMaxParents + 4) / 4];
+        for (int block = 0; block * 4 <= max_parents; ++block) {
+            draws[block] = philox_.generate((static_cast<uint64_t>(task) << 2) | block, kDependencyStream);
+        }
+        int span = std::min(window, task);
+        int count = std::min(PhiloxRNG::toRange(draws[0][0], 0, max_parents), span);
+        for (int i = 0; i < count; ++i) {
+            int draw = i + 1;
+            parents[i] = task - 1 - PhiloxRNG::toRange(draws[draw / 4][draw % 4], 0, span - 1);
+        }
+        std::sort(parents, parents + count);
+        count = static_cast<int>(std::unique(parents, parents + count) - parents);
+        for (int i = 0; i < count; ++i) {
+            edges.emplace_back(parents[i], task);
+        }
+    }
+    return TaskGraph::fromEdges(num_tasks, edges);
 }
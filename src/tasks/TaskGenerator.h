@@ -2,16 +2,34 @@
 #define TASK_GENERATOR_H
 
 #include "Task.h"
+#include "PhiloxRNG.h"
+#include "TaskGraph.h"
 #include <vector>
 #include <random>
+#include <cstdint>
+
+// SEQUENTIAL draws every task in turn from one Mersenne Twister stream (the
+// original workloads); COUNTER derives task i from (seed, i) alone, so it can be
+// generated in parallel or on demand with identical results
+enum class RandomEngine {
+    SEQUENTIAL,
+    COUNTER
+};
 
 class TaskGenerator {
 public:
-    TaskGenerator(unsigned int seed = 0);
+    TaskGenerator(unsigned int seed = 0, RandomEngine engine = RandomEngine::SEQUENTIAL);
     
+    // With the counter engine the work is split over num_threads; the result does
+    // not depend on the thread count
     std::vector<Task> generateTasks(int num_tasks, 
                                   int min_duration = 50, 
-                                  int max_duration = 500);
+                                  int max_duration = 500,
+                                  int num_threads = 1);
+    
+    // Task i of the counter-based workload, generated on demand. Arrival times are
+    // prefix sums over earlier tasks, so this returns the task released at t=0.
+    Task generateTask(int index, int min_duration = 50, int max_duration = 500) const;
     
     void setTaskTypeDistribution(double cpu_bound_prob, 
                                double io_bound_prob, 
@@ -19,16 +37,49 @@ public:
     
     void setPriorityRange(int min_priority, int max_priority);
     
+    // Phased workload: each task gets up to max_compute_phases compute phases separated
+    // by blocking I/O phases of [min_io_ticks, max_io_ticks]; IO_BOUND tasks always get
+    // the maximum number of I/O waits. 1 or less keeps single-phase tasks.
+    void setPhaseProfile(int max_compute_phases, int min_io_ticks = 5, int max_io_ticks = 50);
+    
+    // Poisson arrivals with the given mean inter-arrival time (ticks); 0 releases every task at t=0
+    void setArrivalInterval(double mean_interarrival);
+    
+    // Random DAG over tasks 0..num_tasks-1: each task depends on up to
+    // max_parents (at most kMaxParents) distinct tasks among the window tasks
+    // before it. Drawn from the counter-based stream whatever the engine, so
+    // the edges do not depend on the task attributes.
+    static const int kMaxParents = 15;
+    TaskGraph generateDependencies(int num_tasks, int max_parents, int window) const;
+    
 private:
     std::mt19937 rng_;
+    PhiloxRNG philox_;
+    RandomEngine engine_;
+    std::uniform_real_distribution<> unit_dist_;
+    std::uniform_int_distribution<> priority_dist_;
     double cpu_bound_prob_;
     double io_bound_prob_;
     double memory_heavy_prob_;
     int min_priority_;
     int max_priority_;
+    double mean_interarrival_;
+    int max_compute_phases_;
+    int min_io_ticks_;
+    int max_io_ticks_;
     
     TaskType selectRandomTaskType();
     int generateRandomPriority();
+    TaskType taskTypeFor(double rand_val) const;
+    
+    // Split a task into compute phases (count drawn from phase_draw) separated by
+    // I/O waits whose lengths come from io_draws
+    void applyPhases(Task& task, uint32_t phase_draw, const uint32_t* io_draws) const;
+    
+    // Counter-based draws: task attributes, and the gap before it in fixed point
+    Task counterTask(int index, int min_duration, int max_duration, int arrival_time) const;
+    uint64_t counterGap(int index) const;
+    std::vector<Task> generateCounterTasks(int num_tasks, int min_duration, int max_duration, int num_threads) const;
 };
 
 #endif // TASK_GENERATOR_H
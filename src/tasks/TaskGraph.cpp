@@ -0,0 +1,83 @@
+#include "TaskGraph.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+TaskGraph TaskGraph::fromEdges(int nodes, const std::vector<std::pair<int, int>>& edges) {
+    TaskGraph graph;
+    graph.offsets_.assign(nodes + 1, 0);
+    graph.parent_count_.assign(nodes, 0);
+    for (const auto& edge : edges) {
+        if (edge.first < 0 || edge.first >= nodes || edge.second < 0 || edge.second >= nodes) {
+            throw std::invalid_argument("dependency edge out of range: " + std::to_string(edge.first) + " -> " +
+                                        std::to_string(edge.second));
+        }
+        graph.offsets_[edge.first + 1]++;
+        graph.parent_count_[edge.second]++;
+    }
+    
+    // Counting sort of the edges by parent
+    for (int node = 0; node < nodes; ++node) {
+        graph.offsets_[node + 1] += graph.offsets_[node];
+    }
+    graph.children_.resize(edges.size());
+    std::vector<int> fill(graph.offsets_.begin(), graph.offsets_.end() - 1);
+    for (const auto& edge : edges) {
+        graph.children_[fill[edge.first]++] = edge.second;
+    }
+    
+    // Kahn's algorithm; the order vector doubles as the queue
+    std::vector<int> remaining = graph.parent_count_;
+    graph.order_.reserve(nodes);
+    for (int node = 0; node < nodes; ++node) {
+        if (remaining[node] == 0) {
+            graph.order_.push_back(node);
+        }
+    }
+    for (size_t head = 0; head < graph.order_.size(); ++head) {
+        int node = graph.order_[head];
+        for (const int* child = graph.childrenBegin(node); child != graph.childrenEnd(node); ++child) {
+            if (--remaining[*child] == 0) {
+                graph.order_.push_back(*child);
+            }
+        }
+    }
+    if (static_cast<int>(graph.order_.size()) != nodes) {
+        throw std::invalid_argument("task dependencies contain a cycle");
+    }
+    return graph;
+}
+
+std::vector<double> TaskGraph::computeBottomLevels(const std::vector<double>& weights) const {
+    std::vector<double> levels(weights.begin(), weights.begin() + getNodeCount());
+    for (auto it = order_.rbegin(); it != order_.rend(); ++it) {
+        double longest = 0.0;
+        for (const int* child = childrenBegin(*it); child != childrenEnd(*it); ++child) {
+            longest = std::max(longest, levels[*child]);
+        }
+        levels[*it] += longest;
+    }
+    return levels;
+}
+
+void DependencyTracker::reset(const TaskGraph* graph) {
+    graph_ = graph;
+    remaining_.clear();
+    if (graph_ != nullptr) {
+        remaining_.resize(graph_->getNodeCount());
+        for (int node = 0; node < graph_->getNodeCount(); ++node) {
+            remaining_[node] = graph_->getParentCount(node);
+        }
+    }
+}
+
+void DependencyTracker::complete(int node, std::vector<int>& released) {
+    if (graph_ == nullptr || !graph_->contains(node)) {
+        return;
+    }
+    for (const int* child = graph_->childrenBegin(node); child != graph_->childrenEnd(node); ++child) {
+        if (--remaining_[*child] == 0) {
+            released.push_back(*child);
+        }
+    }
+}
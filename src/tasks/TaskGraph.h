@@ -0,0 +1,66 @@
+#ifndef TASK_GRAPH_H
+#define TASK_GRAPH_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Dependencies between the tasks of a workload, node i being the task with
+// id i: a task may only start once all its parents have completed. Edges are
+// kept in compressed sparse row form (the children of node v are
+// children_[offsets_[v]] up to children_[offsets_[v + 1]]) together with a
+// parent count and a topological order, about three ints per node and one
+// per edge.
+class TaskGraph {
+public:
+    TaskGraph() {}
+    
+    // Build from (parent, child) pairs; duplicate edges are kept. Throws
+    // std::invalid_argument on a node out of range or a cycle.
+    static TaskGraph fromEdges(int nodes, const std::vector<std::pair<int, int>>& edges);
+    
+    int getNodeCount() const { return static_cast<int>(parent_count_.size()); }
+    size_t getEdgeCount() const { return children_.size(); }
+    bool contains(int node) const { return node >= 0 && node < getNodeCount(); }
+    
+    const int* childrenBegin(int node) const { return children_.data() + offsets_[node]; }
+    const int* childrenEnd(int node) const { return children_.data() + offsets_[node + 1]; }
+    int getParentCount(int node) const { return parent_count_[node]; }
+    
+    // Every parent precedes its children
+    const std::vector<int>& getTopologicalOrder() const { return order_; }
+    
+    // Longest path from each node to a sink, counting the weights of the
+    // nodes on it including its own; O(nodes + edges)
+    std::vector<double> computeBottomLevels(const std::vector<double>& weights) const;
+    
+private:
+    std::vector<int> offsets_;       // nodes + 1 entries
+    std::vector<int> children_;
+    std::vector<int> parent_count_;
+    std::vector<int> order_;
+};
+
+// Unmet dependencies of a DAG while it runs. Completing a node releases the
+// children whose last parent it was, in O(children).
+class DependencyTracker {
+public:
+    DependencyTracker() : graph_(nullptr) {}
+    
+    // Start over with every node waiting for all its parents; a null graph
+    // makes every node ready
+    void reset(const TaskGraph* graph);
+    
+    bool isReady(int node) const {
+        return graph_ == nullptr || !graph_->contains(node) || remaining_[node] == 0;
+    }
+    
+    // Append the nodes the completion makes ready
+    void complete(int node, std::vector<int>& released);
+    
+private:
+    const TaskGraph* graph_;
+    std::vector<int> remaining_;     // Parents not yet completed
+};
+
+#endif // TASK_GRAPH_H
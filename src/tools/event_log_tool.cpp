@@ -0,0 +1,188 @@
+// powerprofile-events: converts a --event-log file to CSV or to the Chrome
+// trace event format (chrome://tracing, Perfetto)
+
+#include "core/EventLog.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options] LOG\n"
+              << "Options:\n"
+              << "  --format FORMAT     csv (default) or chrome\n"
+              << "  --output FILE       Write to FILE instead of stdout\n"
+              << "  --help              Show this help message\n";
+}
+
+void writeCSV(EventLogReader& reader, std::ostream& out) {
+    out << "time,event,core,task,value\n";
+    SchedulingEvent event;
+    while (reader.next(event)) {
+        out << event.time << "," << getEventTypeName(event.type) << "," << event.core << ","
+            << event.task << "," << event.value << "\n";
+    }
+}
+
+// Task runs become complete ("X") slices on one track per core, ending at the
+// completion, preemption or block; frequencies and throttling become counters.
+// Ticks are milliseconds and trace timestamps microseconds.
+class ChromeTraceWriter {
+public:
+    explicit ChromeTraceWriter(std::ostream& out) : out_(out), first_(true), last_time_(0) {}
+    
+    void write(EventLogReader& reader) {
+        out_ << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        SchedulingEvent event;
+        while (reader.next(event)) {
+            handle(event);
+            last_time_ = event.time;
+        }
+        for (auto& entry : running_) {
+            closeSlice(entry.first, entry.second, last_time_, "end of log");
+        }
+        for (int core : tracks_) {
+            begin();
+            out_ << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << core + 1
+                 << ",\"args\":{\"name\":\"" << (core < 0 ? std::string("package") : "core " + std::to_string(core))
+                 << "\"}}";
+        }
+        out_ << "]}\n";
+    }
+    
+private:
+    struct Slice {
+        int task;
+        int start;
+        int mhz;
+    };
+    
+    std::ostream& out_;
+    bool first_;
+    int last_time_;
+    std::map<int, Slice> running_;  // By core
+    std::map<int, bool> seen_;
+    std::vector<int> tracks_;
+    
+    void begin() {
+        if (!first_) {
+            out_ << ",";
+        }
+        out_ << "\n";
+        first_ = false;
+    }
+    
+    void track(int core) {
+        if (!seen_[core]) {
+            seen_[core] = true;
+            tracks_.push_back(core);
+        }
+    }
+    
+    void handle(const SchedulingEvent& event) {
+        track(event.core);
+        auto open = running_.find(event.core);
+        switch (event.type) {
+            case EventType::DISPATCH:
+                if (open != running_.end()) {
+                    closeSlice(event.core, open->second, event.time, "replaced");
+                }
+                running_[event.core] = {event.task, event.time, event.value};
+                counter(event.core, event.time, event.value);
+                break;
+            case EventType::PREEMPT:
+            case EventType::COMPLETE:
+            case EventType::BLOCK:
+                if (open != running_.end() && open->second.task == event.task) {
+                    closeSlice(event.core, open->second, event.time, getEventTypeName(event.type));
+                    running_.erase(open);
+                } else {
+                    instant(event);
+                }
+                break;
+            case EventType::FREQUENCY:
+                counter(event.core, event.time, event.value);
+                break;
+            case EventType::THROTTLE:
+                begin();
+                out_ << "{\"name\":\"throttled\",\"ph\":\"C\",\"pid\":0,\"ts\":" << event.time * 1000LL
+                     << ",\"args\":{\"throttled\":" << event.value << "}}";
+                break;
+        }
+    }
+    
+    void closeSlice(int core, const Slice& slice, int end, const char* reason) {
+        begin();
+        out_ << "{\"name\":\"task " << slice.task << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << core + 1
+             << ",\"ts\":" << slice.start * 1000LL << ",\"dur\":" << (end - slice.start) * 1000LL
+             << ",\"args\":{\"task\":" << slice.task << ",\"mhz\":" << slice.mhz << ",\"end\":\"" << reason
+             << "\"}}";
+    }
+    
+    void instant(const SchedulingEvent& event) {
+        begin();
+        out_ << "{\"name\":\"" << getEventTypeName(event.type) << " task " << event.task
+             << "\",\"ph\":\"i\",\"s\":\"t\",\"pid\":0,\"tid\":" << event.core + 1 << ",\"ts\":"
+             << event.time * 1000LL << ",\"args\":{\"value\":" << event.value << "}}";
+    }
+    
+    void counter(int core, int time, int mhz) {
+        begin();
+        out_ << "{\"name\":\"core " << core << " MHz\",\"ph\":\"C\",\"pid\":0,\"ts\":" << time * 1000LL
+             << ",\"args\":{\"MHz\":" << mhz << "}}";
+    }
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string format = "csv";
+    std::string output_file = "";
+    std::string log_file = "";
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+            format = argv[++i];
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            output_file = argv[++i];
+        } else if (strcmp(argv[i], "--help") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        } else if (argv[i][0] != '-' && log_file.empty()) {
+            log_file = argv[i];
+        } else {
+            std::cerr << "Unknown option: " << argv[i] << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (log_file.empty() || (format != "csv" && format != "chrome")) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    
+    try {
+        EventLogReader reader(log_file);
+        std::ofstream file;
+        if (!output_file.empty()) {
+            file.open(output_file);
+            if (!file.is_open()) {
+                throw std::runtime_error("cannot write " + output_file);
+            }
+        }
+        std::ostream& out = output_file.empty() ? std::cout : file;
+        if (format == "chrome") {
+            ChromeTraceWriter(out).write(reader);
+        } else {
+            writeCSV(reader, out);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,179 @@
+#include "core/EnergyAttribution.h"
+#include "core/LatencyHistogram.h"
+#include "core/PowerCapController.h"
+#include "core/Serialization.h"
+#include "core/SimulationEngine.h"
+#include "core/WaitQueue.h"
+#include "scheduler/RoundRobinScheduler.h"
+#include "tasks/TaskGenerator.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+namespace {
+
+template <typename T>
+std::vector<uint8_t> saveOf(const T& value) {
+    BinaryWriter writer;
+    value.saveState(writer);
+    return writer.release();
+}
+
+std::vector<int> releaseIds(WaitQueue& queue, int now) {
+    std::vector<Task> woken;
+    queue.release(now, woken);
+    std::vector<int> ids;
+    for (const Task& task : woken) {
+        ids.push_back(task.getId());
+    }
+    return ids;
+}
+
+std::unique_ptr<SimulationEngine> createEngine() {
+    auto engine = std::make_unique<SimulationEngine>(std::make_unique<RoundRobinScheduler>(10));
+    engine->setIODevice(2, 3);
+    engine->setPowerCap(PowerCapController(1.2, 50));
+    ContextSwitchCost cost;
+    cost.latency_ticks = 2;
+    cost.energy_joules = 1e-4;
+    cost.warmup_ticks[0] = 1;
+    cost.warmup_ticks[1] = 0;
+    cost.warmup_ticks[2] = 3;
+    engine->setContextSwitchCost(cost);
+    return engine;
+}
+
+std::vector<Task> createWorkload() {
+    TaskGenerator generator(7);
+    generator.setPhaseProfile(3, 5, 40);
+    return generator.generateTasks(60, 10, 120);
+}
+
+} // namespace
+
+TEST(SnapshotTest, WaitQueueRoundTrip) {
+    WaitQueue queue(2, 4);
+    for (int id = 0; id < 20; ++id) {
+        queue.block(Task(id, 10, TaskType::IO_BOUND), id % 5, 3 + id % 7);
+    }
+    releaseIds(queue, 6);
+    
+    BinaryWriter writer;
+    queue.saveState(writer);
+    WaitQueue restored;
+    BinaryReader reader(writer.getBuffer());
+    restored.loadState(reader);
+    EXPECT_TRUE(reader.atEnd());
+    
+    EXPECT_EQ(queue.getChannels(), restored.getChannels());
+    EXPECT_EQ(queue.getLatency(), restored.getLatency());
+    EXPECT_EQ(queue.size(), restored.size());
+    EXPECT_EQ(queue.nextWakeTime(), restored.nextWakeTime());
+    // Both queue new requests behind the same busy channels
+    EXPECT_EQ(queue.block(Task(100, 10, TaskType::IO_BOUND), 6, 5),
+              restored.block(Task(100, 10, TaskType::IO_BOUND), 6, 5));
+    for (int now = 6; now < 200; now += 3) {
+        ASSERT_EQ(releaseIds(queue, now), releaseIds(restored, now)) << "at " << now;
+    }
+    EXPECT_TRUE(restored.empty());
+}
+
+TEST(SnapshotTest, LatencyHistogramRoundTrip) {
+    LatencyHistogram histogram;
+    for (int64_t value = 0; value < 100000; value += 37) {
+        histogram.record(value, 1 + value % 3);
+    }
+    BinaryWriter writer;
+    histogram.save(writer);
+    LatencyHistogram restored;
+    BinaryReader reader(writer.getBuffer());
+    restored.load(reader);
+    EXPECT_TRUE(reader.atEnd());
+    
+    EXPECT_EQ(histogram.getCount(), restored.getCount());
+    for (double p : {0.0, 0.5, 0.9, 0.99, 0.999, 1.0}) {
+        EXPECT_EQ(histogram.percentile(p), restored.percentile(p)) << "p = " << p;
+    }
+}
+
+TEST(SnapshotTest, PowerCapControllerRoundTrip) {
+    PowerCapController controller(1.5, 40, 0.4, 0.05, 0.01);
+    for (int tick = 0; tick < 120; ++tick) {
+        controller.update(1.0 + (tick % 9) * 0.2, 2.0, controller.limitFrequency(2.0), 1 + tick % 3, tick % 5 != 0);
+    }
+    std::vector<uint8_t> state = saveOf(controller);
+    PowerCapController restored;
+    BinaryReader reader(state);
+    restored.loadState(reader);
+    
+    EXPECT_EQ(saveOf(controller), saveOf(restored));
+    // Identical state keeps evolving identically
+    for (int tick = 0; tick < 50; ++tick) {
+        controller.update(2.5, 2.0, controller.limitFrequency(2.0), 2, true);
+        restored.update(2.5, 2.0, restored.limitFrequency(2.0), 2, true);
+        ASSERT_EQ(controller.getScale(), restored.getScale());
+    }
+    EXPECT_EQ(controller.getCappedTime(), restored.getCappedTime());
+    EXPECT_EQ(controller.getLostCycles(), restored.getLostCycles());
+}
+
+TEST(SnapshotTest, EnergyAttributionRoundTrip) {
+    EnergyAttribution attribution;
+    std::vector<Task> tasks;
+    for (int id = 0; id < 12; ++id) {
+        tasks.emplace_back(id, 10, static_cast<TaskType>(id % 3));
+        attribution.admit(tasks.back());
+        attribution.charge(tasks.back(), 0.01 * (id + 1));
+        attribution.heat(tasks.back(), 30.0 + id);
+    }
+    std::vector<uint8_t> state = saveOf(attribution);
+    EnergyAttribution restored;
+    BinaryReader reader(state);
+    restored.loadState(reader);
+    EXPECT_TRUE(reader.atEnd());
+    
+    std::vector<Task> completed(tasks.begin(), tasks.begin() + 8);
+    std::vector<TaskEnergy> per_task, restored_per_task;
+    std::vector<TypeEnergy> by_type, restored_by_type;
+    attribution.attribute(0.5, completed, per_task, by_type);
+    restored.attribute(0.5, completed, restored_per_task, restored_by_type);
+    ASSERT_EQ(per_task.size(), restored_per_task.size());
+    for (size_t i = 0; i < per_task.size(); ++i) {
+        EXPECT_EQ(per_task[i].active_energy_joules, restored_per_task[i].active_energy_joules);
+        EXPECT_EQ(per_task[i].idle_energy_joules, restored_per_task[i].idle_energy_joules);
+        EXPECT_EQ(per_task[i].peak_temperature_celsius, restored_per_task[i].peak_temperature_celsius);
+    }
+    ASSERT_EQ(by_type.size(), restored_by_type.size());
+    for (size_t i = 0; i < by_type.size(); ++i) {
+        EXPECT_EQ(by_type[i].tasks_run, restored_by_type[i].tasks_run);
+        EXPECT_EQ(by_type[i].tasks_completed, restored_by_type[i].tasks_completed);
+        EXPECT_EQ(by_type[i].getEnergy(), restored_by_type[i].getEnergy());
+    }
+}
+
+TEST(SnapshotTest, EngineResumesIdenticallyFromSnapshot) {
+    auto original = createEngine();
+    original->start(createWorkload(), 20000);
+    original->runUntil(1500);
+    std::vector<uint8_t> snapshot = original->saveSnapshot();
+    
+    auto restored = createEngine();
+    restored->restoreSnapshot(snapshot);
+    EXPECT_EQ(snapshot, restored->saveSnapshot());
+    
+    original->runUntil(20000);
+    restored->runUntil(20000);
+    SimulationStats expected = original->collectStats();
+    SimulationStats actual = restored->collectStats();
+    EXPECT_EQ(expected.total_tasks, actual.total_tasks);
+    EXPECT_EQ(expected.total_execution_time, actual.total_execution_time);
+    EXPECT_EQ(expected.total_energy_joules, actual.total_energy_joules);
+    EXPECT_EQ(expected.switch_overhead_ticks, actual.switch_overhead_ticks);
+    EXPECT_EQ(expected.power_capped_ticks, actual.power_capped_ticks);
+    EXPECT_EQ(expected.latency.turnaround.percentile(0.99), actual.latency.turnaround.percentile(0.99));
+    ASSERT_EQ(expected.task_energy.size(), actual.task_energy.size());
+    for (size_t i = 0; i < expected.task_energy.size(); ++i) {
+        EXPECT_EQ(expected.completed_tasks[i].getId(), actual.completed_tasks[i].getId());
+        EXPECT_EQ(expected.task_energy[i].getEnergy(), actual.task_energy[i].getEnergy());
+    }
+}
@@ -0,0 +1,183 @@
+#include "core/TimerWheel.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Straightforward model of the wheel: pending timers ordered by (expiry,
+// scheduling order)
+class ReferenceWheel {
+public:
+    explicit ReferenceWheel(int64_t start_time) : now_(start_time), next_sequence_(0) {}
+    
+    std::pair<int64_t, uint64_t> schedule(int64_t expiry, uint64_t payload) {
+        std::pair<int64_t, uint64_t> key(expiry, next_sequence_++);
+        pending_[key] = payload;
+        return key;
+    }
+    
+    bool cancel(const std::pair<int64_t, uint64_t>& key) { return pending_.erase(key) > 0; }
+    
+    void advance(int64_t time, std::vector<uint64_t>& expired) {
+        while (!pending_.empty() && pending_.begin()->first.first <= time) {
+            expired.push_back(pending_.begin()->second);
+            pending_.erase(pending_.begin());
+        }
+        now_ = std::max(now_, time);
+    }
+    
+    int64_t nextExpiry() const { return pending_.empty() ? -1 : pending_.begin()->first.first; }
+    size_t size() const { return pending_.size(); }
+    int64_t getTime() const { return now_; }
+    
+private:
+    int64_t now_;
+    uint64_t next_sequence_;
+    std::map<std::pair<int64_t, uint64_t>, uint64_t> pending_;
+};
+
+struct Live {
+    TimerWheel::Handle handle;
+    std::pair<int64_t, uint64_t> key;
+};
+
+// Drives a wheel and the reference with the same random operations and checks
+// that they agree after every step
+void compareWithReference(uint64_t seed, int64_t start_time, int operations) {
+    std::mt19937_64 rng(seed);
+    TimerWheel wheel(start_time);
+    ReferenceWheel reference(start_time);
+    std::vector<Live> live;
+    std::vector<TimerWheel::Handle> stale;
+    uint64_t next_payload = 0;
+    
+    // Distances spanning every level of the wheel, including already-due timers
+    auto distance = [&rng]() -> int64_t {
+        switch (rng() % 6) {
+            case 0: return -static_cast<int64_t>(rng() % 50);
+            case 1: return rng() % 256;
+            case 2: return rng() % 65536;
+            case 3: return rng() % (1 << 24);
+            case 4: return rng() % (static_cast<int64_t>(1) << 30);
+            default: return 0;
+        }
+    };
+    
+    for (int op = 0; op < operations; ++op) {
+        int kind = static_cast<int>(rng() % 10);
+        if (kind < 5) {
+            int64_t expiry = wheel.getTime() + distance();
+            uint64_t payload = next_payload++;
+            TimerWheel::Handle handle = wheel.schedule(expiry, payload);
+            live.push_back({handle, reference.schedule(expiry, payload)});
+        } else if (kind < 7 && !live.empty()) {
+            size_t index = rng() % live.size();
+            bool expected = reference.cancel(live[index].key);
+            ASSERT_EQ(expected, wheel.cancel(live[index].handle)) << "operation " << op;
+            stale.push_back(live[index].handle);
+            live[index] = live.back();
+            live.pop_back();
+        } else if (kind < 8 && !stale.empty()) {
+            // Cancelled or fired handles stay dead even once their node is reused
+            ASSERT_FALSE(wheel.cancel(stale[rng() % stale.size()])) << "operation " << op;
+        } else {
+            int64_t step = (rng() % 4 == 0) ? distance() : static_cast<int64_t>(rng() % 300);
+            int64_t time = wheel.getTime() + std::max<int64_t>(0, step);
+            std::vector<uint64_t> expected, actual;
+            reference.advance(time, expected);
+            wheel.advance(time, actual);
+            ASSERT_EQ(expected, actual) << "operation " << op << ", advancing to " << time;
+            ASSERT_EQ(time, wheel.getTime());
+            // Fired handles join the stale ones; the reference drops fired keys itself
+            for (size_t i = 0; i < live.size();) {
+                if (live[i].key.first <= time) {
+                    stale.push_back(live[i].handle);
+                    live[i] = live.back();
+                    live.pop_back();
+                } else {
+                    ++i;
+                }
+            }
+        }
+        ASSERT_EQ(reference.size(), wheel.size()) << "operation " << op;
+        ASSERT_EQ(reference.nextExpiry(), wheel.nextExpiry()) << "operation " << op;
+    }
+    
+    // Drain everything left
+    std::vector<uint64_t> expected, actual;
+    int64_t end = reference.nextExpiry() < 0 ? wheel.getTime() : wheel.getTime() + (static_cast<int64_t>(1) << 31);
+    reference.advance(end, expected);
+    wheel.advance(end, actual);
+    EXPECT_EQ(expected, actual);
+    EXPECT_TRUE(wheel.empty());
+    EXPECT_EQ(-1, wheel.nextExpiry());
+}
+
+} // namespace
+
+TEST(TimerWheelTest, MatchesReferenceOnRandomOperations) {
+    compareWithReference(1, 0, 200000);
+}
+
+TEST(TimerWheelTest, MatchesReferenceFromUnalignedStart) {
+    // Start just short of level boundaries so the first advances cascade
+    compareWithReference(2, (static_cast<int64_t>(1) << 24) - 3, 50000);
+    compareWithReference(3, 65536 * 3 - 1, 50000);
+}
+
+TEST(TimerWheelTest, FiresInExpiryThenSchedulingOrder) {
+    TimerWheel wheel;
+    wheel.schedule(300, 1);
+    wheel.schedule(5, 2);
+    wheel.schedule(300, 3);
+    wheel.schedule(5, 4);
+    wheel.schedule(70000, 5);
+    
+    std::vector<uint64_t> expired;
+    wheel.advance(299, expired);
+    EXPECT_EQ((std::vector<uint64_t>{2, 4}), expired);
+    expired.clear();
+    wheel.advance(300, expired);
+    EXPECT_EQ((std::vector<uint64_t>{1, 3}), expired);
+    EXPECT_EQ(70000, wheel.nextExpiry());
+}
+
+TEST(TimerWheelTest, CrossesEveryLevelBoundaryTickByTick) {
+    // Timers just either side of the 256, 65536 and 2^24 boundaries
+    const int64_t start = (static_cast<int64_t>(1) << 24) - 70000;
+    TimerWheel wheel(start);
+    std::vector<int64_t> expiries;
+    for (int64_t boundary : {start + 256 - start % 256, static_cast<int64_t>(1) << 16 << 8,
+                             (start / 65536 + 1) * 65536}) {
+        for (int64_t offset = -2; offset <= 2; ++offset) {
+            expiries.push_back(boundary + offset);
+        }
+    }
+    for (size_t i = 0; i < expiries.size(); ++i) {
+        wheel.schedule(expiries[i], i);
+    }
+    
+    std::vector<uint64_t> expired;
+    for (int64_t time = start; time <= (static_cast<int64_t>(1) << 24) + 2; ++time) {
+        wheel.advance(time, expired);
+        for (uint64_t payload : expired) {
+            EXPECT_EQ(expiries[payload], time);
+        }
+        expired.clear();
+    }
+    EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheelTest, DueTimersFireOnNextAdvance) {
+    TimerWheel wheel(100);
+    wheel.schedule(40, 7);
+    EXPECT_EQ(40, wheel.nextExpiry());
+    std::vector<uint64_t> expired;
+    wheel.advance(100, expired);
+    EXPECT_EQ((std::vector<uint64_t>{7}), expired);
+}